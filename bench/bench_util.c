@@ -0,0 +1,151 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: benchmarks : hardware counters (perf_event_open) around a
+ *              measured section, and the CSV rows every benchmark prints
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <stdlib.h>               /* getenv() */
+#include <string.h>               /* memset(), strcmp() */
+#include <unistd.h>               /* syscall(), read(), close() */
+#include <sys/ioctl.h>            /* ioctl() */
+#include <sys/syscall.h>          /* SYS_perf_event_open */
+#include <linux/perf_event.h>     /* struct perf_event_attr */
+
+#include "mono_clock.h"
+#include "bench_util.h"
+/******************************************************************************/
+static int OpenCounter(unsigned long config);
+static void StartCounter(int fd);
+static long ReadCounter(int fd);
+/******************************************************************************/
+void BenchOpen(bench_counters_t *counters)
+{
+    const char *perf = getenv("BENCH_PERF");
+
+    memset(counters, 0, sizeof(bench_counters_t));
+    counters->instr_fd = -1;
+    counters->misses_fd = -1;
+    counters->instructions = -1;
+    counters->misses = -1;
+
+    if (NULL == perf || 0 != strcmp("0", perf))
+    {
+        counters->instr_fd = OpenCounter(PERF_COUNT_HW_INSTRUCTIONS);
+        counters->misses_fd = OpenCounter(PERF_COUNT_HW_CACHE_MISSES);
+    }
+}
+
+
+void BenchStart(bench_counters_t *counters)
+{
+    StartCounter(counters->instr_fd);
+    StartCounter(counters->misses_fd);
+    counters->start_ns = MonoNowNs();
+}
+
+
+void BenchStop(bench_counters_t *counters)
+{
+    counters->ns = MonoNowNs() - counters->start_ns;
+    counters->instructions = ReadCounter(counters->instr_fd);
+    counters->misses = ReadCounter(counters->misses_fd);
+}
+
+
+void BenchPrintHeader(FILE *out)
+{
+    fprintf(out, "%s\n", BENCH_CSV_HEADER);
+}
+
+
+void BenchPrint(FILE *out, const char *bench, const char *name, size_t size,
+                    const char *op, size_t ops, const bench_counters_t *counters)
+{
+    double n = (0 == ops) ? 1.0 : (double)ops;
+
+    BenchPrintValue(out, bench, name, size, op, "ns_per_op", counters->ns / n);
+    if (0 <= counters->instructions)
+    {
+        BenchPrintValue(out, bench, name, size, op, "instr_per_op",
+                                                    counters->instructions / n);
+    }
+    if (0 <= counters->misses)
+    {
+        BenchPrintValue(out, bench, name, size, op, "misses_per_op",
+                                                        counters->misses / n);
+    }
+}
+
+
+void BenchPrintValue(FILE *out, const char *bench, const char *name,
+                size_t size, const char *op, const char *metric, double value)
+{
+    fprintf(out, "%s,%s,%lu,%s,%s,%.3f\n", bench, name, (unsigned long)size,
+                                                            op, metric, value);
+}
+
+
+void BenchClose(bench_counters_t *counters)
+{
+    if (-1 != counters->instr_fd)
+    {
+        close(counters->instr_fd);
+    }
+    if (-1 != counters->misses_fd)
+    {
+        close(counters->misses_fd);
+    }
+    counters->instr_fd = -1;
+    counters->misses_fd = -1;
+}
+
+/******************************************************************************/
+static int OpenCounter(unsigned long config)
+{
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    /* this thread, any CPU */
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+
+static void StartCounter(int fd)
+{
+    if (-1 != fd)
+    {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+
+static long ReadCounter(int fd)
+{
+    uint64_t count = 0;
+
+    if (-1 == fd)
+    {
+        return -1;
+    }
+
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    if ((ssize_t)sizeof(count) != read(fd, &count, sizeof(count)))
+    {
+        return -1;
+    }
+
+    return (long)count;
+}
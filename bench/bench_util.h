@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: benchmarks : hardware counters (perf_event_open) around a
+ *              measured section, and the CSV rows every benchmark prints
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#ifndef __BENCH_UTIL_H_OL108_ILRD__
+#define __BENCH_UTIL_H_OL108_ILRD__
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint64_t */
+#include <stdio.h>  /* FILE */
+
+/* the CSV header of every benchmark - a value per row, so the outputs of
+   the benchmarks concatenate and compare */
+#define BENCH_CSV_HEADER "bench,case,size,op,metric,value"
+
+typedef struct
+{
+    int instr_fd;       /* -1 if not counted */
+    int misses_fd;
+    uint64_t start_ns;
+    uint64_t ns;        /* of the last section */
+    long instructions;  /* -1 if not counted */
+    long misses;
+} bench_counters_t;
+
+
+/**
+ * @Description: Opens the counters of this thread - retired instructions and
+ *               last level cache misses (user space only).
+ * @Parameters: counters - the counters to open.
+ * @Return: void.
+ * @Notes: A counter the kernel denies (perf_event_paranoid, a VM without a
+ *         PMU) or that BENCH_PERF=0 in the environment turns off reads -1,
+ *         the time is measured anyway.
+**/
+void BenchOpen(bench_counters_t *counters);
+
+
+/**
+ * @Description: Starts a measured section - resets and enables the counters.
+ * @Parameters: counters - the open counters.
+ * @Return: void.
+**/
+void BenchStart(bench_counters_t *counters);
+
+
+/**
+ * @Description: Ends a measured section - the time and counts are kept in
+ *               counters.
+ * @Parameters: counters - the counters of BenchStart.
+ * @Return: void.
+**/
+void BenchStop(bench_counters_t *counters);
+
+
+/**
+ * @Description: Prints BENCH_CSV_HEADER.
+ * @Parameters: out - the stream.
+ * @Return: void.
+**/
+void BenchPrintHeader(FILE *out);
+
+
+/**
+ * @Description: Prints the CSV rows of the last section - the ns_per_op,
+ *               instr_per_op and misses_per_op metrics of the operation.
+ * @Parameters: out - the stream.
+ *              bench, name - the benchmark and the case (a backend, a
+ *              container).
+ *              size - the elements, tasks or clients of the case.
+ *              op - the measured operation.
+ *              ops - the operations in the section.
+ *              counters - the counters of BenchStop.
+ * @Return: void.
+ * @Notes: The rows of a counter that is not counted are left out.
+**/
+void BenchPrint(FILE *out, const char *bench, const char *name, size_t size,
+                    const char *op, size_t ops, const bench_counters_t *counters);
+
+
+/**
+ * @Description: Prints a CSV row of one measured value.
+ * @Parameters: out - the stream.
+ *              bench, name, size, op - as of BenchPrint.
+ *              metric - the name of the value, its unit last (p99_ms,
+ *              cpu_pct).
+ *              value - the value.
+ * @Return: void.
+**/
+void BenchPrintValue(FILE *out, const char *bench, const char *name,
+            size_t size, const char *op, const char *metric, double value);
+
+
+/**
+ * @Description: Closes the counters.
+ * @Parameters: counters - the counters of BenchOpen.
+ * @Return: void.
+**/
+void BenchClose(bench_counters_t *counters);
+
+#endif /* __BENCH_UTIL_H_OL108_ILRD__ */
@@ -0,0 +1,250 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: containers benchmark : HeapPush, HeapPop, HeapRemove (by
+ *              match and by index), PQEnqueue, PQDequeue and VectorPushBack
+ *              (growing from a capacity of 1, and into a reserved capacity)
+ *
+ * Infinity Labs OL108
+ *
+ * usage - containers_bench [elements...] (default 1000 10000 100000 1000000)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h)
+ *                (remove - HeapRemove of REMOVE_OPS elements, a linear search
+ *                each)
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <stdio.h>    /* stdout */
+#include <stdlib.h>   /* malloc(), free(), atol() */
+#include <stdint.h>   /* uint64_t */
+
+#include "heap.h"
+#include "priority_queue.h"
+#include "dynamic_vector.h"
+#include "bench_util.h"
+
+#define REMOVE_OPS 1000
+#define KEY_SPAN 1000000
+
+typedef struct
+{
+    uint64_t key;
+    size_t index;       /* in the indexed heap */
+} bench_elem_t;
+
+static void RunHeap(bench_elem_t *elems, size_t n);
+static void RunIndexedHeap(bench_elem_t *elems, size_t n);
+static void RunPQ(bench_elem_t *elems, size_t n);
+static void RunVector(size_t n, size_t capacity, const char *op);
+static int KeyCmp(const void *lhs, const void *rhs);
+static int IsSame(const void *lhs, const void *rhs);
+static void SetIndex(void *data, size_t index);
+static unsigned int NextRand(unsigned int *seed);
+/******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static const size_t defaults[] = {1000, 10000, 100000, 1000000};
+    size_t runs = (1 < argc) ? (size_t)(argc - 1)
+                                : sizeof(defaults) / sizeof(defaults[0]);
+    size_t i = 0, j = 0;
+
+    BenchPrintHeader(stdout);
+
+    for (i = 0; i < runs; ++i)
+    {
+        size_t n = (1 < argc) ? (size_t)atol(argv[i + 1]) : defaults[i];
+        bench_elem_t *elems = (bench_elem_t *)malloc(n * sizeof(bench_elem_t));
+        unsigned int seed = 108;
+
+        if (NULL == elems)
+        {
+            return 1;
+        }
+        for (j = 0; j < n; ++j)
+        {
+            elems[j].key = NextRand(&seed) % KEY_SPAN;
+        }
+
+        RunHeap(elems, n);
+        RunIndexedHeap(elems, n);
+        RunPQ(elems, n);
+        RunVector(n, 1, "push_back_grow");
+        RunVector(n, n, "push_back_reserved");
+
+        free(elems);
+    }
+
+    return 0;
+}
+
+/******************************************************************************/
+static void RunHeap(bench_elem_t *elems, size_t n)
+{
+    heap_t *heap = HeapCreate(KeyCmp);
+    size_t removes = (REMOVE_OPS < n) ? REMOVE_OPS : n;
+    bench_counters_t counters;
+    unsigned int seed = 801;
+    size_t i = 0;
+
+    if (NULL == heap)
+    {
+        return;
+    }
+    BenchOpen(&counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < n; ++i)
+    {
+        HeapPush(heap, &elems[i]);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "containers", "heap", n, "push", n, &counters);
+
+    /* random elements, found by a linear search */
+    BenchStart(&counters);
+    for (i = 0; i < removes; ++i)
+    {
+        bench_elem_t *elem = &elems[NextRand(&seed) % n];
+
+        if (NULL != HeapRemove(heap, elem, IsSame))
+        {
+            HeapPush(heap, elem);
+        }
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "containers", "heap", n, "remove", removes, &counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < n; ++i)
+    {
+        HeapPop(heap);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "containers", "heap", n, "pop", n, &counters);
+
+    BenchClose(&counters);
+    HeapDestroy(heap);
+}
+
+
+static void RunIndexedHeap(bench_elem_t *elems, size_t n)
+{
+    heap_t *heap = HeapCreateIndexed(KeyCmp, SetIndex);
+    bench_counters_t counters;
+    unsigned int seed = 801;
+    size_t i = 0;
+
+    if (NULL == heap)
+    {
+        return;
+    }
+    BenchOpen(&counters);
+
+    for (i = 0; i < n; ++i)
+    {
+        HeapPush(heap, &elems[i]);
+    }
+
+    /* removed and pushed back - the size stays n */
+    BenchStart(&counters);
+    for (i = 0; i < n; ++i)
+    {
+        bench_elem_t *elem = &elems[NextRand(&seed) % n];
+
+        HeapPush(heap, HeapRemoveAt(heap, elem->index));
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "containers", "heap_indexed", n, "remove_at_push", n,
+                                                                    &counters);
+
+    BenchClose(&counters);
+    HeapDestroy(heap);
+}
+
+
+static void RunPQ(bench_elem_t *elems, size_t n)
+{
+    pq_t *pq = PQCreate(KeyCmp);
+    bench_counters_t counters;
+    size_t i = 0;
+
+    if (NULL == pq)
+    {
+        return;
+    }
+    BenchOpen(&counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < n; ++i)
+    {
+        PQEnqueue(pq, &elems[i]);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "containers", "pq", n, "enqueue", n, &counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < n; ++i)
+    {
+        PQDequeue(pq);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "containers", "pq", n, "dequeue", n, &counters);
+
+    BenchClose(&counters);
+    PQDestroy(pq);
+}
+
+
+static void RunVector(size_t n, size_t capacity, const char *op)
+{
+    d_vector_t *vector = VectorCreate(sizeof(uint64_t), capacity);
+    bench_counters_t counters;
+    uint64_t value = 0;
+
+    if (NULL == vector)
+    {
+        return;
+    }
+    BenchOpen(&counters);
+
+    BenchStart(&counters);
+    for (value = 0; value < n; ++value)
+    {
+        VectorPushBack(vector, &value);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "containers", "vector", n, op, n, &counters);
+
+    BenchClose(&counters);
+    VectorDestroy(vector);
+}
+
+
+static int KeyCmp(const void *lhs, const void *rhs)
+{
+    uint64_t left = ((const bench_elem_t *)lhs)->key;
+    uint64_t right = ((const bench_elem_t *)rhs)->key;
+
+    return (left > right) - (left < right);
+}
+
+
+static int IsSame(const void *lhs, const void *rhs)
+{
+    return lhs == rhs;
+}
+
+
+static void SetIndex(void *data, size_t index)
+{
+    ((bench_elem_t *)data)->index = index;
+}
+
+
+static unsigned int NextRand(unsigned int *seed)
+{
+    *seed = *seed * 1103515245u + 12345u;
+
+    return *seed >> 8;
+}
@@ -0,0 +1,212 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: heap benchmark : the generic pointer heap (a comparison
+ *              callback on separately allocated elements) against the d-ary
+ *              value heap, at arity 2, 4 and 8
+ *
+ * Infinity Labs OL108
+ *
+ * usage - heap_bench [elements...] (default 1000 10000 100000 1000000)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h), the ops: push, hold,
+ *                pop (hold - a pop and a push of a later key), the cases:
+ *                generic, dheap2, dheap4, dheap8
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <stdio.h>                /* stdout, sprintf() */
+#include <stdlib.h>               /* malloc(), free(), atol() */
+#include <stdint.h>               /* uint64_t */
+
+#include "bench_util.h"
+#include "heap.h"
+#include "dheap.h"
+
+#define HOLD_OPS 1000000
+#define KEY_SPAN 1000000
+
+typedef struct
+{
+    uint64_t key;
+    char payload[48];   /* the rest of a task */
+} bench_elem_t;
+
+static void RunGeneric(const uint64_t *keys, size_t n);
+static void RunDHeap(size_t arity, const uint64_t *keys, size_t n);
+static int KeyCmp(const void *lhs, const void *rhs);
+static unsigned int NextRand(unsigned int *seed);
+/******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static const size_t defaults[] = {1000, 10000, 100000, 1000000};
+    static const size_t arities[] = {2, 4, 8};
+    size_t runs = (1 < argc) ? (size_t)(argc - 1)
+                                : sizeof(defaults) / sizeof(defaults[0]);
+    size_t i = 0, j = 0;
+
+    BenchPrintHeader(stdout);
+
+    for (i = 0; i < runs; ++i)
+    {
+        size_t n = (1 < argc) ? (size_t)atol(argv[i + 1]) : defaults[i];
+        uint64_t *keys = (uint64_t *)malloc(n * sizeof(uint64_t));
+        unsigned int seed = 108;
+
+        if (NULL == keys)
+        {
+            return 1;
+        }
+
+        for (j = 0; j < n; ++j)
+        {
+            keys[j] = NextRand(&seed) % KEY_SPAN;
+        }
+
+        RunGeneric(keys, n);
+
+        for (j = 0; j < sizeof(arities) / sizeof(arities[0]); ++j)
+        {
+            RunDHeap(arities[j], keys, n);
+        }
+
+        free(keys);
+    }
+
+    return 0;
+}
+
+/******************************************************************************/
+static void RunGeneric(const uint64_t *keys, size_t n)
+{
+    heap_t *heap = HeapCreate(KeyCmp);
+    bench_elem_t **elems = (bench_elem_t **)malloc(n * sizeof(bench_elem_t *));
+    bench_counters_t counters;
+    unsigned int seed = 801;
+    size_t i = 0;
+
+    if (NULL == heap || NULL == elems)
+    {
+        free(elems);
+        return;
+    }
+
+    /* one allocation per element, as the tasks of the scheduler were */
+    for (i = 0; i < n; ++i)
+    {
+        elems[i] = (bench_elem_t *)malloc(sizeof(bench_elem_t));
+        elems[i]->key = keys[i];
+    }
+
+    BenchOpen(&counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < n; ++i)
+    {
+        HeapPush(heap, elems[i]);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "heap", "generic", n, "push", n, &counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < HOLD_OPS; ++i)
+    {
+        bench_elem_t *elem = (bench_elem_t *)HeapPop(heap);
+
+        elem->key += NextRand(&seed) % KEY_SPAN;
+        HeapPush(heap, elem);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "heap", "generic", n, "hold", HOLD_OPS, &counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < n; ++i)
+    {
+        HeapPop(heap);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "heap", "generic", n, "pop", n, &counters);
+
+    BenchClose(&counters);
+
+    for (i = 0; i < n; ++i)
+    {
+        free(elems[i]);
+    }
+    free(elems);
+    HeapDestroy(heap);
+}
+
+
+static void RunDHeap(size_t arity, const uint64_t *keys, size_t n)
+{
+    dheap_t *heap = DHeapCreate(arity, NULL);
+    bench_elem_t *elems = (bench_elem_t *)malloc(n * sizeof(bench_elem_t));
+    bench_counters_t counters;
+    unsigned int seed = 801;
+    char name[16];
+    size_t i = 0;
+
+    if (NULL == heap || NULL == elems)
+    {
+        free(elems);
+        return;
+    }
+
+    for (i = 0; i < n; ++i)
+    {
+        elems[i].key = keys[i];
+    }
+
+    sprintf(name, "dheap%lu", (unsigned long)arity);
+    BenchOpen(&counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < n; ++i)
+    {
+        DHeapPush(heap, elems[i].key, &elems[i]);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "heap", name, n, "push", n, &counters);
+
+    /* the key is kept in the heap, the element is not touched to order it */
+    BenchStart(&counters);
+    for (i = 0; i < HOLD_OPS; ++i)
+    {
+        uint64_t key = DHeapPeekKey(heap) + NextRand(&seed) % KEY_SPAN;
+
+        DHeapPush(heap, key, DHeapPop(heap));
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "heap", name, n, "hold", HOLD_OPS, &counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < n; ++i)
+    {
+        DHeapPop(heap);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "heap", name, n, "pop", n, &counters);
+
+    BenchClose(&counters);
+
+    free(elems);
+    DHeapDestroy(heap);
+}
+
+
+static int KeyCmp(const void *lhs, const void *rhs)
+{
+    uint64_t left = ((const bench_elem_t *)lhs)->key;
+    uint64_t right = ((const bench_elem_t *)rhs)->key;
+
+    return (left > right) - (left < right);
+}
+
+
+static unsigned int NextRand(unsigned int *seed)
+{
+    *seed = *seed * 1103515245u + 12345u;
+
+    return *seed >> 8;
+}
@@ -0,0 +1,265 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: allocation churn benchmark : the object pool against malloc,
+ *              and add / cancel churn of the scheduler (tasks from its pool)
+ *
+ * Infinity Labs OL108
+ *
+ * usage - pool_churn_bench [live objects] [threads] (default 10000 4)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h), the size is the live
+ *                objects, the allocation cases end with their threads, the
+ *                ops: free_alloc, remove_add (chunks - the pool's malloc
+ *                calls)
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <stdio.h>    /* fprintf(), sprintf() */
+#include <stdlib.h>   /* malloc(), free(), atol() */
+#include <stdint.h>   /* uint64_t */
+#include <pthread.h>  /* pthread_create(), pthread_join() */
+
+#include "mono_clock.h"
+#include "bench_util.h"
+#include "pool.h"
+#include "scheduler.h"
+
+#define DEFAULT_LIVE 10000
+#define DEFAULT_THREADS 4
+#define MAX_THREADS 64
+#define OPS_PER_THREAD 2000000
+#define SCHED_OPS 1000000
+#define OBJ_SIZE 96
+#define UNUSED(x) (void)(x)
+
+typedef enum
+{
+    USE_MALLOC,
+    USE_POOL
+} alloc_kind_t;
+
+typedef struct
+{
+    alloc_kind_t kind;
+    pool_t *pool;
+    size_t live;
+    unsigned int seed;
+} churn_arg_t;
+
+static void RunAlloc(const char *name, alloc_kind_t kind, int flags,
+                                                size_t live, size_t threads);
+static void *Churn(void *arg);
+static void RunSched(const char *name, sched_backend_t backend, size_t live);
+static int NopTask(void *arg);
+static void CleanUp(void *arg);
+static unsigned int NextRand(unsigned int *seed);
+/******************************************************************************/
+int main(int argc, char *argv[])
+{
+    size_t live = (1 < argc) ? (size_t)atol(argv[1]) : DEFAULT_LIVE;
+    size_t threads = (2 < argc) ? (size_t)atol(argv[2]) : DEFAULT_THREADS;
+
+    if (0 == live || 0 == threads || MAX_THREADS < threads)
+    {
+        fprintf(stderr, "usage: %s [live objects] [threads <= %d]\n",
+                                                        argv[0], MAX_THREADS);
+        return 1;
+    }
+
+    BenchPrintHeader(stdout);
+
+    RunAlloc("malloc", USE_MALLOC, 0, live, 1);
+    RunAlloc("pool", USE_POOL, 0, live, 1);
+    RunAlloc("malloc", USE_MALLOC, 0, live, threads);
+    RunAlloc("pool_locked", USE_POOL, POOL_LOCKED, live, threads);
+    RunAlloc("pool_thread_cache", USE_POOL, POOL_THREAD_CACHE, live, threads);
+
+    RunSched("sched_heap", SCHED_HEAP, live);
+    RunSched("sched_wheel", SCHED_TIMING_WHEEL, live);
+
+    return 0;
+}
+
+/******************************************************************************/
+static void RunAlloc(const char *name, alloc_kind_t kind, int flags,
+                                                size_t live, size_t threads)
+{
+    pthread_t ids[MAX_THREADS];
+    churn_arg_t args[MAX_THREADS];
+    pool_t *pool = NULL;
+    pool_stats_t stats;
+    uint64_t start = 0, elapsed = 0;
+    char name_threads[64];
+    size_t i = 0;
+
+    if (USE_POOL == kind)
+    {
+        pool = PoolCreate(OBJ_SIZE, 64, flags);
+        if (NULL == pool)
+        {
+            return;
+        }
+    }
+
+    start = MonoNowNs();
+    for (i = 0; i < threads; ++i)
+    {
+        args[i].kind = kind;
+        args[i].pool = pool;
+        args[i].live = live / threads + 1;
+        args[i].seed = 108 + (unsigned int)i;
+
+        if (1 == threads)
+        {
+            Churn(&args[i]);
+        }
+        else
+        {
+            pthread_create(&ids[i], NULL, Churn, &args[i]);
+        }
+    }
+    for (i = 0; 1 < threads && i < threads; ++i)
+    {
+        pthread_join(ids[i], NULL);
+    }
+    elapsed = MonoNowNs() - start;
+
+    /* the threads run side by side - the wall time of an op of one thread */
+    sprintf(name_threads, "%s_%lu", name, (unsigned long)threads);
+    BenchPrintValue(stdout, "pool_churn", name_threads, live, "free_alloc",
+                            "ns_per_op", (double)elapsed / OPS_PER_THREAD);
+
+    if (NULL != pool)
+    {
+        PoolGetStats(pool, &stats);
+        BenchPrintValue(stdout, "pool_churn", name_threads, live, "free_alloc",
+                                            "chunks", (double)stats.chunks);
+        PoolDestroy(pool);
+    }
+}
+
+
+static void *Churn(void *arg)
+{
+    churn_arg_t *churn = (churn_arg_t *)arg;
+    void **objs = (void **)malloc(churn->live * sizeof(void *));
+    size_t i = 0;
+
+    if (NULL == objs)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < churn->live; ++i)
+    {
+        objs[i] = (USE_POOL == churn->kind) ? PoolAlloc(churn->pool)
+                                            : malloc(OBJ_SIZE);
+    }
+
+    /* steady state - each op frees a random live object and replaces it */
+    for (i = 0; i < OPS_PER_THREAD; ++i)
+    {
+        size_t victim = NextRand(&churn->seed) % churn->live;
+
+        if (USE_POOL == churn->kind)
+        {
+            PoolFree(churn->pool, objs[victim]);
+            objs[victim] = PoolAlloc(churn->pool);
+        }
+        else
+        {
+            free(objs[victim]);
+            objs[victim] = malloc(OBJ_SIZE);
+        }
+    }
+
+    for (i = 0; i < churn->live; ++i)
+    {
+        if (USE_POOL == churn->kind)
+        {
+            PoolFree(churn->pool, objs[i]);
+        }
+        else
+        {
+            free(objs[i]);
+        }
+    }
+
+    if (NULL != churn->pool)
+    {
+        PoolFlushThreadCache(churn->pool);
+    }
+    free(objs);
+
+    return NULL;
+}
+
+
+static void RunSched(const char *name, sched_backend_t backend, size_t live)
+{
+    sched_t *sched = SchedCreateBackend(backend);
+    sched_handle_t *handles = (sched_handle_t *)malloc(live *
+                                                    sizeof(sched_handle_t));
+    unsigned int seed = 108;
+    uint64_t now = MonoNowNs(), start = 0;
+    size_t i = 0;
+
+    if (NULL == sched || NULL == handles)
+    {
+        free(handles);
+        if (NULL != sched)
+        {
+            SchedDestroy(sched);
+        }
+        return;
+    }
+
+    for (i = 0; i < live; ++i)
+    {
+        handles[i] = SchedAddTaskNs(sched, NopTask, now + MONO_NS_PER_SEC
+                + NextRand(&seed) % (60 * MONO_NS_PER_MS), MONO_NS_PER_SEC,
+                NULL, CleanUp);
+    }
+
+    /* a cancelled task is replaced by a new one, nothing expires */
+    start = MonoNowNs();
+    for (i = 0; i < SCHED_OPS; ++i)
+    {
+        size_t victim = NextRand(&seed) % live;
+
+        SchedRemoveTask(sched, handles[victim]);
+        handles[victim] = SchedAddTaskNs(sched, NopTask, now + MONO_NS_PER_SEC
+                + NextRand(&seed) % (60 * MONO_NS_PER_MS), MONO_NS_PER_SEC,
+                NULL, CleanUp);
+    }
+
+    BenchPrintValue(stdout, "pool_churn", name, live, "remove_add",
+                "ns_per_op", (double)(MonoNowNs() - start) / SCHED_OPS);
+
+    SchedDestroy(sched);
+    free(handles);
+}
+
+
+static int NopTask(void *arg)
+{
+    UNUSED(arg);
+
+    return 1;
+}
+
+
+static void CleanUp(void *arg)
+{
+    UNUSED(arg);
+}
+
+
+static unsigned int NextRand(unsigned int *seed)
+{
+    /* rand() takes a lock, a per-thread LCG does not */
+    *seed = *seed * 1103515245u + 12345u;
+
+    return *seed >> 8;
+}
@@ -0,0 +1,246 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: scheduler benchmark : producer threads add and cancel tasks
+ *              on a running scheduler (through its inbox)
+ *
+ * Infinity Labs OL108
+ *
+ * usage - sched_inbox_bench [tasks per producer] [producers...]
+ *         (default 100000 1 2 4 8)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h), a case per number of
+ *                producers, the size is the adds (as many are cancelled), the
+ *                ops: submit (an add or a cancel), latency (from the add of
+ *                a due task to its run), run (lost - due tasks that did not
+ *                run, leftover - tasks left after SchedRun returned, both
+ *                should be 0)
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <stdio.h>    /* stdout, sprintf() */
+#include <stdlib.h>   /* malloc(), free(), atol(), qsort() */
+#include <stdint.h>   /* uint64_t */
+#include <pthread.h>  /* pthread_create(), pthread_join() */
+
+#include "mono_clock.h"
+#include "bench_util.h"
+#include "scheduler.h"
+
+#define DEFAULT_TASKS 100000
+#define MAX_PRODUCERS 64
+#define FAR_NS (3600 * MONO_NS_PER_SEC)
+#define GIVE_UP_NS (30 * MONO_NS_PER_SEC)
+#define UNUSED(x) (void)(x)
+
+typedef struct bench
+{
+    sched_t *sched;
+    uint64_t *submits;
+    uint64_t *latencies;
+    size_t tasks;
+    size_t producers;
+    size_t executed;
+    size_t done;
+    int is_started;
+    uint64_t start_ns;
+    uint64_t submit_ns;
+} bench_t;
+
+typedef struct
+{
+    bench_t *bench;
+    size_t first;
+} producer_t;
+
+static void RunBench(size_t producers, size_t tasks);
+static void *RunSched(void *arg);
+static void *Produce(void *arg);
+static int RunOnce(void *arg);
+static int Sentinel(void *arg);
+static void CleanUp(void *arg);
+static int LatencyCmp(const void *lhs, const void *rhs);
+
+static bench_t *curr_bench = NULL;
+/******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static const size_t defaults[] = {1, 2, 4, 8};
+    size_t tasks = (1 < argc) ? (size_t)atol(argv[1]) : DEFAULT_TASKS;
+    size_t runs = (2 < argc) ? (size_t)(argc - 2)
+                                : sizeof(defaults) / sizeof(defaults[0]);
+    size_t i = 0;
+
+    BenchPrintHeader(stdout);
+
+    for (i = 0; i < runs; ++i)
+    {
+        size_t producers = (2 < argc) ? (size_t)atol(argv[i + 2]) : defaults[i];
+
+        if (0 < producers && MAX_PRODUCERS >= producers)
+        {
+            RunBench(producers, tasks);
+        }
+    }
+
+    return 0;
+}
+
+/******************************************************************************/
+static void RunBench(size_t producers, size_t tasks)
+{
+    pthread_t runner, ids[MAX_PRODUCERS];
+    producer_t args[MAX_PRODUCERS];
+    bench_t bench = {0};
+    double latency_sum = 0;
+    char name[32];
+    size_t i = 0, total = producers * tasks, leftover = 0;
+
+    bench.sched = SchedCreate();
+    bench.submits = (uint64_t *)malloc(total * sizeof(uint64_t));
+    bench.latencies = (uint64_t *)malloc(total * sizeof(uint64_t));
+    bench.tasks = tasks;
+    bench.producers = producers;
+    if (NULL == bench.sched || NULL == bench.submits || NULL == bench.latencies)
+    {
+        if (NULL != bench.sched)
+        {
+            SchedDestroy(bench.sched);
+        }
+        free(bench.submits);
+        free(bench.latencies);
+        return;
+    }
+    curr_bench = &bench;
+
+    bench.start_ns = MonoNowNs();
+    SchedAddTaskNs(bench.sched, Sentinel, bench.start_ns, MONO_NS_PER_MS,
+                                                            &bench, CleanUp);
+    pthread_create(&runner, NULL, RunSched, &bench);
+
+    /* the producers start once SchedRun runs - the latency is of the loop */
+    while (!__atomic_load_n(&bench.is_started, __ATOMIC_ACQUIRE))
+    {
+        /* wait for the sentinel */
+    }
+
+    for (i = 0; i < producers; ++i)
+    {
+        args[i].bench = &bench;
+        args[i].first = i * tasks;
+        pthread_create(&ids[i], NULL, Produce, &args[i]);
+    }
+    for (i = 0; i < producers; ++i)
+    {
+        pthread_join(ids[i], NULL);
+    }
+    pthread_join(runner, NULL);
+
+    leftover = SchedSize(bench.sched);
+    SchedDestroy(bench.sched);
+
+    for (i = 0; i < bench.executed; ++i)
+    {
+        latency_sum += (double)bench.latencies[i];
+    }
+    qsort(bench.latencies, bench.executed, sizeof(uint64_t), LatencyCmp);
+
+    sprintf(name, "producers_%lu", (unsigned long)producers);
+    BenchPrintValue(stdout, "sched_inbox", name, total, "submit", "ns_per_op",
+                                    (double)bench.submit_ns / (2 * total));
+    BenchPrintValue(stdout, "sched_inbox", name, total, "latency", "avg_us",
+            (0 < bench.executed) ? latency_sum / bench.executed / 1e3 : 0.0);
+    BenchPrintValue(stdout, "sched_inbox", name, total, "latency", "p99_us",
+            (0 < bench.executed) ? bench.latencies[bench.executed * 99 / 100]
+                                                                / 1e3 : 0.0);
+    BenchPrintValue(stdout, "sched_inbox", name, total, "run", "lost",
+                                            (double)(total - bench.executed));
+    BenchPrintValue(stdout, "sched_inbox", name, total, "run", "leftover",
+                                                            (double)leftover);
+
+    free(bench.submits);
+    free(bench.latencies);
+}
+
+
+static void *RunSched(void *arg)
+{
+    SchedRun(((bench_t *)arg)->sched);
+
+    return NULL;
+}
+
+
+static void *Produce(void *arg)
+{
+    producer_t *producer = (producer_t *)arg;
+    bench_t *bench = producer->bench;
+    uint64_t start = MonoNowNs();
+    size_t i = 0;
+
+    /* a due task to run, and a far one cancelled right away */
+    for (i = producer->first; i < producer->first + bench->tasks; ++i)
+    {
+        sched_handle_t far = SCHED_BAD_HANDLE;
+
+        bench->submits[i] = MonoNowNs();
+        SchedAddTaskNs(bench->sched, RunOnce, bench->submits[i], 0,
+                                                    &bench->submits[i], CleanUp);
+
+        far = SchedAddTaskNs(bench->sched, RunOnce, MonoNowNs() + FAR_NS, 0,
+                                                                NULL, CleanUp);
+        SchedRemoveTask(bench->sched, far);
+    }
+
+    __atomic_add_fetch(&bench->submit_ns, MonoNowNs() - start,
+                                                        __ATOMIC_RELAXED);
+    __atomic_add_fetch(&bench->done, 1, __ATOMIC_RELEASE);
+
+    return NULL;
+}
+
+
+static int RunOnce(void *arg)
+{
+    uint64_t *submit = (uint64_t *)arg;
+
+    /* runs on the scheduler thread only */
+    if (NULL != submit)
+    {
+        curr_bench->latencies[curr_bench->executed++] = MonoNowNs() - *submit;
+    }
+
+    return 0;
+}
+
+
+static int Sentinel(void *arg)
+{
+    bench_t *bench = (bench_t *)arg;
+
+    __atomic_store_n(&bench->is_started, 1, __ATOMIC_RELEASE);
+
+    if ((bench->producers == __atomic_load_n(&bench->done, __ATOMIC_ACQUIRE)
+            && bench->producers * bench->tasks == bench->executed)
+            || MonoNowNs() - bench->start_ns > GIVE_UP_NS)
+    {
+        return SchedStop(bench->sched);
+    }
+
+    return 1;
+}
+
+
+static void CleanUp(void *arg)
+{
+    UNUSED(arg);
+}
+
+
+static int LatencyCmp(const void *lhs, const void *rhs)
+{
+    uint64_t left = *(const uint64_t *)lhs;
+    uint64_t right = *(const uint64_t *)rhs;
+
+    return (left > right) - (left < right);
+}
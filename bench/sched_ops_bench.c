@@ -0,0 +1,128 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: scheduler benchmark : throughput of SchedAddTaskNs,
+ *              SchedRemoveTask and SchedRun (due one-shot tasks) on the heap
+ *              and the timing wheel backends
+ *
+ * Infinity Labs OL108
+ *
+ * usage - sched_ops_bench [tasks...] (default 1000 10000 100000)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h), the ops:
+ *                add, remove, run
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <stdio.h>    /* stdout */
+#include <stdlib.h>   /* malloc(), free(), atol() */
+#include <stdint.h>   /* uint64_t */
+
+#include "mono_clock.h"
+#include "scheduler.h"
+#include "bench_util.h"
+
+#define SPREAD_NS MONO_NS_PER_MS
+#define UNUSED(x) (void)(x)
+
+static void RunBackend(sched_backend_t backend, const char *name, size_t n,
+                                                    sched_handle_t *handles);
+static void AddTasks(sched_t *sched, size_t n, sched_handle_t *handles,
+                                                            uint64_t start);
+static int Nop(void *arg);
+static void CleanUp(void *arg);
+/******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static const size_t defaults[] = {1000, 10000, 100000};
+    size_t runs = (1 < argc) ? (size_t)(argc - 1)
+                                : sizeof(defaults) / sizeof(defaults[0]);
+    size_t i = 0;
+
+    BenchPrintHeader(stdout);
+
+    for (i = 0; i < runs; ++i)
+    {
+        size_t n = (1 < argc) ? (size_t)atol(argv[i + 1]) : defaults[i];
+        sched_handle_t *handles =
+                        (sched_handle_t *)malloc(n * sizeof(sched_handle_t));
+
+        if (NULL == handles)
+        {
+            return 1;
+        }
+
+        RunBackend(SCHED_HEAP, "heap", n, handles);
+        RunBackend(SCHED_TIMING_WHEEL, "wheel", n, handles);
+
+        free(handles);
+    }
+
+    return 0;
+}
+
+/******************************************************************************/
+static void RunBackend(sched_backend_t backend, const char *name, size_t n,
+                                                    sched_handle_t *handles)
+{
+    sched_t *sched = SchedCreateBackend(backend);
+    bench_counters_t counters;
+    size_t i = 0;
+
+    if (NULL == sched)
+    {
+        return;
+    }
+    BenchOpen(&counters);
+
+    /* in the future, spread as timers are */
+    BenchStart(&counters);
+    AddTasks(sched, n, handles, MonoNowNs() + MONO_NS_PER_SEC);
+    BenchStop(&counters);
+    BenchPrint(stdout, "sched_ops", name, n, "add", n, &counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < n; ++i)
+    {
+        SchedRemoveTask(sched, handles[i]);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "sched_ops", name, n, "remove", n, &counters);
+
+    /* all due - SchedRun pops and runs them back to back */
+    AddTasks(sched, n, handles, MonoNowNs() - SPREAD_NS);
+    BenchStart(&counters);
+    SchedRun(sched);
+    BenchStop(&counters);
+    BenchPrint(stdout, "sched_ops", name, n, "run", n, &counters);
+
+    BenchClose(&counters);
+    SchedDestroy(sched);
+}
+
+
+static void AddTasks(sched_t *sched, size_t n, sched_handle_t *handles,
+                                                                uint64_t start)
+{
+    size_t i = 0;
+
+    for (i = 0; i < n; ++i)
+    {
+        handles[i] = SchedAddTaskNs(sched, Nop, start + i * (SPREAD_NS / n),
+                                                        0, NULL, CleanUp);
+    }
+}
+
+
+static int Nop(void *arg)
+{
+    UNUSED(arg);
+
+    return 0;
+}
+
+
+static void CleanUp(void *arg)
+{
+    UNUSED(arg);
+}
@@ -0,0 +1,175 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: scheduler benchmark : idle CPU and lateness of the sleeping
+ *              SchedRun compared with the old busy-wait loop
+ *
+ * Infinity Labs OL108
+ *
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h), a case per mode, the
+ *                size is the runs, the ops: wait (cpu_pct), lateness
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <stdio.h>         /* stdout */
+#include <stdlib.h>        /* atoi() */
+#include <time.h>          /* time(), clock_gettime() */
+#include <sys/resource.h>  /* getrusage() */
+
+#include "bench_util.h"
+#include "scheduler.h"
+
+#define DEFAULT_RUNS 5
+#define UNUSED(x) (void)(x)
+
+typedef struct
+{
+    sched_t *sched;
+    time_t expected;
+    int runs_left;
+    long lateness_sum_us;
+    long lateness_max_us;
+} bench_state_t;
+
+static int TickTask(void *arg);
+static void CleanUp(void *arg);
+static void RecordLateness(bench_state_t *state);
+static double CpuSeconds(void);
+static double WallSeconds(void);
+static void Report(const char *mode, int runs, double cpu, double wall,
+                                                    const bench_state_t *state);
+static void RunSleeping(int runs);
+static void RunSpinning(int runs);
+/******************************************************************************/
+int main(int argc, char *argv[])
+{
+    int runs = (1 < argc) ? atoi(argv[1]) : DEFAULT_RUNS;
+
+    BenchPrintHeader(stdout);
+    RunSpinning(runs);
+    RunSleeping(runs);
+
+    return 0;
+}
+
+/******************************************************************************/
+static void RunSleeping(int runs)
+{
+    bench_state_t state = {0};
+    double cpu = 0, wall = 0;
+
+    state.sched = SchedCreate();
+    if (NULL == state.sched)
+    {
+        return;
+    }
+
+    state.runs_left = runs;
+    state.expected = time(NULL) + 1;
+
+    SchedAddTask(state.sched, TickTask, state.expected, 1, &state, CleanUp);
+
+    cpu = CpuSeconds();
+    wall = WallSeconds();
+    SchedRun(state.sched);
+    cpu = CpuSeconds() - cpu;
+    wall = WallSeconds() - wall;
+
+    Report("sleep", runs, cpu, wall, &state);
+
+    SchedDestroy(state.sched);
+}
+
+
+static void RunSpinning(int runs)
+{
+    bench_state_t state = {0};
+    double cpu = CpuSeconds(), wall = WallSeconds();
+    int i = 0;
+
+    for (i = 0; i < runs; ++i)
+    {
+        state.expected = time(NULL) + 1;
+
+        /* the pre-timerfd SchedRun wait */
+        while (state.expected > time(NULL))
+        {
+            /* empty loop */
+        }
+
+        RecordLateness(&state);
+    }
+
+    cpu = CpuSeconds() - cpu;
+    wall = WallSeconds() - wall;
+
+    Report("spin", runs, cpu, wall, &state);
+}
+
+
+static int TickTask(void *arg)
+{
+    bench_state_t *state = (bench_state_t *)arg;
+
+    RecordLateness(state);
+    ++state->expected;
+
+    return (0 < --state->runs_left);
+}
+
+
+static void CleanUp(void *arg)
+{
+    UNUSED(arg);
+}
+
+
+static void RecordLateness(bench_state_t *state)
+{
+    struct timespec now;
+    long lateness_us = 0;
+
+    clock_gettime(CLOCK_REALTIME, &now);
+    lateness_us = (now.tv_sec - state->expected) * 1000000L
+                                                    + now.tv_nsec / 1000;
+
+    state->lateness_sum_us += lateness_us;
+    if (lateness_us > state->lateness_max_us)
+    {
+        state->lateness_max_us = lateness_us;
+    }
+}
+
+
+static double CpuSeconds(void)
+{
+    struct rusage usage;
+
+    getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+            + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+
+static double WallSeconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+static void Report(const char *mode, int runs, double cpu, double wall,
+                                                    const bench_state_t *state)
+{
+    BenchPrintValue(stdout, "sched_wait", mode, (size_t)runs, "wait",
+                                                "cpu_pct", 100.0 * cpu / wall);
+    BenchPrintValue(stdout, "sched_wait", mode, (size_t)runs, "lateness",
+        "avg_us", (0 < runs) ? (double)state->lateness_sum_us / runs : 0.0);
+    BenchPrintValue(stdout, "sched_wait", mode, (size_t)runs, "lateness",
+                                    "max_us", (double)state->lateness_max_us);
+}
@@ -0,0 +1,199 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: scheduler benchmark : lateness of short tasks next to slow
+ *              ones, with the operations run on 0 (SchedRun's thread) to N
+ *              worker threads
+ *
+ * Infinity Labs OL108
+ *
+ * usage - sched_workers_bench [seconds] [workers...] (default 2 0 1 2 4 8)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h), a case per number of
+ *                workers, the size is the fast tasks (next to SLOW_TASKS),
+ *                the op: fast_run (late - from the start time of a fast
+ *                task to its run)
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <stdio.h>    /* stdout, sprintf() */
+#include <stdlib.h>   /* malloc(), free(), atol(), qsort() */
+#include <stdint.h>   /* uint64_t */
+
+#include "mono_clock.h"
+#include "bench_util.h"
+#include "scheduler.h"
+
+#define DEFAULT_SECONDS 2
+#define FAST_TASKS 64
+#define FAST_INTERVAL_NS (2 * MONO_NS_PER_MS)
+#define FAST_WORK_NS (20 * MONO_NS_PER_US)
+#define SLOW_TASKS 2
+#define SLOW_INTERVAL_NS (50 * MONO_NS_PER_MS)
+#define SLOW_WORK_NS (15 * MONO_NS_PER_MS)
+#define MAX_SAMPLES (4 * 1024 * 1024)
+#define UNUSED(x) (void)(x)
+
+typedef struct
+{
+    uint64_t next_ns;
+    uint64_t interval_ns;
+    uint64_t work_ns;
+    int is_sampled;
+} load_t;
+
+static void RunBench(size_t workers, uint64_t seconds);
+static int Work(void *arg);
+static int Stop(void *arg);
+static void CleanUp(void *arg);
+static void Spin(uint64_t ns);
+static int LatenessCmp(const void *lhs, const void *rhs);
+
+static sched_t *curr_sched = NULL;
+static uint64_t *samples = NULL;
+static size_t n_samples = 0;
+/******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static const size_t defaults[] = {0, 1, 2, 4, 8};
+    uint64_t seconds = (1 < argc) ? (uint64_t)atol(argv[1]) : DEFAULT_SECONDS;
+    size_t runs = (2 < argc) ? (size_t)(argc - 2)
+                                : sizeof(defaults) / sizeof(defaults[0]);
+    size_t i = 0;
+
+    samples = (uint64_t *)malloc(MAX_SAMPLES * sizeof(uint64_t));
+    if (NULL == samples)
+    {
+        return 1;
+    }
+
+    BenchPrintHeader(stdout);
+
+    for (i = 0; i < runs; ++i)
+    {
+        RunBench((2 < argc) ? (size_t)atol(argv[i + 2]) : defaults[i],
+                                                                    seconds);
+    }
+
+    free(samples);
+
+    return 0;
+}
+
+/******************************************************************************/
+static void RunBench(size_t workers, uint64_t seconds)
+{
+    load_t fast[FAST_TASKS], slow[SLOW_TASKS];
+    double sum = 0;
+    uint64_t now = 0;
+    char name[32];
+    size_t i = 0, n = 0;
+
+    curr_sched = SchedCreate();
+    if (NULL == curr_sched)
+    {
+        return;
+    }
+    SchedSetWorkers(curr_sched, workers);
+    n_samples = 0;
+
+    /* the fast tasks are spread over their interval */
+    now = MonoNowNs() + MONO_NS_PER_MS;
+    for (i = 0; i < FAST_TASKS; ++i)
+    {
+        fast[i].next_ns = now + i * (FAST_INTERVAL_NS / FAST_TASKS);
+        fast[i].interval_ns = FAST_INTERVAL_NS;
+        fast[i].work_ns = FAST_WORK_NS;
+        fast[i].is_sampled = 1;
+        SchedAddTaskNs(curr_sched, Work, fast[i].next_ns, FAST_INTERVAL_NS,
+                                                            &fast[i], CleanUp);
+    }
+    for (i = 0; i < SLOW_TASKS; ++i)
+    {
+        slow[i].next_ns = now + i * (SLOW_INTERVAL_NS / SLOW_TASKS);
+        slow[i].interval_ns = SLOW_INTERVAL_NS;
+        slow[i].work_ns = SLOW_WORK_NS;
+        slow[i].is_sampled = 0;
+        SchedAddTaskNs(curr_sched, Work, slow[i].next_ns, SLOW_INTERVAL_NS,
+                                                            &slow[i], CleanUp);
+    }
+    SchedAddTaskNs(curr_sched, Stop, now + seconds * MONO_NS_PER_SEC, 0,
+                                                                NULL, CleanUp);
+
+    SchedRun(curr_sched);
+    SchedDestroy(curr_sched);
+
+    n = (MAX_SAMPLES < n_samples) ? MAX_SAMPLES : n_samples;
+    for (i = 0; i < n; ++i)
+    {
+        sum += (double)samples[i];
+    }
+    qsort(samples, n, sizeof(uint64_t), LatenessCmp);
+
+    sprintf(name, "workers_%lu", (unsigned long)workers);
+    BenchPrintValue(stdout, "sched_workers", name, FAST_TASKS, "fast_run",
+                                                            "runs", (double)n);
+    BenchPrintValue(stdout, "sched_workers", name, FAST_TASKS, "fast_run",
+                                "late_avg_us", (0 < n) ? sum / n / 1e3 : 0.0);
+    BenchPrintValue(stdout, "sched_workers", name, FAST_TASKS, "fast_run",
+            "late_p99_us", (0 < n) ? samples[n * 99 / 100] / 1e3 : 0.0);
+    BenchPrintValue(stdout, "sched_workers", name, FAST_TASKS, "fast_run",
+                    "late_max_us", (0 < n) ? samples[n - 1] / 1e3 : 0.0);
+}
+
+
+static int Work(void *arg)
+{
+    load_t *load = (load_t *)arg;
+    uint64_t now = MonoNowNs();
+
+    /* a task runs on one thread at a time, its load is not shared */
+    if (load->is_sampled)
+    {
+        size_t i = __atomic_fetch_add(&n_samples, 1, __ATOMIC_RELAXED);
+
+        if (i < MAX_SAMPLES)
+        {
+            samples[i] = (now > load->next_ns) ? now - load->next_ns : 0;
+        }
+    }
+    load->next_ns += load->interval_ns;
+
+    Spin(load->work_ns);
+
+    return 1;
+}
+
+
+static int Stop(void *arg)
+{
+    UNUSED(arg);
+
+    return SchedStop(curr_sched);
+}
+
+
+static void CleanUp(void *arg)
+{
+    UNUSED(arg);
+}
+
+
+static void Spin(uint64_t ns)
+{
+    uint64_t end = MonoNowNs() + ns;
+
+    while (MonoNowNs() < end)
+    {
+        /* busy, as a CPU bound operation */
+    }
+}
+
+
+static int LatenessCmp(const void *lhs, const void *rhs)
+{
+    uint64_t left = *(const uint64_t *)lhs;
+    uint64_t right = *(const uint64_t *)rhs;
+
+    return (left > right) - (left < right);
+}
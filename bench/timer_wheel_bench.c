@@ -0,0 +1,204 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: timer benchmark : timing wheel against the heap priority queue
+ *              (add, cancel and expire, on a simulated clock)
+ *
+ * Infinity Labs OL108
+ *
+ * usage - timer_wheel_bench [timers...] (default 1000 100000 1000000)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h), the ops: add, cancel
+ *                (CANCEL_PCT of the timers), expire
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <stdio.h>   /* stdout */
+#include <stdlib.h>  /* malloc(), free(), rand(), atol() */
+#include <stdint.h>  /* uint64_t */
+
+#include "mono_clock.h"
+#include "bench_util.h"
+#include "priority_queue.h"
+#include "timing_wheel.h"
+
+#define CANCEL_PCT 90
+#define SPAN_MS 60000
+#define TICK_NS MONO_NS_PER_MS
+
+typedef struct
+{
+    uint64_t deadline;
+    tw_node_t *node;
+    size_t heap_index;
+} bench_timer_t;
+
+static void InitTimers(bench_timer_t *timers, size_t *order, size_t n);
+static void RunWheel(bench_timer_t *timers, const size_t *order, size_t n);
+static void RunHeap(bench_timer_t *timers, const size_t *order, size_t n);
+static int DeadlineCmp(const void *lhs, const void *rhs);
+static void SetHeapIndex(void *timer, size_t index);
+/******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static const size_t defaults[] = {1000, 100000, 1000000};
+    size_t runs = (1 < argc) ? (size_t)(argc - 1)
+                                : sizeof(defaults) / sizeof(defaults[0]);
+    size_t i = 0;
+
+    BenchPrintHeader(stdout);
+
+    for (i = 0; i < runs; ++i)
+    {
+        size_t n = (1 < argc) ? (size_t)atol(argv[i + 1]) : defaults[i];
+        bench_timer_t *timers = (bench_timer_t *)malloc(n *
+                                                    sizeof(bench_timer_t));
+        size_t *order = (size_t *)malloc(n * sizeof(size_t));
+
+        if (NULL == timers || NULL == order)
+        {
+            free(timers);
+            free(order);
+            return 1;
+        }
+
+        InitTimers(timers, order, n);
+        RunWheel(timers, order, n);
+
+        InitTimers(timers, order, n);
+        RunHeap(timers, order, n);
+
+        free(timers);
+        free(order);
+    }
+
+    return 0;
+}
+
+/******************************************************************************/
+static void InitTimers(bench_timer_t *timers, size_t *order, size_t n)
+{
+    size_t i = 0;
+
+    srand(108);
+
+    for (i = 0; i < n; ++i)
+    {
+        timers[i].deadline = (uint64_t)(rand() % SPAN_MS) * TICK_NS
+                                                + (uint64_t)(rand() % TICK_NS);
+        timers[i].node = NULL;
+        timers[i].heap_index = PQ_NO_INDEX;
+        order[i] = i;
+    }
+
+    /* the cancel order - a random permutation */
+    for (i = n; 1 < i; --i)
+    {
+        size_t j = (size_t)rand() % i;
+        size_t tmp = order[i - 1];
+
+        order[i - 1] = order[j];
+        order[j] = tmp;
+    }
+}
+
+
+static void RunWheel(bench_timer_t *timers, const size_t *order, size_t n)
+{
+    timing_wheel_t *wheel = TWCreate(TICK_NS, 0);
+    size_t cancels = n * CANCEL_PCT / 100, i = 0, expired = 0;
+    bench_counters_t counters;
+    uint64_t now = 0;
+
+    BenchOpen(&counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < n; ++i)
+    {
+        timers[i].node = TWInsert(wheel, &timers[i], timers[i].deadline);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "timer_wheel", "wheel", n, "add", n, &counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < cancels; ++i)
+    {
+        TWRemove(wheel, timers[order[i]].node);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "timer_wheel", "wheel", n, "cancel", cancels,
+                                                                &counters);
+
+    BenchStart(&counters);
+    for (now = 0; !TWIsEmpty(wheel); now += TICK_NS)
+    {
+        while (NULL != TWPopExpired(wheel, now))
+        {
+            ++expired;
+        }
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "timer_wheel", "wheel", n, "expire", expired,
+                                                                &counters);
+
+    BenchClose(&counters);
+    TWDestroy(wheel);
+}
+
+
+static void RunHeap(bench_timer_t *timers, const size_t *order, size_t n)
+{
+    pq_t *pq = PQCreateIndexed(DeadlineCmp, SetHeapIndex);
+    size_t cancels = n * CANCEL_PCT / 100, i = 0, expired = 0;
+    bench_counters_t counters;
+    uint64_t now = 0;
+
+    BenchOpen(&counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < n; ++i)
+    {
+        PQEnqueue(pq, &timers[i]);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "timer_wheel", "heap", n, "add", n, &counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < cancels; ++i)
+    {
+        PQEraseAt(pq, timers[order[i]].heap_index);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "timer_wheel", "heap", n, "cancel", cancels, &counters);
+
+    BenchStart(&counters);
+    for (now = 0; !PQIsEmpty(pq); now += TICK_NS)
+    {
+        while (!PQIsEmpty(pq)
+                && ((bench_timer_t *)PQPeek(pq))->deadline <= now)
+        {
+            PQDequeue(pq);
+            ++expired;
+        }
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "timer_wheel", "heap", n, "expire", expired, &counters);
+
+    BenchClose(&counters);
+    PQDestroy(pq);
+}
+
+
+static int DeadlineCmp(const void *lhs, const void *rhs)
+{
+    uint64_t left = ((const bench_timer_t *)lhs)->deadline;
+    uint64_t right = ((const bench_timer_t *)rhs)->deadline;
+
+    return (left > right) - (left < right);
+}
+
+
+static void SetHeapIndex(void *timer, size_t index)
+{
+    ((bench_timer_t *)timer)->heap_index = index;
+}
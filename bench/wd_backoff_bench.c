@@ -0,0 +1,196 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog benchmark : the restart backoff and budget of a pair
+ *              (WdStateRestart, wd_state.h) replayed over a crash loop - a
+ *              user process that dies LIFE_MS after each start, for a minute.
+ *              Its death is seen at once (its pidfd), a revival in its
+ *              backoff is asked again at each check of the misses, an
+ *              interval apart, as the watchdog process does - the checks of
+ *              each pair in a phase of their own (a random one).
+ *              - one - a pair
+ *              - herd - PAIRS pairs whose processes die together (a service
+ *                they share went down), seen a microsecond or so apart - the
+ *                peak restarts in a PEAK_MS bucket after the first round
+ *                shows how far the jitter spreads them
+ *              Each runs without a backoff, with one, and with one and a
+ *              budget.
+ *
+ * Infinity Labs OL108
+ *
+ * usage - wd_backoff_bench [backoff ms] [budget] [interval ms]
+ *         (default 100, 5 and 100 - the window is the default minute)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h), a case per scenario,
+ *                backoff and budget, the size is the pairs, the op:
+ *                crash_loop (restarts of all the pairs, quarantined - the
+ *                pairs given up, quarantine - from the first death, left out
+ *                if none, peak - the most restarts in a PEAK_MS bucket after
+ *                the first second)
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <stdio.h>      /* stdout, sprintf() */
+#include <stdlib.h>     /* atoi(), calloc(), free() */
+#include <string.h>     /* memset() */
+#include <stdint.h>     /* uint64_t */
+
+#include "mono_clock.h" /* MONO_NS_PER_MS, MONO_NS_PER_SEC */
+#include "bench_util.h"
+#include "wd_state.h"
+
+#define DEFAULT_BACKOFF_MS 100
+#define DEFAULT_BUDGET 5
+#define DEFAULT_INTERVAL_MS 100
+#define LIFE_MS 50
+#define RUN_SEC 60
+#define PAIRS 100
+#define PEAK_MS 10
+#define BUCKETS (RUN_SEC * 1000 / PEAK_MS)
+
+/* the monotonic clock of the replay - a start clear of 0 */
+#define START_NS MONO_NS_PER_SEC
+
+typedef struct
+{
+    uint64_t restarts;
+    uint64_t quarantined;
+    uint64_t quarantine_ns;     /* summed */
+    uint64_t peak;
+} replay_t;
+
+static void Replay(const char *scenario, size_t pairs,
+                        unsigned long backoff_ms, int budget,
+                        uint64_t interval_ns);
+static void ReplayPair(wd_state_t *state, uint64_t skew_ns,
+                        uint64_t interval_ns, uint64_t *buckets,
+                        replay_t *replay);
+static uint64_t Random(void);
+
+static wd_state_t pair;
+
+/* no 64-bit constants in C89 */
+static uint64_t rng = ((uint64_t)0x9e3779b9 << 32) | 0x7f4a7c15;
+/******************************************************************************/
+int main(int argc, char *argv[])
+{
+    unsigned long backoff_ms = (1 < argc) ? (unsigned long)atoi(argv[1])
+                                                        : DEFAULT_BACKOFF_MS;
+    int budget = (2 < argc) ? atoi(argv[2]) : DEFAULT_BUDGET;
+    uint64_t interval_ns = (uint64_t)((3 < argc) ? atoi(argv[3])
+                                    : DEFAULT_INTERVAL_MS) * MONO_NS_PER_MS;
+
+    if (0 == backoff_ms || 0 == interval_ns)
+    {
+        return 1;
+    }
+
+    BenchPrintHeader(stdout);
+
+    Replay("one", 1, 0, 0, interval_ns);
+    Replay("one", 1, backoff_ms, 0, interval_ns);
+    Replay("one", 1, backoff_ms, budget, interval_ns);
+    Replay("herd", PAIRS, 0, 0, interval_ns);
+    Replay("herd", PAIRS, backoff_ms, 0, interval_ns);
+    Replay("herd", PAIRS, backoff_ms, budget, interval_ns);
+
+    return 0;
+}
+
+/******************************************************************************/
+static void Replay(const char *scenario, size_t pairs,
+                        unsigned long backoff_ms, int budget,
+                        uint64_t interval_ns)
+{
+    uint64_t *buckets = (uint64_t *)calloc(BUCKETS, sizeof(uint64_t));
+    replay_t replay;
+    char name[64];
+    size_t i = 0;
+
+    if (NULL == buckets)
+    {
+        return;
+    }
+    memset(&replay, 0, sizeof(replay));
+
+    for (i = 0; i < pairs; ++i)
+    {
+        /* a pair of its own - the restarts of one are its own */
+        memset(&pair, 0, sizeof(pair));
+        pair.config.restart_backoff_ms = backoff_ms;
+        pair.config.restart_budget = budget;
+
+        /* the wake ups of the watchdog processes of a host, a few
+           microseconds apart */
+        ReplayPair(&pair, i * (MONO_NS_PER_MS / 1000 + i % 7), interval_ns,
+                                                            buckets, &replay);
+    }
+
+    for (i = 1000 / PEAK_MS; i < BUCKETS; ++i)
+    {
+        if (buckets[i] > replay.peak)
+        {
+            replay.peak = buckets[i];
+        }
+    }
+
+    sprintf(name, "%s_backoff%lu_budget%d", scenario, backoff_ms, budget);
+    BenchPrintValue(stdout, "wd_backoff", name, pairs, "crash_loop",
+                                        "restarts", (double)replay.restarts);
+    BenchPrintValue(stdout, "wd_backoff", name, pairs, "crash_loop",
+        "restarts_per_min", (double)replay.restarts / pairs / RUN_SEC * 60);
+    BenchPrintValue(stdout, "wd_backoff", name, pairs, "crash_loop",
+                                    "quarantined", (double)replay.quarantined);
+    if (0 != replay.quarantined)
+    {
+        BenchPrintValue(stdout, "wd_backoff", name, pairs, "crash_loop",
+                "quarantine_avg_ms", (double)replay.quarantine_ns
+                                / replay.quarantined / MONO_NS_PER_MS);
+    }
+    BenchPrintValue(stdout, "wd_backoff", name, pairs, "crash_loop",
+                                        "peak_restarts", (double)replay.peak);
+
+    free(buckets);
+}
+
+
+static void ReplayPair(wd_state_t *state, uint64_t skew_ns,
+                        uint64_t interval_ns, uint64_t *buckets,
+                        replay_t *replay)
+{
+    uint64_t end_ns = START_NS + (uint64_t)RUN_SEC * MONO_NS_PER_SEC;
+    uint64_t now = START_NS + skew_ns;
+    uint64_t phase_ns = Random() % interval_ns;
+
+    while (now < end_ns)
+    {
+        wd_restart_t answer = WdStateRestart(state, WD_ROLE_USER, now);
+
+        if (WD_RESTART_NEVER == answer)
+        {
+            ++replay->quarantined;
+            replay->quarantine_ns += now - START_NS;
+            return;
+        }
+        if (WD_RESTART_LATER == answer)
+        {
+            now += interval_ns - (now - phase_ns) % interval_ns;
+            continue;
+        }
+
+        ++replay->restarts;
+        ++buckets[(now - START_NS) / (PEAK_MS * MONO_NS_PER_MS) % BUCKETS];
+        now += LIFE_MS * MONO_NS_PER_MS;
+    }
+}
+
+
+static uint64_t Random(void)
+{
+    /* xorshift64 */
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+
+    return rng;
+}
@@ -0,0 +1,213 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: heartbeat transport benchmark : SIGUSR1 against the shared
+ *              page of wd_channel.h - the cost of sending a heartbeat, and
+ *              the round trip of a heartbeat answered by a child process
+ *              (the shared page is polled, as the watchdog reads it)
+ *
+ * Infinity Labs OL108
+ *
+ * usage - wd_channel_bench [round trips] (default 20000)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h), a case per transport,
+ *                the size is the round trips, the ops: send (a heartbeat
+ *                nobody waits for, a kill() or a store), round_trip
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <sched.h>      /* sched_yield() */
+#include <signal.h>     /* kill(), sigwaitinfo(), sigprocmask() */
+#include <stdio.h>      /* stdout */
+#include <stdlib.h>     /* malloc(), free(), atol(), qsort() */
+#include <stdint.h>     /* uint32_t, uint64_t */
+#include <unistd.h>     /* fork(), getpid(), getppid(), close(), _exit() */
+#include <sys/wait.h>   /* waitpid() */
+
+#include "mono_clock.h"
+#include "bench_util.h"
+#include "wd_channel.h"
+
+#define DEFAULT_ROUND_TRIPS 20000
+#define SEND_OPS 1000000
+#define WAIT_NS MONO_NS_PER_SEC
+
+static void RunSignal(size_t trips, uint64_t *rtts);
+static void RunShm(size_t trips, uint64_t *rtts);
+static uint32_t Poll(const wd_beat_t *beat, uint32_t seen);
+/* reads the counter until it moves past seen, or WAIT_NS pass */
+static uint32_t Poll(const wd_beat_t *beat, uint32_t seen)
+{
+    uint64_t deadline = MonoNowNs() + WAIT_NS;
+    uint32_t seq = seen;
+
+    while (seen == (seq = WdChannelSeq(beat)) && MonoNowNs() < deadline)
+    {
+        sched_yield();
+    }
+
+    return seq;
+}
+
+
+static void Report(const char *transport, size_t trips, double send_ns,
+                                                            uint64_t *rtts);
+static int RttCmp(const void *lhs, const void *rhs);
+/******************************************************************************/
+int main(int argc, char *argv[])
+{
+    size_t trips = (1 < argc) ? (size_t)atol(argv[1]) : DEFAULT_ROUND_TRIPS;
+    uint64_t *rtts = NULL;
+
+    if (0 == trips)
+    {
+        return 1;
+    }
+
+    rtts = (uint64_t *)malloc(trips * sizeof(uint64_t));
+    if (NULL == rtts)
+    {
+        return 1;
+    }
+
+    BenchPrintHeader(stdout);
+
+    RunSignal(trips, rtts);
+    RunShm(trips, rtts);
+
+    free(rtts);
+
+    return 0;
+}
+
+/******************************************************************************/
+static void RunSignal(size_t trips, uint64_t *rtts)
+{
+    sigset_t set;
+    uint64_t start = 0;
+    double send_ns = 0;
+    pid_t child = 0, self = getpid();
+    size_t i = 0;
+
+    /* blocked in both processes, taken with sigwaitinfo */
+    sigemptyset(&set);
+    sigaddset(&set, SIGUSR1);
+    sigprocmask(SIG_BLOCK, &set, NULL);
+
+    start = MonoNowNs();
+    for (i = 0; i < SEND_OPS; ++i)
+    {
+        kill(self, SIGUSR1);
+    }
+    send_ns = (double)(MonoNowNs() - start) / SEND_OPS;
+    sigwaitinfo(&set, NULL);
+
+    child = fork();
+    if (0 == child)
+    {
+        pid_t parent = getppid();
+
+        for (i = 0; i < trips; ++i)
+        {
+            sigwaitinfo(&set, NULL);
+            kill(parent, SIGUSR1);
+        }
+        _exit(0);
+    }
+
+    for (i = 0; i < trips && 0 < child; ++i)
+    {
+        start = MonoNowNs();
+        kill(child, SIGUSR1);
+        sigwaitinfo(&set, NULL);
+        rtts[i] = MonoNowNs() - start;
+    }
+
+    waitpid(child, NULL, 0);
+    sigprocmask(SIG_UNBLOCK, &set, NULL);
+
+    Report("signal", (0 < child) ? trips : 0, send_ns, rtts);
+}
+
+
+static void RunShm(size_t trips, uint64_t *rtts)
+{
+    int fd = -1;
+    wd_channel_t *channel = WdChannelCreate(&fd);
+    uint64_t start = 0;
+    double send_ns = 0;
+    uint32_t seen = 0, child_seen = 0;
+    pid_t child = 0;
+    size_t i = 0;
+
+    if (NULL == channel)
+    {
+        return;
+    }
+
+    /* nobody waits on from_wd yet - a store and a load */
+    start = MonoNowNs();
+    for (i = 0; i < SEND_OPS; ++i)
+    {
+        WdChannelBeat(&channel->from_wd);
+    }
+    send_ns = (double)(MonoNowNs() - start) / SEND_OPS;
+    seen = WdChannelSeq(&channel->from_wd);
+
+    /* read before the fork - the first beat may come before the child runs */
+    child_seen = WdChannelSeq(&channel->to_wd);
+    child = fork();
+    if (0 == child)
+    {
+        for (i = 0; i < trips; ++i)
+        {
+            child_seen = Poll(&channel->to_wd, child_seen);
+            WdChannelBeat(&channel->from_wd);
+        }
+        _exit(0);
+    }
+
+    for (i = 0; i < trips && 0 < child; ++i)
+    {
+        start = MonoNowNs();
+        WdChannelBeat(&channel->to_wd);
+        seen = Poll(&channel->from_wd, seen);
+        rtts[i] = MonoNowNs() - start;
+    }
+
+    waitpid(child, NULL, 0);
+    WdChannelClose(channel);
+    close(fd);
+
+    Report("shm_poll", (0 < child) ? trips : 0, send_ns, rtts);
+}
+
+
+static void Report(const char *transport, size_t trips, double send_ns,
+                                                                uint64_t *rtts)
+{
+    double sum = 0;
+    size_t i = 0;
+
+    for (i = 0; i < trips; ++i)
+    {
+        sum += (double)rtts[i];
+    }
+    qsort(rtts, trips, sizeof(uint64_t), RttCmp);
+
+    BenchPrintValue(stdout, "wd_channel", transport, trips, "send",
+                                                        "ns_per_op", send_ns);
+    BenchPrintValue(stdout, "wd_channel", transport, trips, "round_trip",
+                            "avg_us", (0 < trips) ? sum / trips / 1e3 : 0.0);
+    BenchPrintValue(stdout, "wd_channel", transport, trips, "round_trip",
+                "p99_us", (0 < trips) ? rtts[trips * 99 / 100] / 1e3 : 0.0);
+}
+
+
+static int RttCmp(const void *lhs, const void *rhs)
+{
+    uint64_t left = *(const uint64_t *)lhs;
+    uint64_t right = *(const uint64_t *)rhs;
+
+    return (left > right) - (left < right);
+}
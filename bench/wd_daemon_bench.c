@@ -0,0 +1,316 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog benchmark : CPU and memory of one watchdog daemon
+ *              watching 10 to 10K clients, against the watchdog process of
+ *              a single client (started per client without a daemon)
+ *
+ * Infinity Labs OL108
+ *
+ * usage - wd_daemon_bench [watchdog path] [interval ms] [seconds]
+ *                                                          [clients...]
+ *         (default ./watchdog_process 100 3 10 1000 10000)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h), a case per mode, the
+ *                size is the clients, the op: watch (the clients live in
+ *                this process - a socket and a mapped channel each, beating
+ *                every interval)
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <signal.h>         /* kill(), SIGKILL */
+#include <stdio.h>          /* sprintf(), fopen(), fscanf(), fflush() */
+#include <stdlib.h>         /* malloc(), free(), atol(), setenv() */
+#include <stdint.h>         /* uint64_t */
+#include <string.h>         /* strncmp() */
+#include <time.h>           /* nanosleep() */
+#include <unistd.h>         /* fork(), execl(), close(), dup(), sysconf() */
+#include <sys/resource.h>   /* setrlimit(), RLIMIT_NOFILE */
+#include <sys/wait.h>       /* waitpid() */
+
+#include "mono_clock.h"
+#include "bench_util.h"
+#include "wd_daemon.h"
+#include "wd_user_process.h"
+
+#define DEFAULT_INTERVAL_MS 100
+#define DEFAULT_SECONDS 3
+#define MISS_LIMIT 1000
+#define JOIN_ATTEMPTS 200
+#define JOIN_WAIT_NS (5 * MONO_NS_PER_MS)
+
+static void RunDaemon(const char *watchdog_path, size_t n_clients,
+                                        unsigned long interval_ms, int seconds);
+static void RunProcess(const char *watchdog_path, unsigned long interval_ms,
+                                                                int seconds);
+static void Beat(wd_channel_t **channels, size_t n, uint64_t interval_ns,
+                                                                int seconds);
+static pid_t SpawnDaemon(const char *watchdog_path, const char *name);
+static void Report(const char *mode, size_t n_clients, pid_t pid,
+                                                unsigned long ticks, int seconds);
+static unsigned long CpuTicks(pid_t pid);
+static unsigned long RssKb(pid_t pid);
+static void Pause(uint64_t ns);
+
+static FILE *csv = NULL;
+static char **bench_argv = NULL;
+static char **bench_envp = NULL;
+/******************************************************************************/
+int main(int argc, char *argv[], char *envp[])
+{
+    static const size_t defaults[] = {10, 1000, 10000};
+    const char *watchdog_path = (1 < argc) ? argv[1] : "./watchdog_process";
+    unsigned long interval_ms = (2 < argc) ? (unsigned long)atol(argv[2])
+                                                        : DEFAULT_INTERVAL_MS;
+    int seconds = (3 < argc) ? atoi(argv[3]) : DEFAULT_SECONDS;
+    size_t runs = (4 < argc) ? (size_t)(argc - 4)
+                                : sizeof(defaults) / sizeof(defaults[0]);
+    struct rlimit files;
+    size_t i = 0;
+
+    csv = fdopen(dup(1), "w");
+    if (NULL == csv || 0 == interval_ms || 0 >= seconds)
+    {
+        return 1;
+    }
+    bench_argv = argv;
+    bench_envp = envp;
+
+    /* the watchdogs print their events */
+    if (NULL == freopen("/dev/null", "w", stdout))
+    {
+        return 1;
+    }
+
+    /* a socket per client, here and in the daemon */
+    if (0 == getrlimit(RLIMIT_NOFILE, &files))
+    {
+        files.rlim_cur = files.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &files);
+    }
+
+    BenchPrintHeader(csv);
+    fflush(csv);
+
+    RunProcess(watchdog_path, interval_ms, seconds);
+    for (i = 0; i < runs; ++i)
+    {
+        RunDaemon(watchdog_path, (4 < argc) ? (size_t)atol(argv[i + 4])
+                                        : defaults[i], interval_ms, seconds);
+    }
+
+    return 0;
+}
+
+/******************************************************************************/
+static void RunDaemon(const char *watchdog_path, size_t n_clients,
+                                        unsigned long interval_ms, int seconds)
+{
+    watchdog_data_t wd_data = {0};
+    char *client_argv[] = {"true", NULL};
+    char name[64];
+    wd_channel_t **channels = NULL;
+    int *socks = NULL;
+    unsigned long ticks = 0;
+    pid_t daemon_pid = 0, pid = 0;
+    size_t i = 0, n = 0;
+
+    channels = (wd_channel_t **)malloc(n_clients * sizeof(wd_channel_t *));
+    socks = (int *)malloc(n_clients * sizeof(int));
+
+    sprintf(name, "wd_daemon_bench_%d_%lu", (int)getpid(),
+                                                    (unsigned long)n_clients);
+    daemon_pid = SpawnDaemon(watchdog_path, name);
+
+    /* the daemon would revive these, they never exit */
+    wd_data.process_path = "/bin/true";
+    wd_data.argv = client_argv;
+    wd_data.signal_to_wd_interval_ms = interval_ms;
+    wd_data.signal_from_wd_interval_ms = interval_ms;
+    wd_data.signal_to_wd_miss_limit = MISS_LIMIT;
+    wd_data.signal_from_wd_miss_limit = MISS_LIMIT;
+    wd_data.daemon_name = name;
+
+    for (n = 0; NULL != channels && NULL != socks && 0 < daemon_pid
+                                                        && n < n_clients; ++n)
+    {
+        socks[n] = WdDaemonConnect(name, &pid);
+        for (i = 0; -1 == socks[n] && i < JOIN_ATTEMPTS; ++i)
+        {
+            Pause(JOIN_WAIT_NS);
+            socks[n] = WdDaemonConnect(name, &pid);
+        }
+        channels[n] = (-1 == socks[n]) ? NULL
+                                : WdDaemonRegister(socks[n], &wd_data);
+        if (NULL == channels[n])
+        {
+            if (-1 != socks[n])
+            {
+                close(socks[n]);
+            }
+            break;
+        }
+    }
+
+    if (n == n_clients)
+    {
+        /* settled - the registrations are not measured */
+        Beat(channels, n, interval_ms * MONO_NS_PER_MS, 1);
+        ticks = CpuTicks(daemon_pid);
+        Beat(channels, n, interval_ms * MONO_NS_PER_MS, seconds);
+        Report("daemon", n, daemon_pid, CpuTicks(daemon_pid) - ticks,
+                                                                    seconds);
+    }
+
+    if (0 < daemon_pid)
+    {
+        kill(daemon_pid, SIGKILL);
+        waitpid(daemon_pid, NULL, 0);
+    }
+    for (i = 0; i < n; ++i)
+    {
+        WdChannelClose(channels[i]);
+        close(socks[i]);
+    }
+    free(socks);
+    free(channels);
+}
+
+
+static void RunProcess(const char *watchdog_path, unsigned long interval_ms,
+                                                                    int seconds)
+{
+    watchdog_data_t wd_data = {0};
+    unsigned long ticks = 0;
+    pthread_t thread;
+
+    wd_data.watchdog_path = watchdog_path;
+    wd_data.process_path = bench_argv[0];
+    wd_data.argv = bench_argv;
+    wd_data.envp = bench_envp;
+    wd_data.signal_to_wd_interval_ms = interval_ms;
+    wd_data.signal_from_wd_interval_ms = interval_ms;
+    wd_data.signal_to_wd_miss_limit = MISS_LIMIT;
+    wd_data.signal_from_wd_miss_limit = MISS_LIMIT;
+    wd_data.transport = WD_TRANSPORT_SHM;
+
+    thread = StartWatchDog(&wd_data);
+    Pause(MONO_NS_PER_SEC);
+
+    ticks = CpuTicks(WatchDogPid());
+    Pause((uint64_t)seconds * MONO_NS_PER_SEC);
+    Report("process", 1, WatchDogPid(), CpuTicks(WatchDogPid()) - ticks,
+                                                                    seconds);
+
+    EndWatchDog(thread);
+}
+
+
+static void Beat(wd_channel_t **channels, size_t n, uint64_t interval_ns,
+                                                                    int seconds)
+{
+    uint64_t end = MonoNowNs() + (uint64_t)seconds * MONO_NS_PER_SEC;
+    size_t i = 0;
+
+    while (MonoNowNs() < end)
+    {
+        for (i = 0; i < n; ++i)
+        {
+            WdChannelBeat(&channels[i]->to_wd);
+        }
+        Pause(interval_ns);
+    }
+}
+
+
+static pid_t SpawnDaemon(const char *watchdog_path, const char *name)
+{
+    pid_t pid = fork();
+
+    if (0 == pid)
+    {
+        setenv("daemon_name", name, 1);
+        execl(watchdog_path, watchdog_path, (char *)NULL);
+        _exit(1);
+    }
+
+    return pid;
+}
+
+
+static void Report(const char *mode, size_t n_clients, pid_t pid,
+                                                unsigned long ticks, int seconds)
+{
+    unsigned long rss = RssKb(pid);
+
+    BenchPrintValue(csv, "wd_daemon", mode, n_clients, "watch", "cpu_pct",
+                    100.0 * ticks / sysconf(_SC_CLK_TCK) / seconds);
+    BenchPrintValue(csv, "wd_daemon", mode, n_clients, "watch", "rss_kb",
+                                                                (double)rss);
+    BenchPrintValue(csv, "wd_daemon", mode, n_clients, "watch",
+                                "rss_per_client_kb", (double)rss / n_clients);
+    fflush(csv);
+}
+
+
+static unsigned long CpuTicks(pid_t pid)
+{
+    char path[64];
+    unsigned long utime = 0, stime = 0;
+    FILE *file = NULL;
+
+    sprintf(path, "/proc/%d/stat", (int)pid);
+    file = fopen(path, "r");
+    if (NULL == file)
+    {
+        return 0;
+    }
+
+    /* pid (comm) state ppid pgrp session tty tpgid flags minflt cminflt
+       majflt cmajflt utime stime - comm has no spaces here */
+    if (2 != fscanf(file, "%*d %*s %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u "
+                                                "%*u %lu %lu", &utime, &stime))
+    {
+        utime = stime = 0;
+    }
+    fclose(file);
+
+    return utime + stime;
+}
+
+
+static unsigned long RssKb(pid_t pid)
+{
+    char path[64], line[128];
+    unsigned long rss = 0;
+    FILE *file = NULL;
+
+    sprintf(path, "/proc/%d/status", (int)pid);
+    file = fopen(path, "r");
+    if (NULL == file)
+    {
+        return 0;
+    }
+
+    while (NULL != fgets(line, sizeof(line), file))
+    {
+        if (0 == strncmp(line, "VmRSS:", 6))
+        {
+            sscanf(line + 6, "%lu", &rss);
+            break;
+        }
+    }
+    fclose(file);
+
+    return rss;
+}
+
+
+static void Pause(uint64_t ns)
+{
+    struct timespec ts;
+
+    ts.tv_sec = (time_t)(ns / MONO_NS_PER_SEC);
+    ts.tv_nsec = (long)(ns % MONO_NS_PER_SEC);
+    nanosleep(&ts, NULL);
+}
@@ -0,0 +1,216 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog benchmark : cost of sampling the resource use of a
+ *              process (wd_limits.h), through the handles the watchdog keeps
+ *              open against opening the /proc files at every sample
+ *              - rss / cpu - /proc/<pid>/statm and stat, pread() of the open
+ *                file (cached) or open(), read() and close() (reopen)
+ *              - fds - fstat() of /proc/<pid>/fd, its size the count since
+ *                Linux 6.2 (cached), or opendir(), readdir() and closedir()
+ *                (reopen), at 16 and 1000 open files
+ *              - sample - WdLimitsSample with the three limits set, the
+ *                CPU in its period (the stat file read) and out of it (a
+ *                sample of the watchdog every interval but one a second)
+ *              The process samples itself.
+ *
+ * Infinity Labs OL108
+ *
+ * usage - wd_limits_bench [samples] (default 100000)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h), the
+ *                size is the open files
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <dirent.h>     /* opendir(), readdir(), closedir() */
+#include <fcntl.h>      /* open(), O_RDONLY */
+#include <stdio.h>      /* stdout, sprintf() */
+#include <stdlib.h>     /* atol() */
+#include <string.h>     /* memset() */
+#include <unistd.h>     /* read(), close(), dup(), getpid() */
+
+#include "wd_limits.h"
+#include "bench_util.h"
+
+#define DEFAULT_SAMPLES 100000
+#define FEW_FDS 16
+#define MANY_FDS 1000
+#define BUFFER_SIZE 1024
+
+static void BenchFiles(bench_counters_t *counters, size_t samples,
+                                                                size_t fds);
+static void Reopen(const char *path);
+static void ReopenDir(const char *path);
+static void OpenFds(size_t fds);
+
+static char path_statm[64], path_stat[64], path_fd[64];
+/******************************************************************************/
+int main(int argc, char *argv[])
+{
+    size_t samples = (1 < argc) ? (size_t)atol(argv[1]) : DEFAULT_SAMPLES;
+    bench_counters_t counters;
+
+    if (0 == samples)
+    {
+        return 1;
+    }
+
+    sprintf(path_statm, "/proc/%d/statm", (int)getpid());
+    sprintf(path_stat, "/proc/%d/stat", (int)getpid());
+    sprintf(path_fd, "/proc/%d/fd", (int)getpid());
+
+    BenchPrintHeader(stdout);
+    BenchOpen(&counters);
+
+    OpenFds(FEW_FDS);
+    BenchFiles(&counters, samples, FEW_FDS);
+    OpenFds(MANY_FDS);
+    BenchFiles(&counters, samples / 10, MANY_FDS);
+
+    BenchClose(&counters);
+
+    return 0;
+}
+
+/******************************************************************************/
+static void BenchFiles(bench_counters_t *counters, size_t samples, size_t fds)
+{
+    wd_limits_t limits;
+    size_t i = 0;
+
+    /* a limit each, sampled alone */
+    memset(&limits, 0, sizeof(limits));
+    limits.max[WD_LIMIT_RSS] = 1;
+    WdLimitsOpen(&limits, getpid());
+    BenchStart(counters);
+    for (i = 0; i < samples; ++i)
+    {
+        WdLimitsSample(&limits, 1);
+    }
+    BenchStop(counters);
+    BenchPrint(stdout, "wd_limits", "rss_cached", fds, "sample", samples,
+                                                                counters);
+    WdLimitsClose(&limits);
+
+    BenchStart(counters);
+    for (i = 0; i < samples; ++i)
+    {
+        Reopen(path_statm);
+    }
+    BenchStop(counters);
+    BenchPrint(stdout, "wd_limits", "rss_reopen", fds, "sample", samples,
+                                                                counters);
+
+    limits.max[WD_LIMIT_RSS] = 0;
+    limits.max[WD_LIMIT_CPU] = 1;
+    WdLimitsOpen(&limits, getpid());
+    BenchStart(counters);
+    for (i = 0; i < samples; ++i)
+    {
+        /* past the CPU period every time - the stat file is read and
+           parsed */
+        WdLimitsSample(&limits, (i + 1) * WD_LIMITS_CPU_PERIOD_NS);
+    }
+    BenchStop(counters);
+    BenchPrint(stdout, "wd_limits", "cpu_cached", fds, "sample", samples,
+                                                                counters);
+    WdLimitsClose(&limits);
+
+    BenchStart(counters);
+    for (i = 0; i < samples; ++i)
+    {
+        Reopen(path_stat);
+    }
+    BenchStop(counters);
+    BenchPrint(stdout, "wd_limits", "cpu_reopen", fds, "sample", samples,
+                                                                counters);
+
+    limits.max[WD_LIMIT_CPU] = 0;
+    limits.max[WD_LIMIT_FDS] = 1;
+    WdLimitsOpen(&limits, getpid());
+    BenchStart(counters);
+    for (i = 0; i < samples; ++i)
+    {
+        WdLimitsSample(&limits, 1);
+    }
+    BenchStop(counters);
+    BenchPrint(stdout, "wd_limits", "fds_cached", fds, "sample", samples,
+                                                                counters);
+    WdLimitsClose(&limits);
+
+    BenchStart(counters);
+    for (i = 0; i < samples; ++i)
+    {
+        ReopenDir(path_fd);
+    }
+    BenchStop(counters);
+    BenchPrint(stdout, "wd_limits", "fds_reopen", fds, "sample", samples,
+                                                                counters);
+
+    limits.max[WD_LIMIT_RSS] = 1;
+    limits.max[WD_LIMIT_CPU] = 1;
+    WdLimitsOpen(&limits, getpid());
+    BenchStart(counters);
+    for (i = 0; i < samples; ++i)
+    {
+        WdLimitsSample(&limits, (i + 1) * WD_LIMITS_CPU_PERIOD_NS);
+    }
+    BenchStop(counters);
+    BenchPrint(stdout, "wd_limits", "sample_cpu_period", fds, "sample",
+                                                        samples, counters);
+
+    BenchStart(counters);
+    for (i = 0; i < samples; ++i)
+    {
+        WdLimitsSample(&limits, (samples + 1) * WD_LIMITS_CPU_PERIOD_NS + i);
+    }
+    BenchStop(counters);
+    BenchPrint(stdout, "wd_limits", "sample", fds, "sample", samples,
+                                                                counters);
+    WdLimitsClose(&limits);
+}
+
+
+static void Reopen(const char *path)
+{
+    char buffer[BUFFER_SIZE];
+    int fd = open(path, O_RDONLY);
+
+    if (-1 != fd)
+    {
+        if (0 > read(fd, buffer, sizeof(buffer)))
+        {
+            buffer[0] = '\0';
+        }
+        close(fd);
+    }
+}
+
+
+static void ReopenDir(const char *path)
+{
+    DIR *dir = opendir(path);
+    size_t entries = 0;
+
+    if (NULL != dir)
+    {
+        while (NULL != readdir(dir))
+        {
+            ++entries;
+        }
+        closedir(dir);
+    }
+}
+
+
+static void OpenFds(size_t fds)
+{
+    size_t i = 0;
+
+    /* 0, 1 and 2 are open */
+    for (i = 3; i < fds; ++i)
+    {
+        dup(0);
+    }
+}
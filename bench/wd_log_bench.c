@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog benchmark : cost of an event of the event log
+ *              (wd_log.h) against the printf it replaces on the heartbeat
+ *              path
+ *              - write - WdLogWrite, the time given
+ *              - write_now - WdLogWrite with MonoNowNs(), as LogEvent
+ *              - write_2_threads - two threads writing at once
+ *              - printf_line - a line-buffered printf (a terminal or a pipe
+ *                writes every line), to /dev/null
+ *
+ * Infinity Labs OL108
+ *
+ * usage - wd_log_bench [events] (default 1000000)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h)
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <pthread.h>  /* pthread_create(), pthread_join() */
+#include <stdio.h>    /* fprintf(), sprintf(), fopen(), setvbuf() */
+#include <stdlib.h>   /* atol() */
+#include <unistd.h>   /* getpid() */
+
+#include "mono_clock.h"
+#include "wd_log.h"
+#include "bench_util.h"
+
+#define DEFAULT_EVENTS 1000000
+
+static void *Writer(void *arg);
+
+static wd_log_t *event_log = NULL;
+static size_t events = DEFAULT_EVENTS;
+/******************************************************************************/
+int main(int argc, char *argv[])
+{
+    bench_counters_t counters;
+    char name[WD_LOG_NAME_MAX];
+    FILE *null_out = fopen("/dev/null", "w");
+    pthread_t thread;
+    int32_t pid = (int32_t)getpid();
+    size_t i = 0;
+
+    events = (1 < argc) ? (size_t)atol(argv[1]) : DEFAULT_EVENTS;
+    sprintf(name, WD_LOG_PREFIX "bench%d", (int)pid);
+    event_log = WdLogCreate(name);
+    if (NULL == event_log || NULL == null_out || 0 == events)
+    {
+        return 1;
+    }
+    WdLogUnlink(name);
+    setvbuf(null_out, NULL, _IOLBF, BUFSIZ);
+
+    BenchPrintHeader(stdout);
+    BenchOpen(&counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < events; ++i)
+    {
+        WdLogWrite(event_log, pid, WD_EVENT_RECEIVED, 1, i);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "wd_log", "ring", events, "write", events, &counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < events; ++i)
+    {
+        WdLogWrite(event_log, pid, WD_EVENT_RECEIVED, 1, MonoNowNs());
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "wd_log", "ring", events, "write_now", events,
+                                                                &counters);
+
+    /* the head line bounces between the cores */
+    BenchStart(&counters);
+    if (0 != pthread_create(&thread, NULL, Writer, NULL))
+    {
+        return 1;
+    }
+    Writer(NULL);
+    pthread_join(thread, NULL);
+    BenchStop(&counters);
+    BenchPrint(stdout, "wd_log", "ring", events, "write_2_threads",
+                                                    2 * events, &counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < events; ++i)
+    {
+        fprintf(null_out, "WD received\n");
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "wd_log", "stdio", events, "printf_line", events,
+                                                                &counters);
+
+    BenchClose(&counters);
+    WdLogClose(event_log);
+    fclose(null_out);
+
+    return 0;
+}
+
+/******************************************************************************/
+static void *Writer(void *arg)
+{
+    int32_t pid = (int32_t)getpid();
+    size_t i = 0;
+
+    for (i = 0; i < events; ++i)
+    {
+        WdLogWrite(event_log, pid, WD_EVENT_SENT, 1, i);
+    }
+
+    return arg;
+}
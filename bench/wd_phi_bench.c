@@ -0,0 +1,352 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog benchmark : the phi accrual detector (wd_phi.h)
+ *              against the miss limits, replayed over heartbeat traces - how
+ *              soon each detects a peer that stopped, and how often it
+ *              revives one that did not.
+ *              A trace is the arrival times of the heartbeats of a peer that
+ *              dies after the last one. A miss limit is checked every
+ *              interval (a random phase), a phi threshold WD_PHI_CHECKS times
+ *              an interval, as the processes do. A suspicion before the last
+ *              heartbeat is a false positive - the peer is taken as revived
+ *              then (the misses reset, the detector restarted) and the trace
+ *              goes on.
+ *              - steady - gaps of an interval, 2% deviation
+ *              - jittery - 15% deviation
+ *              - stalls - 5% deviation, and 1 gap in 200 stalled by 1 to 4
+ *                intervals (a paused or swapped host)
+ *              - trace - the heartbeats sent by a process of a recorded event
+ *                log (wd_events output, the signal transport logs them)
+ *
+ * Infinity Labs OL108
+ *
+ * usage - wd_phi_bench [interval ms] [events.csv [pid]]
+ *         (default 100, the synthetic traces only - a recorded trace is
+ *         replayed with the interval of its pair, from the sent events of
+ *         pid, the first pid that sent by default)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h), a case per scenario,
+ *                detector and threshold (the miss limit or phi), the size is
+ *                the beats, the op: detect (from the last heartbeat to the
+ *                suspicion)
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <math.h>       /* log(), sqrt(), cos() */
+#include <stdio.h>      /* fprintf(), sprintf(), fopen(), fgets(), sscanf() */
+#include <stdlib.h>     /* atoi(), malloc(), free() */
+#include <string.h>     /* strcmp() */
+#include <stdint.h>     /* uint64_t */
+
+#include "mono_clock.h" /* MONO_NS_PER_MS */
+#include "bench_util.h"
+#include "wd_phi.h"
+#include "wd_shared_api.h" /* WD_PHI_CHECKS */
+
+#define DEFAULT_INTERVAL_MS 100
+#define TRACES 20
+#define BEATS 10000             /* a trace - 17 minutes of 100ms heartbeats */
+#define MAX_TRACE_BEATS 1000000
+#define STALL_ONE_IN 200
+#define PI 3.14159265358979
+#define NS_PER_HOUR (3600.0 * 1000 * MONO_NS_PER_MS)
+
+typedef struct
+{
+    const char *name;
+    double stddev;              /* of a gap, in intervals */
+    int stalls;
+} scenario_t;
+
+typedef struct
+{
+    size_t false_positives;
+    uint64_t detect_ns;
+} replay_t;
+
+static const scenario_t scenarios[] =
+{
+    {"steady", 0.02, 0},
+    {"jittery", 0.15, 0},
+    {"stalls", 0.05, 1}
+};
+
+static const int miss_limits[] = {2, 3, 5};
+static const double phi_thresholds[] = {1, 2, 4, 8, 12, 16};
+
+/* no 64-bit constants in C89 */
+static uint64_t rng = ((uint64_t)0x9e3779b9 << 32) | 0x7f4a7c15;
+
+static double Uniform(void);
+static double Normal(void);
+static void MakeTrace(uint64_t *beats, size_t n, uint64_t interval_ns,
+                                                const scenario_t *scenario);
+static size_t ReadTrace(const char *path, int pid, uint64_t *beats);
+static replay_t ReplayMisses(const uint64_t *beats, size_t n,
+                                        uint64_t interval_ns, int limit);
+static replay_t ReplayPhi(const uint64_t *beats, size_t n,
+                                    uint64_t interval_ns, double threshold);
+static void Report(const char *scenario, uint64_t **traces,
+                    const size_t *lengths, size_t count, uint64_t interval_ns);
+/******************************************************************************/
+int main(int argc, char *argv[])
+{
+    uint64_t interval_ns = (uint64_t)((1 < argc) ? atoi(argv[1]) :
+                                    DEFAULT_INTERVAL_MS) * MONO_NS_PER_MS;
+    uint64_t *traces[TRACES];
+    size_t lengths[TRACES];
+    size_t i = 0, s = 0;
+
+    if (0 == interval_ns)
+    {
+        return 1;
+    }
+
+    BenchPrintHeader(stdout);
+
+    for (i = 0; i < TRACES; ++i)
+    {
+        traces[i] = malloc(MAX_TRACE_BEATS * sizeof(uint64_t));
+        if (NULL == traces[i])
+        {
+            return 1;
+        }
+    }
+
+    for (s = 0; s < sizeof(scenarios) / sizeof(*scenarios); ++s)
+    {
+        for (i = 0; i < TRACES; ++i)
+        {
+            MakeTrace(traces[i], BEATS, interval_ns, &scenarios[s]);
+            lengths[i] = BEATS;
+        }
+        Report(scenarios[s].name, traces, lengths, TRACES, interval_ns);
+    }
+
+    if (2 < argc)
+    {
+        lengths[0] = ReadTrace(argv[2], (3 < argc) ? atoi(argv[3]) : 0,
+                                                                    traces[0]);
+        if (2 > lengths[0])
+        {
+            fprintf(stderr, "%s: no heartbeats sent\n", argv[2]);
+            return 1;
+        }
+        Report("trace", traces, lengths, 1, interval_ns);
+    }
+
+    for (i = 0; i < TRACES; ++i)
+    {
+        free(traces[i]);
+    }
+
+    return 0;
+}
+
+/******************************************************************************/
+static double Uniform(void)
+{
+    /* xorshift64 - the same traces on every run */
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+
+    /* the top 53 bits, over 2^53 */
+    return (double)(rng >> 11) / 9007199254740992.0;
+}
+
+
+static double Normal(void)
+{
+    double u = Uniform();
+
+    /* Box-Muller, the cosine half */
+    while (0 == u)
+    {
+        u = Uniform();
+    }
+
+    return sqrt(-2 * log(u)) * cos(2 * PI * Uniform());
+}
+
+
+static void MakeTrace(uint64_t *beats, size_t n, uint64_t interval_ns,
+                                                const scenario_t *scenario)
+{
+    double interval = (double)interval_ns;
+    uint64_t now = interval_ns;
+    size_t i = 0;
+
+    for (i = 0; i < n; ++i)
+    {
+        double gap = interval * (1 + scenario->stddev * Normal());
+
+        if (scenario->stalls && 0 == (size_t)(Uniform() * STALL_ONE_IN))
+        {
+            gap += interval * (1 + (int)(Uniform() * 4));
+        }
+
+        /* a heartbeat is not sent before the one before it */
+        now += (gap < interval / 100) ? interval_ns / 100 : (uint64_t)gap;
+        beats[i] = now;
+    }
+}
+
+
+static size_t ReadTrace(const char *path, int pid, uint64_t *beats)
+{
+    FILE *file = fopen(path, "r");
+    char line[256], event[32];
+    unsigned long time_ns = 0;
+    int line_pid = 0;
+    long value = 0;
+    size_t n = 0;
+
+    if (NULL == file)
+    {
+        return 0;
+    }
+
+    /* log,index,time_ns,pid,event,value */
+    while (n < MAX_TRACE_BEATS && NULL != fgets(line, sizeof(line), file))
+    {
+        if (4 != sscanf(line, "%*[^,],%*u,%lu,%d,%31[^,],%ld", &time_ns,
+                                                &line_pid, event, &value)
+                                            || 0 != strcmp(event, "sent"))
+        {
+            continue;
+        }
+        if (0 == pid)
+        {
+            pid = line_pid;
+        }
+        if (line_pid == pid && (0 == n || time_ns > beats[n - 1]))
+        {
+            beats[n++] = time_ns;
+        }
+    }
+    fclose(file);
+
+    return n;
+}
+
+
+static replay_t ReplayMisses(const uint64_t *beats, size_t n,
+                                        uint64_t interval_ns, int limit)
+{
+    replay_t replay = {0, 0};
+    uint64_t check = beats[0] + (uint64_t)(Uniform() * interval_ns);
+    size_t next = 1;
+    int misses = 0;
+
+    for (;; check += interval_ns)
+    {
+        int seen = 0;
+
+        while (next < n && beats[next] <= check)
+        {
+            ++next;
+            seen = 1;
+        }
+        if (seen)
+        {
+            misses = 0;
+            continue;
+        }
+        if (++misses < limit)
+        {
+            continue;
+        }
+
+        if (next == n)
+        {
+            replay.detect_ns = check - beats[n - 1];
+            return replay;
+        }
+        ++replay.false_positives;
+        misses = 0;
+    }
+}
+
+
+static replay_t ReplayPhi(const uint64_t *beats, size_t n,
+                                    uint64_t interval_ns, double threshold)
+{
+    replay_t replay = {0, 0};
+    uint64_t period = interval_ns / WD_PHI_CHECKS;
+    uint64_t check = beats[0] + (uint64_t)(Uniform() * period);
+    size_t next = 1;
+    wd_phi_t phi;
+
+    WdPhiInit(&phi, interval_ns, beats[0]);
+
+    for (;; check += period)
+    {
+        /* the signal transport - each heartbeat is seen as it arrives */
+        while (next < n && beats[next] <= check)
+        {
+            WdPhiBeat(&phi, beats[next]);
+            ++next;
+        }
+        if (WdPhi(&phi, check) < threshold)
+        {
+            continue;
+        }
+
+        if (next == n)
+        {
+            replay.detect_ns = check - beats[n - 1];
+            return replay;
+        }
+        ++replay.false_positives;
+        WdPhiRestart(&phi, check);
+    }
+}
+
+
+static void Report(const char *scenario, uint64_t **traces,
+                    const size_t *lengths, size_t count, uint64_t interval_ns)
+{
+    size_t d = 0, i = 0;
+    size_t detectors = sizeof(miss_limits) / sizeof(*miss_limits)
+                        + sizeof(phi_thresholds) / sizeof(*phi_thresholds);
+
+    for (d = 0; d < detectors; ++d)
+    {
+        int is_phi = (d >= sizeof(miss_limits) / sizeof(*miss_limits));
+        double level = is_phi ? phi_thresholds[d - sizeof(miss_limits)
+                            / sizeof(*miss_limits)] : (double)miss_limits[d];
+        size_t beats = 0, false_positives = 0;
+        uint64_t span_ns = 0, detect_sum = 0, detect_max = 0;
+        char name[64];
+
+        for (i = 0; i < count; ++i)
+        {
+            replay_t replay = is_phi
+                ? ReplayPhi(traces[i], lengths[i], interval_ns, level)
+                : ReplayMisses(traces[i], lengths[i], interval_ns,
+                                                                (int)level);
+
+            beats += lengths[i];
+            span_ns += traces[i][lengths[i] - 1] - traces[i][0];
+            false_positives += replay.false_positives;
+            detect_sum += replay.detect_ns;
+            if (replay.detect_ns > detect_max)
+            {
+                detect_max = replay.detect_ns;
+            }
+        }
+
+        sprintf(name, "%s_%s%g", scenario, is_phi ? "phi" : "miss_limit",
+                                                                    level);
+        BenchPrintValue(stdout, "wd_phi", name, beats, "detect",
+                                "false_positives", (double)false_positives);
+        BenchPrintValue(stdout, "wd_phi", name, beats, "detect",
+                "fp_per_hour", false_positives * NS_PER_HOUR / span_ns);
+        BenchPrintValue(stdout, "wd_phi", name, beats, "detect", "avg_ms",
+                            (double)detect_sum / count / MONO_NS_PER_MS);
+        BenchPrintValue(stdout, "wd_phi", name, beats, "detect", "max_ms",
+                                    (double)detect_max / MONO_NS_PER_MS);
+    }
+}
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog benchmark : cost of the progress slots (see
+ *              WatchDogProgressSlot)
+ *              - bump - WD_PROGRESS on the hot loop of a thread
+ *              - locked_add - an atomic increment of the counter instead
+ *                (lock xadd), for comparison
+ *              - check - WdProgressStalled, the heartbeat thread, with 1 and
+ *                WD_PROGRESS_SLOTS slots registered
+ *
+ * Infinity Labs OL108
+ *
+ * usage - wd_progress_bench [bumps] (default 100000000)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h)
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <stdio.h>    /* stdout */
+#include <stdlib.h>   /* atol() */
+
+#include "wd_progress.h"
+#include "bench_util.h"
+
+#define DEFAULT_BUMPS 100000000
+#define CHECKS 100000
+
+static void BenchCheck(bench_counters_t *counters, size_t slots);
+/******************************************************************************/
+int main(int argc, char *argv[])
+{
+    size_t bumps = (1 < argc) ? (size_t)atol(argv[1]) : DEFAULT_BUMPS;
+    bench_counters_t counters;
+    wd_progress_t *slot = WatchDogProgressSlot(1000);
+    size_t i = 0;
+
+    if (NULL == slot || 0 == bumps)
+    {
+        return 1;
+    }
+
+    BenchPrintHeader(stdout);
+    BenchOpen(&counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < bumps; ++i)
+    {
+        WD_PROGRESS(slot);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "wd_progress", "bump", 1, "bump", bumps, &counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < bumps; ++i)
+    {
+        __atomic_fetch_add(&slot->count, 1, __ATOMIC_RELAXED);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "wd_progress", "locked_add", 1, "bump", bumps,
+                                                                &counters);
+    WatchDogProgressRelease(slot);
+
+    BenchCheck(&counters, 1);
+    BenchCheck(&counters, WD_PROGRESS_SLOTS);
+
+    BenchClose(&counters);
+
+    return 0;
+}
+
+/******************************************************************************/
+static void BenchCheck(bench_counters_t *counters, size_t slots)
+{
+    wd_progress_t *registered[WD_PROGRESS_SLOTS];
+    size_t i = 0;
+
+    for (i = 0; i < slots; ++i)
+    {
+        registered[i] = WatchDogProgressSlot(1000);
+    }
+
+    /* the slots advance between the checks, as on a busy process */
+    BenchStart(counters);
+    for (i = 0; i < CHECKS; ++i)
+    {
+        WD_PROGRESS(registered[i % slots]);
+        WdProgressStalled();
+    }
+    BenchStop(counters);
+    BenchPrint(stdout, "wd_progress", "check", slots, "check", CHECKS,
+                                                                counters);
+
+    for (i = 0; i < slots; ++i)
+    {
+        WatchDogProgressRelease(registered[i]);
+    }
+}
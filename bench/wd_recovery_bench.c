@@ -0,0 +1,451 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog benchmark : failure detection and recovery latency.
+ *              The bench runs a user process (itself, in the user role) with
+ *              StartWatchDog, then kills the watchdog process or the user
+ *              process again and again - SIGKILL, SIGSEGV, or SIGSTOP for a
+ *              hang - and measures from the fault to
+ *              - detection - the replacement runs (a new watchdog forked or
+ *                a standby promoted, or the watchdog exec'd into a new user
+ *                process)
+ *              - recovery - the replacement passed the handshake and
+ *                the first heartbeat from the new watchdog arrived
+ *              and the CPU time the processes spent on the way.
+ *
+ * Infinity Labs OL108
+ *
+ * usage - wd_recovery_bench [watchdog path] [trials] [interval ms]
+ *                                                  [miss limit] [standby]
+ *         (default ./watchdog_process 10 20 5 0)
+ *         standby - 1 runs the pair with a standby watchdog
+ *         (watchdog_data_t)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h), a case per target and
+ *                fault, the size is the trials, the ops: detect, recover
+ *                (cpu - the replacement processes until recovery, and the
+ *                surviving process meanwhile - its watchdog thread when the
+ *                watchdog is the target)
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <errno.h>          /* errno, EINTR */
+#include <fcntl.h>          /* open(), O_WRONLY */
+#include <poll.h>           /* poll() */
+#include <pthread.h>        /* pthread_getcpuclockid() */
+#include <signal.h>         /* kill(), SIGKILL, SIGSEGV, SIGSTOP */
+#include <stdio.h>          /* sprintf(), fflush() */
+#include <stdlib.h>         /* getenv(), setenv(), atoi(), qsort() */
+#include <stdint.h>         /* uint64_t, int32_t */
+#include <string.h>         /* memset() */
+#include <time.h>           /* clock_gettime(), clock_getcpuclockid() */
+#include <unistd.h>         /* fork(), execv(), pipe(), read(), write() */
+#include <sys/prctl.h>      /* prctl(), PR_SET_CHILD_SUBREAPER */
+#include <sys/resource.h>   /* setrlimit(), RLIMIT_CORE */
+#include <sys/wait.h>       /* waitpid() */
+
+#include "mono_clock.h"
+#include "bench_util.h"
+#include "wd_shared_api.h"  /* LastHeartbeatNs() */
+#include "wd_user_process.h"
+
+#define DEFAULT_TRIALS 10
+#define DEFAULT_INTERVAL_MS 20
+#define DEFAULT_MISS_LIMIT 5
+#define MAX_TRIALS 1000
+#define POLL_NS (100 * MONO_NS_PER_US)
+#define TRIAL_TIMEOUT_MS 10000
+#define SETTLE_INTERVALS 10
+
+/* written by the user role when its watchdog or last heartbeat changes -
+   under PIPE_BUF, so whole */
+typedef struct
+{
+    int32_t pid;
+    int32_t wd_pid;
+    uint64_t started_ns;        /* main() of this user process */
+    uint64_t now_ns;
+    uint64_t last_hb_ns;        /* LastHeartbeatNs() */
+    uint64_t thread_cpu_ns;     /* of the watchdog thread */
+} record_t;
+
+typedef struct
+{
+    uint64_t detect_ns;
+    uint64_t recover_ns;
+    uint64_t cpu_ns;
+} trial_t;
+
+static int RunUser(char *argv[], char *envp[]);
+static void RunFaults(const char *target, const char *fault, int sig,
+                                                            size_t trials);
+static int Trial(int is_user_target, int sig, trial_t *trial);
+static int NextRecord(record_t *rec, int timeout_ms);
+static void WaitSteady(void);
+static void Report(const char *target, const char *fault, size_t n,
+                                                        const trial_t *trials);
+static double Percentile(uint64_t *values, size_t n, size_t pct);
+static uint64_t ProcessCpuNs(pid_t pid);
+static uint64_t ThreadCpuNs(pthread_t thread);
+static void Reap(void);
+static void Pause(uint64_t ns);
+static int NsCmp(const void *lhs, const void *rhs);
+
+static int records_fd = -1;
+static uint64_t interval_ns = 0;
+static record_t last;           /* the last record of the current pair */
+/******************************************************************************/
+int main(int argc, char *argv[], char *envp[])
+{
+    const char *watchdog_path = (1 < argc) ? argv[1] : "./watchdog_process";
+    size_t trials = (2 < argc) ? (size_t)atoi(argv[2]) : DEFAULT_TRIALS;
+    int interval_ms = (3 < argc) ? atoi(argv[3]) : DEFAULT_INTERVAL_MS;
+    int miss_limit = (4 < argc) ? atoi(argv[4]) : DEFAULT_MISS_LIMIT;
+    const char *standby = (5 < argc) ? argv[5] : "0";
+    struct rlimit no_core = {0, 0};
+    char buffer[32], self[4096];
+    int fds[2];
+    ssize_t len = 0;
+    pid_t pid = 0;
+
+    /* revived by the watchdog, in the user role */
+    if (NULL != getenv("WD_RECOVERY_FD"))
+    {
+        return RunUser(argv, envp);
+    }
+
+    len = readlink("/proc/self/exe", self, sizeof(self) - 1);
+    if (0 >= len || 0 == trials || MAX_TRIALS < trials || 0 >= interval_ms
+                                    || 0 >= miss_limit || 0 != pipe(fds))
+    {
+        return 1;
+    }
+    self[len] = '\0';
+    records_fd = fds[0];
+    interval_ns = (uint64_t)interval_ms * MONO_NS_PER_MS;
+
+    /* revived user processes are orphans - they are reaped here, and
+       SIGSEGV writes no core */
+    prctl(PR_SET_CHILD_SUBREAPER, 1);
+    setrlimit(RLIMIT_CORE, &no_core);
+
+    sprintf(buffer, "%d", fds[1]);
+    setenv("WD_RECOVERY_FD", buffer, 1);
+    setenv("WD_RECOVERY_WATCHDOG", watchdog_path, 1);
+    setenv("WD_RECOVERY_SELF", self, 1);
+    sprintf(buffer, "%d", interval_ms);
+    setenv("WD_RECOVERY_INTERVAL_MS", buffer, 1);
+    sprintf(buffer, "%d", miss_limit);
+    setenv("WD_RECOVERY_MISS_LIMIT", buffer, 1);
+    setenv("WD_RECOVERY_STANDBY", standby, 1);
+
+    pid = fork();
+    if (0 == pid)
+    {
+        /* the processes print every heartbeat */
+        int null_fd = open("/dev/null", O_WRONLY);
+
+        dup2(null_fd, STDOUT_FILENO);
+        execv(self, argv);
+        _exit(1);
+    }
+    close(fds[1]);
+    if (0 > pid)
+    {
+        return 1;
+    }
+
+    memset(&last, 0, sizeof(last));
+    WaitSteady();
+
+    BenchPrintHeader(stdout);
+    RunFaults("watchdog", "SIGKILL", SIGKILL, trials);
+    RunFaults("watchdog", "SIGSEGV", SIGSEGV, trials);
+    RunFaults("watchdog", "SIGSTOP", SIGSTOP, trials);
+    RunFaults("user", "SIGKILL", SIGKILL, trials);
+    RunFaults("user", "SIGSEGV", SIGSEGV, trials);
+    RunFaults("user", "SIGSTOP", SIGSTOP, trials);
+
+    /* the user process first - its watchdog would revive it */
+    kill(last.pid, SIGKILL);
+    kill(last.wd_pid, SIGKILL);
+    Pause(10 * interval_ns);
+    Reap();
+
+    return 0;
+}
+
+/******************************************************************************/
+static int RunUser(char *argv[], char *envp[])
+{
+    watchdog_data_t wd_data = {0};
+    record_t rec;
+    int fd = atoi(getenv("WD_RECOVERY_FD"));
+    pthread_t thread;
+
+    memset(&rec, 0, sizeof(rec));
+    rec.started_ns = MonoNowNs();
+    rec.pid = (int32_t)getpid();
+
+    wd_data.watchdog_path = getenv("WD_RECOVERY_WATCHDOG");
+    wd_data.process_path = getenv("WD_RECOVERY_SELF");
+    wd_data.argv = argv;
+    wd_data.envp = envp;
+    wd_data.signal_to_wd_interval_ms = atoi(getenv("WD_RECOVERY_INTERVAL_MS"));
+    wd_data.signal_from_wd_interval_ms = wd_data.signal_to_wd_interval_ms;
+    wd_data.signal_to_wd_miss_limit = atoi(getenv("WD_RECOVERY_MISS_LIMIT"));
+    wd_data.signal_from_wd_miss_limit = wd_data.signal_to_wd_miss_limit;
+    wd_data.standby = atoi(getenv("WD_RECOVERY_STANDBY"));
+
+    /* returns after the handshake */
+    thread = StartWatchDog(&wd_data);
+
+    for (;;)
+    {
+        int32_t wd_pid = (int32_t)WatchDogPid();
+        uint64_t last_hb = LastHeartbeatNs();
+
+        if (wd_pid != rec.wd_pid || last_hb != rec.last_hb_ns)
+        {
+            rec.wd_pid = wd_pid;
+            rec.last_hb_ns = last_hb;
+            rec.now_ns = MonoNowNs();
+            rec.thread_cpu_ns = ThreadCpuNs(thread);
+            if ((ssize_t)sizeof(rec) != write(fd, &rec, sizeof(rec)))
+            {
+                return 1;
+            }
+        }
+        Pause(POLL_NS);
+    }
+}
+
+
+static void RunFaults(const char *target, const char *fault, int sig,
+                                                                size_t trials)
+{
+    trial_t results[MAX_TRIALS];
+    size_t n = 0;
+
+    for (n = 0; n < trials; ++n)
+    {
+        if (0 != Trial(0 == strcmp("user", target), sig, &results[n]))
+        {
+            break;
+        }
+        WaitSteady();
+    }
+
+    Report(target, fault, n, results);
+}
+
+
+static int Trial(int is_user_target, int sig, trial_t *trial)
+{
+    record_t before = last, rec;
+    pid_t victim = is_user_target ? before.pid : before.wd_pid;
+    uint64_t cpu_before = is_user_target ? ProcessCpuNs(before.wd_pid)
+                                         : before.thread_cpu_ns;
+    uint64_t start = MonoNowNs();
+
+    memset(trial, 0, sizeof(trial_t));
+    kill(victim, sig);
+
+    while (0 == NextRecord(&rec, TRIAL_TIMEOUT_MS))
+    {
+        /* the watchdog exec'd the user process - same pid, a new one */
+        int is_new_user = is_user_target && rec.pid == before.wd_pid;
+        /* the user process forked a new watchdog */
+        int is_new_wd = !is_user_target && rec.pid == before.pid
+                                            && rec.wd_pid != before.wd_pid;
+
+        if (!is_new_user && !is_new_wd)
+        {
+            continue;
+        }
+
+        if (0 == trial->detect_ns)
+        {
+            trial->detect_ns = (is_new_user ? rec.started_ns : rec.now_ns)
+                                                                    - start;
+        }
+
+        /* a heartbeat of the new watchdog, after the handshake - the old
+           one sends none after the fault, and a promoted standby may beat
+           before the poll above saw it */
+        if (rec.last_hb_ns > start)
+        {
+            trial->recover_ns = rec.last_hb_ns - start;
+            if (trial->recover_ns < trial->detect_ns)
+            {
+                trial->recover_ns = trial->detect_ns;
+            }
+            trial->cpu_ns = ProcessCpuNs(rec.wd_pid) + (is_new_user
+                    ? ProcessCpuNs(rec.pid) - cpu_before
+                    : rec.thread_cpu_ns - cpu_before);
+            last = rec;
+
+            /* a hung process is left behind by its replacement */
+            if (SIGSTOP == sig)
+            {
+                kill(victim, SIGKILL);
+            }
+            Reap();
+
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+
+static int NextRecord(record_t *rec, int timeout_ms)
+{
+    struct pollfd pfd;
+
+    pfd.fd = records_fd;
+    pfd.events = POLLIN;
+
+    while (1)
+    {
+        int ready = poll(&pfd, 1, timeout_ms);
+
+        if (0 > ready && EINTR == errno)
+        {
+            continue;
+        }
+        if (1 != ready)
+        {
+            return -1;
+        }
+
+        return ((ssize_t)sizeof(record_t) == read(records_fd, rec,
+                                            sizeof(record_t))) ? 0 : -1;
+    }
+}
+
+
+static void WaitSteady(void)
+{
+    record_t rec;
+    int beats = 0;
+
+    /* heartbeats of the current pair, a few intervals long */
+    while (beats < SETTLE_INTERVALS && 0 == NextRecord(&rec, TRIAL_TIMEOUT_MS))
+    {
+        if (0 == last.pid || (rec.pid == last.pid && rec.wd_pid == last.wd_pid))
+        {
+            beats += (0 != rec.last_hb_ns && rec.last_hb_ns != last.last_hb_ns);
+            last = rec;
+        }
+    }
+}
+
+
+static void Report(const char *target, const char *fault, size_t n,
+                                                        const trial_t *trials)
+{
+    uint64_t detect[MAX_TRIALS], recover[MAX_TRIALS];
+    double cpu = 0;
+    char name[64];
+    size_t i = 0;
+
+    for (i = 0; i < n; ++i)
+    {
+        detect[i] = trials[i].detect_ns;
+        recover[i] = trials[i].recover_ns;
+        cpu += (double)trials[i].cpu_ns;
+    }
+
+    sprintf(name, "%s_%s", target, fault);
+    BenchPrintValue(stdout, "wd_recovery", name, n, "detect", "p50_ms",
+                                                Percentile(detect, n, 50));
+    BenchPrintValue(stdout, "wd_recovery", name, n, "detect", "p99_ms",
+                                                Percentile(detect, n, 99));
+    BenchPrintValue(stdout, "wd_recovery", name, n, "detect", "max_ms",
+                                                Percentile(detect, n, 100));
+    BenchPrintValue(stdout, "wd_recovery", name, n, "recover", "p50_ms",
+                                                Percentile(recover, n, 50));
+    BenchPrintValue(stdout, "wd_recovery", name, n, "recover", "p99_ms",
+                                                Percentile(recover, n, 99));
+    BenchPrintValue(stdout, "wd_recovery", name, n, "recover", "max_ms",
+                                                Percentile(recover, n, 100));
+    BenchPrintValue(stdout, "wd_recovery", name, n, "recover", "cpu_avg_ms",
+                                            (0 < n) ? cpu / n / 1e6 : 0.0);
+    fflush(stdout);
+}
+
+
+static double Percentile(uint64_t *values, size_t n, size_t pct)
+{
+    size_t at = 0;
+
+    if (0 == n)
+    {
+        return 0.0;
+    }
+
+    qsort(values, n, sizeof(uint64_t), NsCmp);
+    at = (n * pct) / 100;
+
+    return values[(at < n) ? at : n - 1] / 1e6;
+}
+
+
+static uint64_t ProcessCpuNs(pid_t pid)
+{
+    clockid_t clock;
+    struct timespec ts;
+
+    if (0 != clock_getcpuclockid(pid, &clock)
+                                        || 0 != clock_gettime(clock, &ts))
+    {
+        return 0;
+    }
+
+    return (uint64_t)ts.tv_sec * MONO_NS_PER_SEC + (uint64_t)ts.tv_nsec;
+}
+
+
+static uint64_t ThreadCpuNs(pthread_t thread)
+{
+    clockid_t clock;
+    struct timespec ts;
+
+    if (0 != pthread_getcpuclockid(thread, &clock)
+                                        || 0 != clock_gettime(clock, &ts))
+    {
+        return 0;
+    }
+
+    return (uint64_t)ts.tv_sec * MONO_NS_PER_SEC + (uint64_t)ts.tv_nsec;
+}
+
+
+static void Reap(void)
+{
+    while (0 < waitpid(-1, NULL, WNOHANG))
+    {
+        /* exited processes of earlier trials */
+    }
+}
+
+
+static void Pause(uint64_t ns)
+{
+    struct timespec ts;
+
+    ts.tv_sec = (time_t)(ns / MONO_NS_PER_SEC);
+    ts.tv_nsec = (long)(ns % MONO_NS_PER_SEC);
+    nanosleep(&ts, NULL);
+}
+
+
+static int NsCmp(const void *lhs, const void *rhs)
+{
+    uint64_t left = *(const uint64_t *)lhs;
+    uint64_t right = *(const uint64_t *)rhs;
+
+    return (left > right) - (left < right);
+}
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog benchmark : time from the death (SIGKILL, seen
+ *              through a pidfd) or the hang (SIGSTOP, seen through missed
+ *              heartbeats) of the watchdog process to the fork of its
+ *              replacement
+ *
+ * Infinity Labs OL108
+ *
+ * usage - wd_respawn_bench [watchdog path] [events]
+ *         (default ./watchdog_process 20)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h), the size is the
+ *                events, the op: respawn (at INTERVAL_MS and MISS_LIMIT)
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <signal.h>     /* kill(), SIGKILL, SIGSTOP */
+#include <stdio.h>      /* freopen(), fdopen(), fflush() */
+#include <stdlib.h>     /* atol(), qsort() */
+#include <stdint.h>     /* uint64_t */
+#include <time.h>       /* nanosleep() */
+#include <unistd.h>     /* dup() */
+#include <sys/wait.h>   /* waitpid() */
+
+#include "mono_clock.h"
+#include "bench_util.h"
+#include "wd_user_process.h"
+
+#define DEFAULT_EVENTS 20
+#define MAX_EVENTS 1000
+#define INTERVAL_MS 10
+#define MISS_LIMIT 5
+#define SETTLE_NS (200 * MONO_NS_PER_MS)
+#define GIVE_UP_NS (5 * MONO_NS_PER_SEC)
+
+static void RunCase(FILE *csv, const char *name, int sig, size_t events);
+static void Pause(uint64_t ns);
+static int RespawnCmp(const void *lhs, const void *rhs);
+/******************************************************************************/
+int main(int argc, char *argv[], char *envp[])
+{
+    watchdog_data_t wd_data = {0};
+    size_t events = (2 < argc) ? (size_t)atol(argv[2]) : DEFAULT_EVENTS;
+    FILE *csv = fdopen(dup(1), "w");
+    pthread_t thread;
+
+    if (NULL == csv || 0 == events || MAX_EVENTS < events)
+    {
+        return 1;
+    }
+
+    /* the watchdog and its thread print every heartbeat */
+    if (NULL == freopen("/dev/null", "w", stdout))
+    {
+        return 1;
+    }
+
+    wd_data.watchdog_path = (1 < argc) ? argv[1] : "./watchdog_process";
+    wd_data.process_path = argv[0];
+    wd_data.argv = argv;
+    wd_data.envp = envp;
+    wd_data.signal_to_wd_interval_ms = INTERVAL_MS;
+    wd_data.signal_from_wd_interval_ms = INTERVAL_MS;
+    wd_data.signal_to_wd_miss_limit = MISS_LIMIT;
+    wd_data.signal_from_wd_miss_limit = MISS_LIMIT;
+
+    thread = StartWatchDog(&wd_data);
+    Pause(SETTLE_NS);
+
+    BenchPrintHeader(csv);
+    RunCase(csv, "exit_pidfd", SIGKILL, events);
+    RunCase(csv, "hang_misses", SIGSTOP, events);
+    fflush(csv);
+
+    EndWatchDog(thread);
+
+    return 0;
+}
+
+/******************************************************************************/
+static void RunCase(FILE *csv, const char *name, int sig, size_t events)
+{
+    uint64_t respawns[MAX_EVENTS];
+    double sum = 0;
+    size_t i = 0, n = 0;
+
+    for (i = 0; i < events; ++i)
+    {
+        pid_t old = WatchDogPid();
+        uint64_t start = MonoNowNs();
+
+        kill(old, sig);
+        while (old == WatchDogPid() && MonoNowNs() - start < GIVE_UP_NS)
+        {
+            Pause(50 * MONO_NS_PER_US);
+        }
+        if (old == WatchDogPid())
+        {
+            break;
+        }
+
+        respawns[n] = MonoNowNs() - start;
+        sum += (double)respawns[n++];
+
+        /* a hung watchdog is left behind by its replacement */
+        if (SIGSTOP == sig)
+        {
+            kill(old, SIGKILL);
+            waitpid(old, NULL, 0);
+        }
+        Pause(SETTLE_NS);
+    }
+
+    qsort(respawns, n, sizeof(uint64_t), RespawnCmp);
+
+    BenchPrintValue(csv, "wd_respawn", name, n, "respawn", "avg_ms",
+                                            (0 < n) ? sum / n / 1e6 : 0.0);
+    BenchPrintValue(csv, "wd_respawn", name, n, "respawn", "p99_ms",
+                            (0 < n) ? respawns[n * 99 / 100] / 1e6 : 0.0);
+}
+
+
+static void Pause(uint64_t ns)
+{
+    struct timespec ts;
+
+    ts.tv_sec = (time_t)(ns / MONO_NS_PER_SEC);
+    ts.tv_nsec = (long)(ns % MONO_NS_PER_SEC);
+    nanosleep(&ts, NULL);
+}
+
+
+static int RespawnCmp(const void *lhs, const void *rhs)
+{
+    uint64_t left = *(const uint64_t *)lhs;
+    uint64_t right = *(const uint64_t *)rhs;
+
+    return (left > right) - (left < right);
+}
@@ -0,0 +1,269 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog benchmark : parallel startup - 1, 10, 100... user
+ *              processes released at once, each calls StartWatchDog (a fork,
+ *              an exec of the watchdog process and the handshake of the
+ *              pair), from the release to each StartWatchDog returning.
+ *              The pairs run until all started (or the timeout), then end
+ *              with EndWatchDog.
+ *
+ * Infinity Labs OL108
+ *
+ * usage - wd_startup_bench [watchdog path] [max processes]
+ *         (default ./watchdog_process 500)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h), the size is the
+ *                processes, the op: start (started - the pairs that started
+ *                within TIMEOUT_MS, wall - until the last of them)
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <errno.h>          /* errno, EINTR */
+#include <fcntl.h>          /* open(), O_WRONLY */
+#include <poll.h>           /* poll() */
+#include <signal.h>         /* kill(), SIGKILL */
+#include <stdio.h>          /* stdout, fflush() */
+#include <stdlib.h>         /* getenv(), setenv(), atoi(), malloc(), qsort() */
+#include <stdint.h>         /* uint64_t, int32_t */
+#include <unistd.h>         /* fork(), pipe(), read(), pause(), setpgid() */
+#include <sys/prctl.h>      /* prctl(), PR_SET_CHILD_SUBREAPER */
+#include <sys/wait.h>       /* waitpid() */
+
+#include "mono_clock.h"
+#include "bench_util.h"
+#include "wd_user_process.h"
+
+#define DEFAULT_MAX 500
+#define MAX_PROCESSES 4096
+#define TIMEOUT_MS 30000
+#define END_WAIT_MS 5000
+#define INTERVAL_MS 1000        /* no miss while hundreds start */
+#define MISS_LIMIT 5
+
+/* written by a user process once StartWatchDog returned - under PIPE_BUF */
+typedef struct
+{
+    int32_t pid;
+    int32_t is_started;
+    uint64_t done_ns;
+} record_t;
+
+static void RunStartup(size_t n);
+static void RunUser(int release_fd, int end_fd, int records_fd);
+static double Percentile(uint64_t *values, size_t n, size_t pct);
+static int NsCmp(const void *lhs, const void *rhs);
+
+static const char *watchdog_path = "./watchdog_process";
+static char self[4096];
+static char **self_argv = NULL;
+/******************************************************************************/
+int main(int argc, char *argv[])
+{
+    size_t max = (2 < argc) ? (size_t)atoi(argv[2]) : DEFAULT_MAX;
+    ssize_t len = readlink("/proc/self/exe", self, sizeof(self) - 1);
+    size_t n = 0;
+
+    /* revived by its watchdog process - it is not the bench again, it waits
+       to be killed with its group */
+    if (NULL != getenv("WD_STARTUP_BENCH_USER"))
+    {
+        for (;;)
+        {
+            pause();
+        }
+    }
+
+    watchdog_path = (1 < argc) ? argv[1] : watchdog_path;
+    self_argv = argv;
+    if (0 >= len || 0 == max || MAX_PROCESSES < max)
+    {
+        return 1;
+    }
+    self[len] = '\0';
+
+    /* the watchdog processes of exited user processes are reaped here */
+    prctl(PR_SET_CHILD_SUBREAPER, 1);
+
+    BenchPrintHeader(stdout);
+    for (n = 1; n < max; n *= 10)
+    {
+        RunStartup(n);
+    }
+    RunStartup(max);
+
+    return 0;
+}
+
+/******************************************************************************/
+static void RunStartup(size_t n)
+{
+    int release[2], end[2], records[2];
+    pid_t *pids = (pid_t *)malloc(n * sizeof(pid_t));
+    uint64_t *startup = (uint64_t *)malloc(n * sizeof(uint64_t));
+    uint64_t released = 0, deadline = 0, last = 0;
+    size_t started = 0, reported = 0, i = 0;
+    record_t rec;
+
+    if (NULL == pids || NULL == startup || 0 != pipe(release)
+                                || 0 != pipe(end) || 0 != pipe(records))
+    {
+        free(pids);
+        free(startup);
+        return;
+    }
+
+    for (i = 0; i < n; ++i)
+    {
+        pids[i] = fork();
+        if (0 == pids[i])
+        {
+            close(release[1]);
+            close(end[1]);
+            close(records[0]);
+            RunUser(release[0], end[0], records[1]);
+        }
+    }
+    close(release[0]);
+    close(end[0]);
+    close(records[1]);
+
+    /* the end of file of the pipe releases them all at once */
+    released = MonoNowNs();
+    close(release[1]);
+
+    deadline = released + (uint64_t)TIMEOUT_MS * MONO_NS_PER_MS;
+    while (reported < n)
+    {
+        struct pollfd pfd;
+        uint64_t now = MonoNowNs();
+        int ready = 0;
+
+        pfd.fd = records[0];
+        pfd.events = POLLIN;
+        ready = (now < deadline)
+                ? poll(&pfd, 1, (int)((deadline - now) / MONO_NS_PER_MS)) : 0;
+        if (0 > ready && EINTR == errno)
+        {
+            continue;
+        }
+        if (1 != ready || (ssize_t)sizeof(rec) != read(records[0], &rec,
+                                                                sizeof(rec)))
+        {
+            break;
+        }
+
+        ++reported;
+        if (rec.is_started)
+        {
+            startup[started++] = rec.done_ns - released;
+            last = (rec.done_ns > last) ? rec.done_ns : last;
+        }
+    }
+
+    /* EndWatchDog in each, a pair that hangs is killed with its group */
+    close(end[1]);
+    deadline = MonoNowNs() + (uint64_t)END_WAIT_MS * MONO_NS_PER_MS;
+    for (i = 0; i < n; ++i)
+    {
+        while (0 == waitpid(pids[i], NULL, WNOHANG) && MonoNowNs() < deadline)
+        {
+            usleep(1000);
+        }
+        if (0 < pids[i])
+        {
+            kill(-pids[i], SIGKILL);
+            waitpid(pids[i], NULL, WNOHANG);
+        }
+    }
+    while (0 < waitpid(-1, NULL, WNOHANG))
+    {
+        /* the watchdog processes */
+    }
+    close(records[0]);
+
+    BenchPrintValue(stdout, "wd_startup", "parallel", n, "start", "started",
+                                                            (double)started);
+    BenchPrintValue(stdout, "wd_startup", "parallel", n, "start", "p50_ms",
+                                            Percentile(startup, started, 50));
+    BenchPrintValue(stdout, "wd_startup", "parallel", n, "start", "p99_ms",
+                                            Percentile(startup, started, 99));
+    BenchPrintValue(stdout, "wd_startup", "parallel", n, "start", "max_ms",
+                                            Percentile(startup, started, 100));
+    BenchPrintValue(stdout, "wd_startup", "parallel", n, "start", "wall_ms",
+                            (0 != last) ? (last - released) / 1e6 : 0.0);
+    fflush(stdout);
+
+    free(pids);
+    free(startup);
+}
+
+
+static void RunUser(int release_fd, int end_fd, int records_fd)
+{
+    watchdog_data_t wd_data = {0};
+    record_t rec;
+    pthread_t thread;
+    char byte = 0;
+    int null_fd = open("/dev/null", O_WRONLY);
+
+    /* a group of its own with its watchdog process, killed together */
+    setpgid(0, 0);
+    dup2(null_fd, STDOUT_FILENO);
+    setenv("WD_STARTUP_BENCH_USER", "1", 1);
+
+    wd_data.watchdog_path = watchdog_path;
+    wd_data.process_path = self;
+    wd_data.argv = self_argv;
+    wd_data.signal_to_wd_interval_ms = INTERVAL_MS;
+    wd_data.signal_from_wd_interval_ms = INTERVAL_MS;
+    wd_data.signal_to_wd_miss_limit = MISS_LIMIT;
+    wd_data.signal_from_wd_miss_limit = MISS_LIMIT;
+
+    while (0 != read(release_fd, &byte, 1) && EINTR == errno)
+    {
+    }
+
+    thread = StartWatchDog(&wd_data);
+    rec.done_ns = MonoNowNs();
+    rec.pid = (int32_t)getpid();
+    rec.is_started = ((pthread_t)-1 != thread);
+    if ((ssize_t)sizeof(rec) != write(records_fd, &rec, sizeof(rec)))
+    {
+        _exit(1);
+    }
+
+    while (0 != read(end_fd, &byte, 1) && EINTR == errno)
+    {
+    }
+    if (rec.is_started)
+    {
+        EndWatchDog(thread);
+    }
+
+    _exit(0);
+}
+
+
+static double Percentile(uint64_t *values, size_t n, size_t pct)
+{
+    size_t at = 0;
+
+    if (0 == n)
+    {
+        return 0.0;
+    }
+
+    qsort(values, n, sizeof(uint64_t), NsCmp);
+    at = (n * pct) / 100;
+
+    return values[(at < n) ? at : n - 1] / 1e6;
+}
+
+
+static int NsCmp(const void *lhs, const void *rhs)
+{
+    uint64_t l = *(const uint64_t *)lhs, r = *(const uint64_t *)rhs;
+
+    return (l > r) - (l < r);
+}
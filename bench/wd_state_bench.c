@@ -0,0 +1,162 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog benchmark : cost of handing the configuration of a
+ *              pair to the next process, the state file (wd_state.h) against
+ *              the environment variables it replaced
+ *              - env - setenv() of each field printed (the user process
+ *                before its exec), getenv() and atoi() of each (the watchdog
+ *                process after it)
+ *              - state - WdStateSetConfig, then WdStateOpen, WdStateGetConfig
+ *                and WdStateClose (an mmap and a munmap)
+ *              - state_mapped - WdStateGetConfig alone, the state mapped
+ *
+ * Infinity Labs OL108
+ *
+ * usage - wd_state_bench [handoffs] (default 100000)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h)
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <stdio.h>    /* stdout, sprintf() */
+#include <stdlib.h>   /* setenv(), getenv(), atol(), atoi(), strtoul() */
+#include <unistd.h>   /* close() */
+
+#include "wd_state.h"
+#include "bench_util.h"
+
+#define DEFAULT_HANDOFFS 100000
+
+static void SetEnv(const watchdog_data_t *wd);
+static void GetEnv(watchdog_data_t *wd);
+/******************************************************************************/
+int main(int argc, char *argv[])
+{
+    size_t handoffs = (1 < argc) ? (size_t)atol(argv[1]) : DEFAULT_HANDOFFS;
+    bench_counters_t counters;
+    watchdog_data_t wd = {0}, got = {0};
+    wd_state_t *state = NULL;
+    int fd = -1;
+    size_t i = 0;
+
+    wd.watchdog_path = "/usr/local/bin/watchdog_process";
+    wd.process_path = "/usr/local/bin/service";
+    wd.signal_to_wd_interval = 1;
+    wd.signal_from_wd_interval = 1;
+    wd.signal_to_wd_miss_limit = 5;
+    wd.signal_from_wd_miss_limit = 5;
+    wd.signal_to_wd_interval_ms = 20;
+    wd.signal_from_wd_interval_ms = 20;
+
+    state = WdStateCreate(&fd);
+    if (NULL == state || 0 == handoffs)
+    {
+        return 1;
+    }
+
+    BenchPrintHeader(stdout);
+    BenchOpen(&counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < handoffs; ++i)
+    {
+        SetEnv(&wd);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "wd_state", "env", 1, "handoff_write", handoffs,
+                                                                &counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < handoffs; ++i)
+    {
+        GetEnv(&got);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "wd_state", "env", 1, "handoff_read", handoffs,
+                                                                &counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < handoffs; ++i)
+    {
+        WdStateSetConfig(state, &wd, -1);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "wd_state", "state", 1, "handoff_write", handoffs,
+                                                                &counters);
+
+    /* a new process maps the file first */
+    BenchStart(&counters);
+    for (i = 0; i < handoffs; ++i)
+    {
+        wd_state_t *mapped = WdStateOpen(fd);
+
+        WdStateGetConfig(mapped, &got);
+        WdStateClose(mapped);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "wd_state", "state", 1, "handoff_read", handoffs,
+                                                                &counters);
+
+    BenchStart(&counters);
+    for (i = 0; i < handoffs; ++i)
+    {
+        WdStateGetConfig(state, &got);
+    }
+    BenchStop(&counters);
+    BenchPrint(stdout, "wd_state", "state_mapped", 1, "handoff_read",
+                                                    handoffs, &counters);
+
+    BenchClose(&counters);
+    WdStateClose(state);
+    close(fd);
+
+    return (got.signal_to_wd_miss_limit == wd.signal_to_wd_miss_limit) ? 0 : 1;
+}
+
+/******************************************************************************/
+static void SetEnv(const watchdog_data_t *wd)
+{
+    char buffer[20];
+
+    setenv("watchdog_path", wd->watchdog_path, 1);
+    setenv("process_path", wd->process_path, 1);
+    sprintf(buffer, "%ld", wd->signal_to_wd_interval);
+    setenv("signal_to_wd_interval", buffer, 1);
+    sprintf(buffer, "%ld", wd->signal_from_wd_interval);
+    setenv("signal_from_wd_interval", buffer, 1);
+    sprintf(buffer, "%d", wd->signal_to_wd_miss_limit);
+    setenv("signal_to_wd_miss_limit", buffer, 1);
+    sprintf(buffer, "%d", wd->signal_from_wd_miss_limit);
+    setenv("signal_from_wd_miss_limit", buffer, 1);
+    sprintf(buffer, "%lu", wd->signal_to_wd_interval_ms);
+    setenv("signal_to_wd_interval_ms", buffer, 1);
+    sprintf(buffer, "%lu", wd->signal_from_wd_interval_ms);
+    setenv("signal_from_wd_interval_ms", buffer, 1);
+    sprintf(buffer, "%lu", wd->signal_to_wd_interval_us);
+    setenv("signal_to_wd_interval_us", buffer, 1);
+    sprintf(buffer, "%lu", wd->signal_from_wd_interval_us);
+    setenv("signal_from_wd_interval_us", buffer, 1);
+    sprintf(buffer, "%d", (int)wd->transport);
+    setenv("transport", buffer, 1);
+}
+
+
+static void GetEnv(watchdog_data_t *wd)
+{
+    wd->watchdog_path = getenv("watchdog_path");
+    wd->process_path = getenv("process_path");
+    wd->signal_to_wd_interval = atol(getenv("signal_to_wd_interval"));
+    wd->signal_from_wd_interval = atol(getenv("signal_from_wd_interval"));
+    wd->signal_to_wd_miss_limit = atoi(getenv("signal_to_wd_miss_limit"));
+    wd->signal_from_wd_miss_limit = atoi(getenv("signal_from_wd_miss_limit"));
+    wd->signal_to_wd_interval_ms = strtoul(getenv("signal_to_wd_interval_ms"),
+                                                                    NULL, 10);
+    wd->signal_from_wd_interval_ms = strtoul(
+                            getenv("signal_from_wd_interval_ms"), NULL, 10);
+    wd->signal_to_wd_interval_us = strtoul(getenv("signal_to_wd_interval_us"),
+                                                                    NULL, 10);
+    wd->signal_from_wd_interval_us = strtoul(
+                            getenv("signal_from_wd_interval_us"), NULL, 10);
+    wd->transport = (wd_transport_t)atoi(getenv("transport"));
+}
@@ -0,0 +1,326 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog benchmark : time to ready of a revived user process,
+ *              started over by exec against forked from its zygote
+ *              (WatchDogReady).
+ *              The bench runs a user process (itself, in the user role) that
+ *              initializes - init MB of memory touched, then work until init
+ *              ms passed, as a service parsing its configuration and warming
+ *              its caches - and kills it again and again, from the SIGKILL to
+ *              the replacement being initialized.
+ *              - exec - the watchdog exec's process_path, which initializes
+ *              - zygote - the user process calls WatchDogReady after its
+ *                initialization, the replacement is forked ready
+ *
+ * Infinity Labs OL108
+ *
+ * usage - wd_zygote_bench [watchdog path] [trials] [init ms] [init MB]
+ *         (default ./watchdog_process 20 50 64)
+ * output (CSV) - see BENCH_CSV_HEADER (bench_util.h), a case per mode, the
+ *                size is the trials, the op: ready
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <errno.h>          /* errno, EINTR */
+#include <fcntl.h>          /* open(), O_WRONLY */
+#include <poll.h>           /* poll() */
+#include <signal.h>         /* kill(), SIGKILL, SIGSTOP */
+#include <stdio.h>          /* sprintf(), fflush() */
+#include <stdlib.h>         /* getenv(), setenv(), atoi(), malloc(), qsort() */
+#include <stdint.h>         /* uint64_t, int32_t */
+#include <string.h>         /* memset(), strcmp() */
+#include <time.h>           /* nanosleep() */
+#include <unistd.h>         /* fork(), execv(), pipe(), read(), write() */
+#include <sys/prctl.h>      /* prctl(), PR_SET_CHILD_SUBREAPER */
+#include <sys/wait.h>       /* waitpid() */
+
+#include "mono_clock.h"
+#include "bench_util.h"
+#include "wd_user_process.h"
+
+#define DEFAULT_TRIALS 20
+#define DEFAULT_INIT_MS 50
+#define DEFAULT_INIT_MB 64
+#define MAX_TRIALS 1000
+#define INTERVAL_MS 20
+#define MISS_LIMIT 5
+#define PAGE 4096
+#define TRIAL_TIMEOUT_MS 10000
+#define SETTLE_MS 200
+
+/* written by the user role once it is initialized - under PIPE_BUF */
+typedef struct
+{
+    int32_t pid;
+    int32_t wd_pid;
+    uint64_t ready_ns;
+} record_t;
+
+static int RunUser(char *argv[], char *envp[]);
+static void Init(int init_ms, int init_mb);
+static void RunMode(const char *mode, const char *self, char *argv[],
+                                                                size_t trials);
+static int NextRecord(record_t *rec, int timeout_ms);
+static double Percentile(uint64_t *values, size_t n, size_t pct);
+static void Pause(uint64_t ns);
+static int NsCmp(const void *lhs, const void *rhs);
+
+static int records_fd = -1;
+static int init_ms = DEFAULT_INIT_MS;
+static int init_mb = DEFAULT_INIT_MB;
+static volatile char *warm = NULL;     /* kept - the caches of the service */
+/******************************************************************************/
+int main(int argc, char *argv[], char *envp[])
+{
+    const char *watchdog_path = (1 < argc) ? argv[1] : "./watchdog_process";
+    size_t trials = (2 < argc) ? (size_t)atoi(argv[2]) : DEFAULT_TRIALS;
+    char buffer[32], self[4096];
+    ssize_t len = 0;
+
+    /* revived by the watchdog or forked by the zygote, in the user role */
+    if (NULL != getenv("WD_ZYGOTE_BENCH_FD"))
+    {
+        return RunUser(argv, envp);
+    }
+
+    init_ms = (3 < argc) ? atoi(argv[3]) : DEFAULT_INIT_MS;
+    init_mb = (4 < argc) ? atoi(argv[4]) : DEFAULT_INIT_MB;
+    len = readlink("/proc/self/exe", self, sizeof(self) - 1);
+    if (0 >= len || 0 == trials || MAX_TRIALS < trials || 0 > init_ms
+                                                            || 0 > init_mb)
+    {
+        return 1;
+    }
+    self[len] = '\0';
+
+    /* revived user processes and zygotes are orphans - reaped here */
+    prctl(PR_SET_CHILD_SUBREAPER, 1);
+
+    setenv("WD_ZYGOTE_BENCH_WATCHDOG", watchdog_path, 1);
+    setenv("WD_ZYGOTE_BENCH_SELF", self, 1);
+    sprintf(buffer, "%d", init_ms);
+    setenv("WD_ZYGOTE_BENCH_INIT_MS", buffer, 1);
+    sprintf(buffer, "%d", init_mb);
+    setenv("WD_ZYGOTE_BENCH_INIT_MB", buffer, 1);
+
+    BenchPrintHeader(stdout);
+    RunMode("exec", self, argv, trials);
+    RunMode("zygote", self, argv, trials);
+
+    return 0;
+}
+
+/******************************************************************************/
+static int RunUser(char *argv[], char *envp[])
+{
+    watchdog_data_t wd_data = {0};
+    record_t rec;
+    int fd = atoi(getenv("WD_ZYGOTE_BENCH_FD"));
+    pthread_t thread;
+
+    wd_data.watchdog_path = getenv("WD_ZYGOTE_BENCH_WATCHDOG");
+    wd_data.process_path = getenv("WD_ZYGOTE_BENCH_SELF");
+    wd_data.argv = argv;
+    wd_data.envp = envp;
+    wd_data.signal_to_wd_interval_ms = INTERVAL_MS;
+    wd_data.signal_from_wd_interval_ms = INTERVAL_MS;
+    wd_data.signal_to_wd_miss_limit = MISS_LIMIT;
+    wd_data.signal_from_wd_miss_limit = MISS_LIMIT;
+
+    thread = StartWatchDog(&wd_data);
+    Init(atoi(getenv("WD_ZYGOTE_BENCH_INIT_MS")),
+                                    atoi(getenv("WD_ZYGOTE_BENCH_INIT_MB")));
+
+    /* a process forked by the zygote returns here, initialized */
+    if (0 == strcmp("zygote", getenv("WD_ZYGOTE_BENCH_MODE")))
+    {
+        thread = WatchDogReady(thread);
+    }
+    (void)thread;
+
+    memset(&rec, 0, sizeof(rec));
+    rec.pid = (int32_t)getpid();
+    rec.wd_pid = (int32_t)WatchDogPid();
+    rec.ready_ns = MonoNowNs();
+    if ((ssize_t)sizeof(rec) != write(fd, &rec, sizeof(rec)))
+    {
+        return 1;
+    }
+
+    /* killed by the bench */
+    for (;;)
+    {
+        Pause(MONO_NS_PER_SEC);
+    }
+}
+
+
+static void Init(int ms, int mb)
+{
+    uint64_t end = MonoNowNs() + (uint64_t)ms * MONO_NS_PER_MS;
+    size_t size = (size_t)mb << 20;
+    size_t i = 0;
+    uint64_t work = 0;
+
+    warm = (volatile char *)malloc(size);
+    for (i = 0; NULL != warm && i < size; i += PAGE)
+    {
+        warm[i] = (char)i;
+    }
+
+    while (MonoNowNs() < end)
+    {
+        for (i = 0; i < 1000; ++i)
+        {
+            work = work * 6364136223846793005ul + 1442695040888963407ul;
+        }
+    }
+    if (NULL != warm && 0 < size)
+    {
+        warm[0] = (char)work;
+    }
+}
+
+
+static void RunMode(const char *mode, const char *self, char *argv[],
+                                                                size_t trials)
+{
+    uint64_t ready[MAX_TRIALS];
+    record_t last, rec;
+    char buffer[32];
+    int fds[2];
+    size_t n = 0;
+    pid_t pid = 0;
+
+    if (0 != pipe(fds))
+    {
+        return;
+    }
+    records_fd = fds[0];
+    sprintf(buffer, "%d", fds[1]);
+    setenv("WD_ZYGOTE_BENCH_FD", buffer, 1);
+    setenv("WD_ZYGOTE_BENCH_MODE", mode, 1);
+
+    pid = fork();
+    if (0 == pid)
+    {
+        /* the processes print every heartbeat */
+        int null_fd = open("/dev/null", O_WRONLY);
+
+        close(fds[0]);
+        dup2(null_fd, STDOUT_FILENO);
+        execv(self, argv);
+        _exit(1);
+    }
+    close(fds[1]);
+    unsetenv("WD_ZYGOTE_BENCH_FD");
+
+    if (0 < pid && 0 == NextRecord(&last, TRIAL_TIMEOUT_MS))
+    {
+        for (n = 0; n < trials; ++n)
+        {
+            uint64_t start = 0;
+
+            Pause((uint64_t)SETTLE_MS * MONO_NS_PER_MS);
+            start = MonoNowNs();
+            kill(last.pid, SIGKILL);
+
+            /* the next user process, initialized */
+            while (0 == NextRecord(&rec, TRIAL_TIMEOUT_MS)
+                                                    && rec.pid == last.pid)
+            {
+            }
+            if (rec.pid == last.pid)
+            {
+                break;
+            }
+            ready[n] = rec.ready_ns - start;
+            last = rec;
+            while (0 < waitpid(-1, NULL, WNOHANG))
+            {
+                /* the killed processes */
+            }
+        }
+
+        /* the watchdog stopped first, it would revive the user process */
+        kill(last.wd_pid, SIGSTOP);
+        kill(last.pid, SIGKILL);
+        kill(last.wd_pid, SIGKILL);
+    }
+    close(fds[0]);
+
+    /* a zygote exits shortly after its user process */
+    while (0 < waitpid(-1, NULL, 0))
+    {
+    }
+
+    BenchPrintValue(stdout, "wd_zygote", mode, n, "ready", "p50_ms",
+                                                    Percentile(ready, n, 50));
+    BenchPrintValue(stdout, "wd_zygote", mode, n, "ready", "p99_ms",
+                                                    Percentile(ready, n, 99));
+    BenchPrintValue(stdout, "wd_zygote", mode, n, "ready", "max_ms",
+                                                    Percentile(ready, n, 100));
+    fflush(stdout);
+}
+
+
+static int NextRecord(record_t *rec, int timeout_ms)
+{
+    struct pollfd pfd;
+
+    pfd.fd = records_fd;
+    pfd.events = POLLIN;
+
+    while (1)
+    {
+        int ready = poll(&pfd, 1, timeout_ms);
+
+        if (0 > ready && EINTR == errno)
+        {
+            continue;
+        }
+        if (1 != ready)
+        {
+            return -1;
+        }
+
+        return ((ssize_t)sizeof(record_t) == read(records_fd, rec,
+                                            sizeof(record_t))) ? 0 : -1;
+    }
+}
+
+
+static double Percentile(uint64_t *values, size_t n, size_t pct)
+{
+    size_t at = 0;
+
+    if (0 == n)
+    {
+        return 0.0;
+    }
+
+    qsort(values, n, sizeof(uint64_t), NsCmp);
+    at = (n * pct) / 100;
+
+    return values[(at < n) ? at : n - 1] / 1e6;
+}
+
+
+static void Pause(uint64_t ns)
+{
+    struct timespec ts;
+
+    ts.tv_sec = (time_t)(ns / MONO_NS_PER_SEC);
+    ts.tv_nsec = (long)(ns % MONO_NS_PER_SEC);
+    nanosleep(&ts, NULL);
+}
+
+
+static int NsCmp(const void *lhs, const void *rhs)
+{
+    uint64_t l = *(const uint64_t *)lhs, r = *(const uint64_t *)rhs;
+
+    return (l > r) - (l < r);
+}
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+ *
+ * Description: d-ary min heap of (key, data) pairs stored by value
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+
+#ifndef __DHEAP_H_OL108_ILRD__
+#define __DHEAP_H_OL108_ILRD__
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint64_t */
+
+typedef struct dheap dheap_t;
+
+/**
+ * @Description: Pointer to a function that stores the position of an element
+ *               in the heap (for DHeapRemoveAt / DHeapUpdateAt).
+ * @Parameters: data - the element's data.
+ *              index - its new index, DHEAP_NO_INDEX when it left the heap.
+ * @Return: void.
+**/
+typedef void (*dheap_set_index_t)(void *data, size_t index);
+
+#define DHEAP_NO_INDEX ((size_t)-1)
+#define DHEAP_DEFAULT_ARITY 4
+
+
+/**
+ * @Description: Creates an empty heap, ordered by the smallest key.
+ * @Parameters: arity - the number of children of a node, zero for
+ *                      DHEAP_DEFAULT_ARITY.
+ *              set_index - function that stores the index of an element, or
+ *                          NULL.
+ * @Return: a pointer to the new heap if created successfuly, otherwise NULL.
+ * @Notes: The keys are compared directly, the pairs are kept in one array -
+ *         a 4-ary heap of 16 byte pairs keeps the children of a node in one
+ *         cache line.
+ * @Complexity: O(1)
+**/
+dheap_t *DHeapCreate(size_t arity, dheap_set_index_t set_index);
+
+
+/**
+ * @Description: Destroys the given heap (but not the data).
+ * @Parameters: heap - a pointer to the heap.
+ * @Return: void.
+ * @Complexity: O(1)
+**/
+void DHeapDestroy(dheap_t *heap);
+
+
+/**
+ * @Description: Inserts the given data with the given key to the heap.
+ * @Parameters: heap - pointer to the heap
+ *              key - the priority of the data (smaller first).
+ *              data - pointer to the data
+ * @Return: 0 if inserted successfuly, 1 if failed (allocation fail)
+ * @Complexity: O(log n) (amortized, the array grows when full)
+**/
+int DHeapPush(dheap_t *heap, uint64_t key, void *data);
+
+
+/**
+ * @Description: Removes the element with the smallest key.
+ * @Parameters: heap - pointer to the heap
+ * @Return: The data of the removed element, NULL if the heap is empty.
+ * @Complexity: O(d log n / log d)
+**/
+void *DHeapPop(dheap_t *heap);
+
+
+/**
+ * @Description: Gets the element with the smallest key.
+ * @Parameters: heap - pointer to the heap
+ * @Return: The data of the element, NULL if the heap is empty.
+ * @Complexity: O(1)
+**/
+void *DHeapPeek(const dheap_t *heap);
+
+
+/**
+ * @Description: Gets the smallest key in the heap.
+ * @Parameters: heap - pointer to the heap
+ * @Return: The key of the DHeapPeek element. Undefined if the heap is empty.
+ * @Complexity: O(1)
+**/
+uint64_t DHeapPeekKey(const dheap_t *heap);
+
+
+/**
+ * @Description: Gets the size of the heap.
+ * @Parameters: heap - a pointer to the heap.
+ * @Return: The number of elements in the heap.
+ * @Complexity: O(1).
+**/
+size_t DHeapSize(const dheap_t *heap);
+
+
+/**
+ * @Description: Checks if the heap is empty.
+ * @Parameters: heap - a pointer to the heap.
+ * @Return: One if it is empty, zero if not.
+ * @Complexity: O(1)
+**/
+int DHeapIsEmpty(const dheap_t *heap);
+
+
+/**
+ * @Description: Removes the element at the given index.
+ * @Parameters: heap - pointer to the heap
+ *              index - the index of the element (as reported to set_index).
+ * @Return: The data of the removed element.
+ * @Notes: Undefined if index is out of range.
+ * @Complexity: O(d log n / log d)
+**/
+void *DHeapRemoveAt(dheap_t *heap, size_t index);
+
+
+/**
+ * @Description: Changes the key of the element at the given index.
+ * @Parameters: heap - pointer to the heap
+ *              index - the index of the element (as reported to set_index).
+ *              key - the new key.
+ * @Return: void.
+ * @Notes: Undefined if index is out of range.
+ * @Complexity: O(d log n / log d)
+**/
+void DHeapUpdateAt(dheap_t *heap, size_t index, uint64_t key);
+
+#endif /* __DHEAP_H_OL108_ILRD__ */
@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: Work-stealing executor - a fixed set of worker threads
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+
+#ifndef __EXECUTOR_H_OL108_ILRD__
+#define __EXECUTOR_H_OL108_ILRD__
+
+#include <stddef.h> /* size_t */
+
+typedef struct executor exec_t;
+
+/**
+ * @Description: Pointer to the function that runs a submitted item.
+ * @Parameters: param - the param given to ExecCreate.
+ *              item - the submitted item.
+ * @Return: void.
+ * @Notes: Called on a worker thread.
+**/
+typedef void (*exec_run_func_t)(void *param, void *item);
+
+/**
+ * @Description: Creates an executor and starts its worker threads.
+ * @Parameters: workers - the number of worker threads (at least one).
+ *              run - the function that runs the submitted items.
+ *              param - passed to run.
+ * @Return: A pointer to the new executor, NULL if allocation or thread
+ *          creation failed.
+ * @Notes: Each worker has its own deque of items. A worker takes the oldest
+ *         item of its deque, and when it is empty steals the newest item of
+ *         another worker, so one slow item holds up only its own worker.
+ * @Complexity: O(workers).
+**/
+exec_t *ExecCreate(size_t workers, exec_run_func_t run, void *param);
+
+
+/**
+ * @Description: Runs every submitted item, stops the workers and destroys the
+ *               executor.
+ * @Parameters: exec - a pointer to the executor.
+ * @Return: void.
+ * @Notes: Waits for the running items. Nothing may be submitted during or
+ *         after the call.
+ * @Complexity: O(workers + submitted items).
+**/
+void ExecDestroy(exec_t *exec);
+
+
+/**
+ * @Description: Hands an item to one of the workers.
+ * @Parameters: exec - a pointer to the executor.
+ *              item - the item to run.
+ * @Return: 0 on success, 1 if allocation failed (the item is not run).
+ * @Notes: Items are spread over the workers in turn. One thread at a time.
+ * @Complexity: O(1) amortized.
+**/
+int ExecSubmit(exec_t *exec, void *item);
+
+
+/**
+ * @Description: Gets the number of worker threads.
+ * @Parameters: exec - a pointer to the executor.
+ * @Return: The number of workers.
+ * @Complexity: O(1).
+**/
+size_t ExecWorkers(const exec_t *exec);
+
+#endif /* __EXECUTOR_H_OL108_ILRD__ */
@@ -33,6 +33,17 @@ typedef int (*heap_cmp_t)(const void *node_data, const void *compare_data);
 **/
 typedef int (*is_match_heap_t)(const void *node_data, const void *cmp_data);
 
+/**
+ * @Description: Pointer to a function that stores the position of an element
+ *               in the heap (for HeapRemoveAt / HeapUpdateAt).
+ * @Parameters: data - the element's data.
+ *              index - its new index, HEAP_NO_INDEX when it left the heap.
+ * @Return: void.
+**/
+typedef void (*heap_set_index_t)(void *data, size_t index);
+
+#define HEAP_NO_INDEX ((size_t)-1)
+
 
 /**
  * @Description: Creates an empty heap.
@@ -43,6 +54,17 @@ typedef int (*is_match_heap_t)(const void *node_data, const void *cmp_data);
 heap_t *HeapCreate(heap_cmp_t cmp_func);
 
 
+/**
+ * @Description: Creates an empty heap that reports the index of each element
+ *               whenever it moves.
+ * @Parameters: cmp_func - function to compare different elements.
+ *              set_index - function that stores the index of an element.
+ * @Return: a pointer to the new heap if created successfuly, otherwise NULL.
+ * @Complexity: O(1)
+**/
+heap_t *HeapCreateIndexed(heap_cmp_t cmp_func, heap_set_index_t set_index);
+
+
 /**
  * @Description: Destroys the given heap (but not the data).
  * @Parameters: heap - a pointer to the heap.
@@ -112,4 +134,27 @@ int HeapIsEmpty(const heap_t *heap);
 **/
 void *HeapRemove(heap_t *heap, const void *to_remove, is_match_heap_t is_match);
 
+
+/**
+ * @Description: Removes the element at the given index.
+ * @Parameters: heap - pointer to the heap
+ *              index - the index of the element (as reported to set_index).
+ * @Return: The data of the removed element.
+ * @Notes: Undefined if index is out of range.
+ * @Complexity: O(log n)
+**/
+void *HeapRemoveAt(heap_t *heap, size_t index);
+
+
+/**
+ * @Description: Restores the heap order after the priority of the element at
+ *               the given index changed.
+ * @Parameters: heap - pointer to the heap
+ *              index - the index of the element (as reported to set_index).
+ * @Return: void.
+ * @Notes: Undefined if index is out of range.
+ * @Complexity: O(log n)
+**/
+void HeapUpdateAt(heap_t *heap, size_t index);
+
 #endif /* __HEAP_H_OL108_ILRD__ */
\ No newline at end of file
@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+ 
+ * Description: Monotonic clock helpers (nanosecond resolution)
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+
+#ifndef __MONO_CLOCK_H_OL108_ILRD__
+#define __MONO_CLOCK_H_OL108_ILRD__
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint64_t */
+#include <time.h>   /* time_t, struct timespec */
+
+#define MONO_NS_PER_SEC ((uint64_t)1000000000)
+#define MONO_NS_PER_MS ((uint64_t)1000000)
+#define MONO_NS_PER_US ((uint64_t)1000)
+
+/* the histograms of durations (see MonoBucket) - bucket 0, under a
+   microsecond, bucket i - [2^(i-1), 2^i) microseconds, the last one and
+   above */
+#define MONO_BUCKETS 32
+
+/* <time.h> defines it only with POSIX features, -ansi users see a tag */
+struct timespec;
+
+/**
+ * @Description: Reads CLOCK_MONOTONIC.
+ * @Parameters: void.
+ * @Return: The current monotonic time in nanoseconds.
+ * @Complexity: O(1).
+**/
+uint64_t MonoNowNs(void);
+
+
+/**
+ * @Description: Converts a wall-clock time (as returned by time()) to the
+ *               matching point on the monotonic clock.
+ * @Parameters: wall_time - wall-clock time in seconds.
+ * @Return: The monotonic time in nanoseconds, zero if wall_time is before
+ *          the monotonic epoch.
+ * @Notes: The conversion uses the current offset between both clocks, so a
+ *         later wall-clock step does not move the result.
+ * @Complexity: O(1).
+**/
+uint64_t MonoFromTime(time_t wall_time);
+
+
+/**
+ * @Description: Converts a monotonic time to the matching wall-clock time.
+ * @Parameters: mono_ns - monotonic time in nanoseconds.
+ * @Return: The wall-clock time in seconds.
+ * @Complexity: O(1).
+**/
+time_t MonoToTime(uint64_t mono_ns);
+
+
+/**
+ * @Description: Converts nanoseconds to a struct timespec.
+ * @Parameters: ns - nanoseconds.
+ *              ts - a pointer to the timespec to fill.
+ * @Return: void.
+ * @Complexity: O(1).
+**/
+void MonoToTimespec(uint64_t ns, struct timespec *ts);
+
+
+/**
+ * @Description: Finds the histogram bucket of a duration.
+ * @Parameters: ns - the duration in nanoseconds.
+ * @Return: The bucket, MONO_BUCKETS - 1 at most.
+ * @Complexity: O(log(ns)).
+**/
+size_t MonoBucket(uint64_t ns);
+
+#endif /* __MONO_CLOCK_H_OL108_ILRD__ */
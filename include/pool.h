@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: Fixed-size object pool
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+
+#ifndef __POOL_H_OL108_ILRD__
+#define __POOL_H_OL108_ILRD__
+
+#include <stddef.h> /* size_t */
+
+typedef struct pool pool_t;
+
+/* PoolCreate flags */
+#define POOL_LOCKED 1        /* the pool may be shared by several threads */
+#define POOL_THREAD_CACHE 2  /* a small per-thread cache, implies POOL_LOCKED */
+
+typedef struct
+{
+	size_t obj_size;        /* the size of an object, after alignment */
+	size_t capacity;        /* objects in all the chunks of the pool */
+	size_t in_use;          /* objects out of the pool (thread caches included) */
+	size_t peak_in_use;
+	size_t chunks;          /* chunks allocated (the pool's malloc calls) */
+	unsigned long allocs;   /* objects taken from the pool */
+	unsigned long frees;    /* objects returned to the pool */
+} pool_stats_t;
+
+/**
+ * @Description: Creates an empty pool of fixed-size objects.
+ * @Parameters: obj_size - the size of an object.
+ *              chunk_objs - the number of objects allocated at once when the
+ *                           pool runs out of objects.
+ *              flags - zero, or POOL_LOCKED / POOL_THREAD_CACHE.
+ * @Return: A pointer to the new pool, or NULL if memory allocation failed.
+ * @Notes: Chunks are kept until the pool is destroyed, so a pool that reached
+ *         its working set allocates no more memory. A locked pool may be used
+ *         by the child of a fork from a process whose other threads use it,
+ *         the objects they cached are lost to the child.
+ * @Complexity: O(1).
+**/
+pool_t *PoolCreate(size_t obj_size, size_t chunk_objs, int flags);
+
+
+/**
+ * @Description: Destroys the pool and all its objects (allocated or not).
+ * @Parameters: pool - a pointer to the pool.
+ * @Return: void.
+ * @Notes: No other thread may use the pool during or after the call. Objects
+ *         cached for the pool by other threads are dropped.
+ * @Complexity: O(number of chunks).
+**/
+void PoolDestroy(pool_t *pool);
+
+
+/**
+ * @Description: Takes an object from the pool.
+ * @Parameters: pool - a pointer to the pool.
+ * @Return: A pointer to an uninitialized object, NULL if the pool is out of
+ *          objects and a new chunk could not be allocated.
+ * @Complexity: O(1) (O(chunk_objs) when a new chunk is allocated).
+**/
+void *PoolAlloc(pool_t *pool);
+
+
+/**
+ * @Description: Returns an object to the pool.
+ * @Parameters: pool - a pointer to the pool.
+ *              obj - an object taken from this pool, or NULL.
+ * @Return: void.
+ * @Complexity: O(1).
+**/
+void PoolFree(pool_t *pool, void *obj);
+
+
+/**
+ * @Description: Allocates chunks until the pool holds at least objs objects.
+ * @Parameters: pool - a pointer to the pool.
+ *              objs - the number of objects to reserve.
+ * @Return: Zero on success, one if memory allocation failed.
+ * @Complexity: O(objs).
+**/
+int PoolReserve(pool_t *pool, size_t objs);
+
+
+/**
+ * @Description: Returns the objects cached by the calling thread to the pool.
+ * @Parameters: pool - a pointer to the pool.
+ * @Return: void.
+ * @Notes: Done automatically when a thread exits.
+ * @Complexity: O(1) (bounded by the size of the cache).
+**/
+void PoolFlushThreadCache(pool_t *pool);
+
+
+/**
+ * @Description: Gets the usage counters of the pool.
+ * @Parameters: pool - a pointer to the pool.
+ *              stats - filled with the counters.
+ * @Return: void.
+ * @Complexity: O(1).
+**/
+void PoolGetStats(pool_t *pool, pool_stats_t *stats);
+
+#endif /* __POOL_H_OL108_ILRD__ */
@@ -34,6 +34,17 @@ typedef int (*cmp_priority_t)(const void *lhs, const void *rhs);
 typedef int (*is_match_pq_t)(const void *lhs, const void *rhs);
 
 
+/**
+ * @Description: Pointer to a function that stores the position of an element
+ *               in the PQ, PQ_NO_INDEX when the element leaves the PQ.
+ * @Parameters: A void pointer to the data, the new position.
+ * @Return: None.
+**/
+typedef void (*pq_set_index_t)(void *data, size_t index);
+
+#define PQ_NO_INDEX ((size_t)-1)
+
+
 /**
  * @Description: Creates a Priority Queue with the priority determined by the 
  *				cmp_priority. 
@@ -44,6 +55,16 @@ typedef int (*is_match_pq_t)(const void *lhs, const void *rhs);
 pq_t *PQCreate(cmp_priority_t cmp_priority);
 
 
+/**
+ * @Description: Creates a Priority Queue that reports the position of each
+ *				element, so it can be erased or re-prioritized directly.
+ * @Parameters: A cmp_priority_t function, a pq_set_index_t function.
+ * @Return: Pointer to the PQ, if the creation failed return NULL.
+ * @Complexity: O(1).
+**/
+pq_t *PQCreateIndexed(cmp_priority_t cmp_priority, pq_set_index_t set_index);
+
+
 /**
  * @Description: Destroys the given Priority Queue.
  * @Parameters: A pointer to the PQ.
@@ -118,4 +139,23 @@ void PQClear(pq_t *pqueue);
 **/
 void* PQErase(pq_t *pqueue, void *to_del, is_match_pq_t is_match);
 
+
+/**
+ * @Description: Removes the element at the given position.
+ * @Parameters: A pointer to the PQ, the position reported to set_index.
+ * @Return: The data of the removed element.
+ * @Complexity: O(log n) - where n is the number of elements in the PQ.
+**/
+void *PQEraseAt(pq_t *pqueue, size_t index);
+
+
+/**
+ * @Description: Re-positions the element at the given position after its
+ *				priority changed.
+ * @Parameters: A pointer to the PQ, the position reported to set_index.
+ * @Return: None.
+ * @Complexity: O(log n) - where n is the number of elements in the PQ.
+**/
+void PQUpdateAt(pq_t *pqueue, size_t index);
+
 #endif /* __PRIORITY_QUEUE_H_OL108__ */
@@ -2,7 +2,7 @@
  * Author: Meital Kozhidov
  * Reviewer: Keren Robbins
  * Date: August 15th, 2021
- 
+
  * Description: Scheduler implemantation
  *
  * Infinity Labs OL108
@@ -11,17 +11,69 @@
 #ifndef __SCHEDULER_H_OL108_ILRD__
 #define __SCHEDULER_H_OL108_ILRD__
 
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint64_t */
 #include <time.h>
 
-#include "uid.h"
+#include "mono_clock.h" /* MONO_BUCKETS */
+
 
 typedef struct scheduler sched_t;
 
+/* compact task handle - generation << 32 | slot, never reused while valid */
+typedef uint64_t sched_handle_t;
+
+#define SCHED_BAD_HANDLE ((sched_handle_t)0)
+
 typedef int (*sched_operation_func_t) (void *);
 typedef void (*sched_cleanup_func_t) (void *);
 
+/* called when a watched fd is readable - arg, the fd and the CLOCK_MONOTONIC
+   time it was seen readable, returns 0 to stop watching the fd (open - it
+   is closed after, or SchedRemoveFd is called before closing it) */
+typedef int (*sched_fd_func_t) (void *, int, uint64_t);
+
+typedef enum
+{
+	SCHED_HEAP,
+	SCHED_TIMING_WHEEL
+} sched_backend_t;
+
+/* the buckets of MonoBucket */
+#define SCHED_STATS_BUCKETS MONO_BUCKETS
+
+/* the runs of a task, or of all the tasks (see SchedGetStats) */
+typedef struct
+{
+	uint64_t runs;
+	uint64_t late_ns_total;		/* operation started - task start time */
+	uint64_t late_ns_max;
+	uint64_t run_ns_total;		/* of the operation */
+	uint64_t run_ns_max;
+	uint64_t overruns;			/* runs longer than the interval */
+	uint64_t overrun_ns_max;	/* the longest run past the interval */
+	uint64_t lateness[SCHED_STATS_BUCKETS];
+	uint64_t run_time[SCHED_STATS_BUCKETS];
+} sched_stats_t;
+
 /******************************************************************************/
 
+/*
+ * Threads: a scheduler is owned by the thread that created it, and from its
+ * first SchedRun by the thread that last ran it (hand it over before - e.g.
+ * create it in that thread, or start that thread after the last call of the
+ * creating one). Any thread may call SchedAddTask(Ns), SchedRemoveTask,
+ * SchedRescheduleTask and SchedStop at any time - the requests of threads
+ * other than the owner are queued without a lock and applied by the owner:
+ * by SchedRun before its next task (a request with an earlier deadline wakes
+ * it), or by the next SchedRun, SchedClear or SchedDestroy, so SchedSize does
+ * not count them until then (SchedRemoveTask and SchedRescheduleTask of the
+ * owner apply them first, the handle of a task another thread just added is
+ * valid for them). Every other function is for one thread at a
+ * time. With SchedSetWorkers, operations run on worker threads - they are
+ * "other threads" too.
+ */
+
 /**
  * @Description: Creates a new empty scheduler.
  * @Parameters: void.
@@ -32,6 +84,20 @@ typedef void (*sched_cleanup_func_t) (void *);
 sched_t *SchedCreate(void);
 
 
+/**
+ * @Description: Creates a new empty scheduler with the given task queue.
+ * @Parameters: backend - SCHED_HEAP (the SchedCreate queue) or 
+ *				SCHED_TIMING_WHEEL, a hierarchical timing wheel with O(1) add,
+ *				remove and expiry and a resolution of one millisecond.
+ * @Return: A pointer to the new scheduler that was created. Returns NULL if the
+ *			creation fails.
+ * @Notes: Tasks of the timing wheel run in start time order up to the wheel
+ *		   resolution, and never before their start time.
+ * @Complexity: O(1).
+**/
+sched_t *SchedCreateBackend(sched_backend_t backend);
+
+
 /**
  * @Description: Destroy the given scheduler and all the tasks in it.
  * @Parameters: A pointer to a scheduler.
@@ -48,40 +114,158 @@ void SchedDestroy(sched_t *sched);
  *				length of time between two operations of the task, void pointer
  *				to the argumnets that is given to the operation function, and a 
  *				clean function that will run and clean all what the function did.
- * @Return: The uuid of the new task. Returns bad_uuid if the creation of the
- *			new task fails.
- * @Complexity: O(n) - where n is the number of tasks in the scheduler.
+ * @Return: The handle of the new task. Returns SCHED_BAD_HANDLE if the 
+ *			creation of the new task fails.
+ * @Complexity: O(log n) - where n is the number of tasks in the scheduler.
 **/
-uuid_t SchedAddTask(sched_t *sched, sched_operation_func_t operation_func
+sched_handle_t SchedAddTask(sched_t *sched, sched_operation_func_t operation_func
 		, time_t start_time, time_t time_interval, void *args
 		, sched_cleanup_func_t cleanup_func);
 
 
 /**
- * @Description: remove task with given uuid in given scheduler.
- * @Parameters: A pointer to a scheduler and a uuid (of a task).
+ * @Description: Creates a new Task with nanosecond timing and add it to the
+ *				 schduler.
+ * @Parameters: The scheduler that the new task will be added to.
+ *				The operation function of the new task, a CLOCK_MONOTONIC time
+ *				to start and the interval between two operations (both in
+ *				nanoseconds, see MonoNowNs()), the argumnets of the operation
+ *				function and a cleanup function.
+ * @Return: The handle of the new task. Returns SCHED_BAD_HANDLE if the 
+ *			creation of the new task fails.
+ * @Notes: Wall-clock steps do not affect tasks, the start time of a task added
+ *		   with SchedAddTask is converted to the monotonic clock when added.
+ * @Complexity: O(log n) - where n is the number of tasks in the scheduler.
+**/
+sched_handle_t SchedAddTaskNs(sched_t *sched, sched_operation_func_t operation_func
+		, uint64_t start_ns, uint64_t interval_ns, void *args
+		, sched_cleanup_func_t cleanup_func);
+
+
+/**
+ * @Description: remove task with given handle in given scheduler.
+ * @Parameters: A pointer to a scheduler and a handle (of a task).
  * @Return: 0 if the task was found (and destroyed), 1 otherwise.
- * @Complexity: O(n) - where n is the number of tasks in the scheduler.
+ * @Notes: A task removed while its operation runs is destroyed when the
+ *		   operation returns. From another thread, the task is removed when
+ *		   SchedRun applies the request - if it did not finish by then.
+ * @Complexity: O(log n) - where n is the number of tasks in the scheduler.
 **/
-int SchedRemoveTask(sched_t *sched, uuid_t uuid);
+int SchedRemoveTask(sched_t *sched, sched_handle_t handle);
+
+
+/**
+ * @Description: Changes the next start time and the interval of a task.
+ * @Parameters: A pointer to a scheduler, a handle (of a task), the new start
+ *				time and interval in nanoseconds (CLOCK_MONOTONIC).
+ * @Return: 0 if the task was found, 1 otherwise.
+ * @Notes: If the task is running, it is re-queued at start_ns when its
+ *		   operation returns (instead of after its old interval).
+ * @Complexity: O(log n) - where n is the number of tasks in the scheduler.
+**/
+int SchedRescheduleTask(sched_t *sched, sched_handle_t handle
+		, uint64_t start_ns, uint64_t interval_ns);
 
 
 /**
  * @Description: Runs all the tasks in the scheduler till the scheduler is empty
- *				 or there is an appearance of a Stop Task.
+ *				 (and no fd is watched) or there is an appearance of a Stop Task.
  * @Parameters: A pointer to a scheduler.
  * @Return: Nothing.
+ * @Notes: Between tasks the calling thread sleeps until the next start time,
+ *		   it is woken early by an earlier task of another thread or SchedStop.
+ *		   Requests of other threads that arrive as it returns are applied
+ *		   before it returns. With workers (see SchedSetWorkers), it returns
+ *		   after the running operations have returned.
  * @Complexity: O(n*m) - where n is the number of tasks in the scheduler, and m
  *				is the maximum times that a task will run.
 **/
 void SchedRun(sched_t *sched);
 
 
+/**
+ * @Description: Watches a file descriptor in SchedRun - the given function is
+ *				 called when it is readable.
+ * @Parameters: A pointer to a scheduler, the fd, the function and its argument.
+ * @Return: 0 on success, 1 on failure (allocation, or the fd cannot be
+ *			watched by epoll - a regular file for example).
+ * @Notes: SchedRun waits for the next task and the watched fds in one
+ *		   epoll_wait, and checks the fds between due tasks, so the function
+ *		   runs (on the thread of SchedRun) as soon as the fd is readable. The
+ *		   fd is level-triggered - the function should read all that is
+ *		   ready. SchedRun does not return while an fd is watched, unless
+ *		   stopped. Not from other threads while SchedRun runs.
+ * @Complexity: O(1).
+**/
+int SchedAddFd(sched_t *sched, int fd, sched_fd_func_t fd_func, void *arg);
+
+
+/**
+ * @Description: Stops watching a file descriptor.
+ * @Parameters: A pointer to a scheduler, the fd.
+ * @Return: 0 if the fd was watched, 1 otherwise, -1 if it was closed
+ *			before.
+ * @Notes: Call it before closing the fd (also from the fd's own function) -
+ *		   epoll watches the open file, which a copy of the fd (dup, fork)
+ *		   keeps open after a close, and the watch can no longer be dropped
+ *		   from it: -1 is returned, and its events are ignored until
+ *		   SchedDestroy. Not from other threads while SchedRun runs.
+ * @Complexity: O(number of watched fds).
+**/
+int SchedRemoveFd(sched_t *sched, int fd);
+
+
+/**
+ * @Description: Sets the number of worker threads that run the operations of
+ *				 the tasks in SchedRun.
+ * @Parameters: A pointer to a scheduler, the number of workers - zero (the
+ *				default) runs the operations on the thread of SchedRun.
+ * @Return: void.
+ * @Notes: With workers, the thread of SchedRun only hands the due tasks to
+ *		   the workers (a slow operation does not delay other tasks), and
+ *		   re-queues a repeated task when its operation returns - a task never
+ *		   runs twice at once. Operations of different tasks may run at the
+ *		   same time, and must be thread-safe.
+ *		   Not while SchedRun runs. If the workers cannot be started, SchedRun
+ *		   runs the operations itself.
+ * @Complexity: O(1).
+**/
+void SchedSetWorkers(sched_t *sched, size_t workers);
+
+
+/**
+ * @Description: Gets the statistics of all the operations SchedRun ran.
+ * @Parameters: A pointer to a scheduler, the statistics to fill.
+ * @Return: 0 on success, 1 if the scheduler keeps no statistics (stats is
+ *			zeroed).
+ * @Notes: Only a build with SCHED_STATS defined (make SCHED_STATS=1) keeps
+ *		   them - two clock reads and a lock per operation. Other builds
+ *		   compile the timing out. Any thread may call it.
+ * @Complexity: O(1).
+**/
+int SchedGetStats(sched_t *sched, sched_stats_t *stats);
+
+
+/**
+ * @Description: Gets the statistics of the operations of one task.
+ * @Parameters: A pointer to a scheduler, a handle (of a task), the
+ *				statistics to fill.
+ * @Return: 0 on success, 1 if the task was not found or the scheduler keeps
+ *			no statistics (stats is zeroed).
+ * @Notes: As SchedGetStats - the statistics go with the task when it is
+ *		   destroyed.
+ * @Complexity: O(1).
+**/
+int SchedGetTaskStats(sched_t *sched, sched_handle_t handle
+		, sched_stats_t *stats);
+
+
 /**
  * @Description: A function that can be added to the scheduler as an operation_func
  *				 of a task to stop the scheduler from continuing running.
  * @Parameters: A pointer to a scheduler.
  * @Return: int of zero (no repetitions for this task).
+ * @Notes: Safe to call from a signal handler, a sleeping SchedRun returns.
  * @Complexity: O(1).
 **/
 int SchedStop(sched_t *sched);
@@ -99,7 +283,8 @@ int SchedIsEmpty(const sched_t *sched);
 /**
  * @Description: Returns the size of a given scheduler.
  * @Parameters: A pointer to a scheduler.
- * @Return: The size of the given scheduler.
+ * @Return: The size of the given scheduler (tasks added by other threads are
+ *			counted once SchedRun applied them).
  * @Complexity: O(n) - where n is the number of tasks in the scheduler.
 **/
 size_t SchedSize(const sched_t *sched);
@@ -2,7 +2,7 @@
  * Author: Meital Kozhidov
  * Reviewer: Keren Robbins
  * Date: August 15th, 2021
- 
+
  * Description: Task implemantation
  *
  * Infinity Labs OL108
@@ -11,8 +11,11 @@
 #ifndef __TASK_H_OL108_ILRD__
 #define __TASK_H_OL108_ILRD__
 
-#include <time.h> /* time_t */
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint64_t */
+#include <time.h>   /* time_t */
 
+#include "pool.h"
 #include "uid.h"
 
 
@@ -45,12 +48,51 @@ typedef void (*task_cleanup_func_t) (void *);
  *				clean function that will run and clean all what the function did.
  * @Return: A pointer to the new task that was created. Returns NULL if the
  *			creation fails.
+ * @Notes: start_time is a wall-clock time, it is converted once to the
+ *		   monotonic clock the task is kept on.
  * @Complexity: O(1).
 **/
 task_t *TaskCreate(task_operation_func_t operation, time_t start_time
 		, time_t time_interval, void *args, task_cleanup_func_t cleanup);
 
 
+/**
+ * @Description: Creates a new Task with nanosecond timing.
+ * @Parameters: The operation function of the new task, a CLOCK_MONOTONIC
+ *				time to start and the interval between two operations (both in
+ *				nanoseconds), the arguments of the operation function and a 
+ *				cleanup function.
+ * @Return: A pointer to the new task that was created. Returns NULL if the
+ *			creation fails.
+ * @Complexity: O(1).
+**/
+task_t *TaskCreateNs(task_operation_func_t operation, uint64_t start_ns
+		, uint64_t interval_ns, void *args, task_cleanup_func_t cleanup);
+
+
+/**
+ * @Description: Creates a new Task (as TaskCreateNs) from a pool.
+ * @Parameters: A pool of task_t sized objects (see TaskSize), NULL to use
+ *				malloc, and the parameters of TaskCreateNs.
+ * @Return: A pointer to the new task that was created. Returns NULL if the
+ *			creation fails.
+ * @Notes: TaskDestroy returns the task to the pool, which must outlive it.
+ * @Complexity: O(1).
+**/
+task_t *TaskCreateFromPool(pool_t *pool, task_operation_func_t operation
+		, uint64_t start_ns, uint64_t interval_ns, void *args
+		, task_cleanup_func_t cleanup);
+
+
+/**
+ * @Description: Gets the size of a task, for pools of tasks.
+ * @Parameters: None.
+ * @Return: sizeof(task_t).
+ * @Complexity: O(1).
+**/
+size_t TaskSize(void);
+
+
 /**
  * @Description: Run the cleanup function of the task and destroy it.
  * @Parameters: A pointer to a task.
@@ -63,10 +105,11 @@ void TaskDestroy(task_t *task);
 /**
  * @Description: Gets a task and returns its uuid.
  * @Parameters: A pointer to a task.
- * @Return: The given task's uuid.
+ * @Return: The given task's uuid, bad_uuid if it could not be created.
+ * @Notes: The uuid is created by the first call.
  * @Complexity: O(1)
 **/		
-uuid_t TaskGetUID(const task_t *task);
+uuid_t TaskGetUID(task_t *task);
 
 
 /**
@@ -78,6 +121,24 @@ uuid_t TaskGetUID(const task_t *task);
 time_t TaskGetStartTime(const task_t *task);
 
 
+/**
+ * @Description: Gets a task and returns its start time on the monotonic clock.
+ * @Parameters: A pointer to a task.
+ * @Return: The given task's start time in nanoseconds (CLOCK_MONOTONIC).
+ * @Complexity: O(1)
+**/		
+uint64_t TaskGetStartTimeNs(const task_t *task);
+
+
+/**
+ * @Description: Gets a task and returns its interval.
+ * @Parameters: A pointer to a task.
+ * @Return: The time between two operations of the task, in nanoseconds.
+ * @Complexity: O(1)
+**/		
+uint64_t TaskGetIntervalNs(const task_t *task);
+
+
 /**
  * @Description: Run the given task's operation function with its arguments.
  * @Parameters: A pointer to a task.
@@ -96,4 +157,88 @@ int TaskRunOperation(const task_t *task);
 **/	
 task_t *TaskUpdateStartTime(task_t *task);
 
+
+
+/**
+ * @Description: Stores the scheduler's queue node of the task.
+ * @Parameters: A pointer to a task, the node (NULL when it is not queued).
+ * @Return: Nothing.
+ * @Complexity: O(1).
+**/	
+void TaskSetQueueNode(task_t *task, void *node);
+
+
+/**
+ * @Description: Gets the scheduler's queue node of the task.
+ * @Parameters: A pointer to a task.
+ * @Return: The node set by TaskSetQueueNode, NULL if none was set.
+ * @Complexity: O(1).
+**/	
+void *TaskGetQueueNode(const task_t *task);
+
+
+
+/**
+ * @Description: Stores the position of the task in the scheduler's heap.
+ * @Parameters: A pointer to a task, the position.
+ * @Return: Nothing.
+ * @Complexity: O(1).
+**/	
+void TaskSetQueueIndex(task_t *task, size_t index);
+
+
+/**
+ * @Description: Gets the position of the task in the scheduler's heap.
+ * @Parameters: A pointer to a task.
+ * @Return: The position set by TaskSetQueueIndex.
+ * @Complexity: O(1).
+**/	
+size_t TaskGetQueueIndex(const task_t *task);
+
+
+/**
+ * @Description: Stores the scheduler handle of the task.
+ * @Parameters: A pointer to a task, the handle.
+ * @Return: Nothing.
+ * @Complexity: O(1).
+**/	
+void TaskSetHandle(task_t *task, uint64_t handle);
+
+
+/**
+ * @Description: Gets the scheduler handle of the task.
+ * @Parameters: A pointer to a task.
+ * @Return: The handle set by TaskSetHandle, zero if none was set.
+ * @Complexity: O(1).
+**/	
+uint64_t TaskGetHandle(const task_t *task);
+
+
+/**
+ * @Description: Sets the next start time and the interval of a task.
+ * @Parameters: A pointer to a task, the start time and the interval in
+ *				nanoseconds (CLOCK_MONOTONIC).
+ * @Return: Nothing.
+ * @Complexity: O(1).
+**/	
+void TaskSetTimesNs(task_t *task, uint64_t start_ns, uint64_t interval_ns);
+
+
+/**
+ * @Description: Stores the scheduler's state flags of the task.
+ * @Parameters: A pointer to a task, the flags.
+ * @Return: Nothing.
+ * @Complexity: O(1).
+**/	
+void TaskSetFlags(task_t *task, unsigned int flags);
+
+
+/**
+ * @Description: Gets the scheduler's state flags of the task.
+ * @Parameters: A pointer to a task.
+ * @Return: The flags set by TaskSetFlags, zero if none were set.
+ * @Complexity: O(1).
+**/	
+unsigned int TaskGetFlags(const task_t *task);
+
 #endif /* __TASK_H_OL108_ILRD__ */
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: Hierarchical timing wheel implementation
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+
+#ifndef __TIMING_WHEEL_H_OL108_ILRD__
+#define __TIMING_WHEEL_H_OL108_ILRD__
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint64_t */
+
+typedef struct timing_wheel timing_wheel_t;
+typedef struct tw_node tw_node_t;
+
+/* returned by TWNextExpiry when the wheel is empty */
+#define TW_NO_EXPIRY ((uint64_t)-1)
+
+/**
+ * @Description: Creates an empty timing wheel.
+ * @Parameters: tick_ns - the resolution of the wheel in nanoseconds.
+ *              now_ns - the current time, the wheel starts counting from it.
+ * @Return: A pointer to the new wheel, or NULL if memory allocation failed.
+ * @Notes: The wheel has 4 levels of 256 slots, deadlines further than
+ *         2^32 ticks away are kept in the last level and cascaded again.
+ * @Complexity: O(1).
+**/
+timing_wheel_t *TWCreate(uint64_t tick_ns, uint64_t now_ns);
+
+
+/**
+ * @Description: Destroys the wheel (but not the data).
+ * @Parameters: wheel - a pointer to the wheel.
+ * @Return: void.
+ * @Complexity: O(n).
+**/
+void TWDestroy(timing_wheel_t *wheel);
+
+
+/**
+ * @Description: Inserts a timer to the wheel.
+ * @Parameters: wheel - a pointer to the wheel.
+ *              data - the data of the timer.
+ *              deadline_ns - the time the timer expires at.
+ * @Return: A handle to the timer (for TWRemove), NULL if allocation failed.
+ * @Notes: A timer never expires before its deadline, it may expire up to one
+ *         tick after it.
+ * @Complexity: O(1).
+**/
+tw_node_t *TWInsert(timing_wheel_t *wheel, void *data, uint64_t deadline_ns);
+
+
+/**
+ * @Description: Removes a timer that did not expire yet.
+ * @Parameters: wheel - a pointer to the wheel.
+ *              node - the handle returned by TWInsert.
+ * @Return: The data of the removed timer.
+ * @Notes: The handle is invalid after the removal.
+ * @Complexity: O(1).
+**/
+void *TWRemove(timing_wheel_t *wheel, tw_node_t *node);
+
+
+/**
+ * @Description: Moves a timer that did not expire yet to a new deadline.
+ * @Parameters: wheel - a pointer to the wheel.
+ *              node - the handle returned by TWInsert.
+ *              deadline_ns - the new time the timer expires at.
+ * @Return: void.
+ * @Notes: The handle stays valid, the move allocates nothing so it cannot
+ *         fail.
+ * @Complexity: O(1).
+**/
+void TWUpdate(timing_wheel_t *wheel, tw_node_t *node, uint64_t deadline_ns);
+
+
+/**
+ * @Description: Advances the wheel to now_ns and pops one expired timer.
+ * @Parameters: wheel - a pointer to the wheel.
+ *              now_ns - the current time.
+ * @Return: The data of an expired timer, NULL if no timer expired.
+ * @Notes: The handle of the popped timer is invalid after the call.
+ * @Complexity: O(1) amortized per tick and per timer.
+**/
+void *TWPopExpired(timing_wheel_t *wheel, uint64_t now_ns);
+
+
+/**
+ * @Description: Gets the next time the wheel should be advanced at.
+ * @Parameters: wheel - a pointer to the wheel.
+ * @Return: The earliest expiry time in the lowest level, the next cascade
+ *          time if the lowest level is empty, or TW_NO_EXPIRY.
+ * @Complexity: O(1) (bounded by the number of slots).
+**/
+uint64_t TWNextExpiry(const timing_wheel_t *wheel);
+
+
+/**
+ * @Description: Returns the number of timers in the wheel.
+ * @Parameters: wheel - a pointer to the wheel.
+ * @Return: The number of timers (expired timers that were not popped
+ *          included).
+ * @Complexity: O(1).
+**/
+size_t TWSize(const timing_wheel_t *wheel);
+
+
+/**
+ * @Description: Checks whether the wheel is empty.
+ * @Parameters: wheel - a pointer to the wheel.
+ * @Return: One if it is empty, zero if not.
+ * @Complexity: O(1).
+**/
+int TWIsEmpty(const timing_wheel_t *wheel);
+
+#endif /* __TIMING_WHEEL_H_OL108_ILRD__ */
@@ -0,0 +1,273 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+ *
+ * Description: d-ary min heap of (key, data) pairs stored by value
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#include <assert.h> /* assert() */
+#include <stdlib.h> /* malloc(), realloc(), free() */
+
+#include "dheap.h"
+
+#define INIT_CAPACITY 16
+#define GROWTH_FACTOR 2
+
+typedef struct
+{
+    uint64_t key;
+    void *data;
+} entry_t;
+
+struct dheap
+{
+    entry_t *entries;
+    size_t size;
+    size_t capacity;
+    size_t arity;
+    dheap_set_index_t set_index;
+};
+
+static void SiftUp(dheap_t *heap, size_t index, entry_t entry);
+static void SiftDown(dheap_t *heap, size_t index, entry_t entry);
+static void Place(dheap_t *heap, size_t index, entry_t entry);
+/******************************************************************************/
+dheap_t *DHeapCreate(size_t arity, dheap_set_index_t set_index)
+{
+    dheap_t *heap = (dheap_t *)malloc(sizeof(dheap_t));
+
+    if (NULL == heap)
+    {
+        return NULL;
+    }
+
+    heap->entries = (entry_t *)malloc(INIT_CAPACITY * sizeof(entry_t));
+    if (NULL == heap->entries)
+    {
+        free(heap);
+        return NULL;
+    }
+
+    heap->size = 0;
+    heap->capacity = INIT_CAPACITY;
+    heap->arity = (0 == arity) ? DHEAP_DEFAULT_ARITY : arity;
+    heap->set_index = set_index;
+
+    assert(2 <= heap->arity);
+
+    return heap;
+}
+
+
+void DHeapDestroy(dheap_t *heap)
+{
+    assert(NULL != heap);
+
+    free(heap->entries);
+    heap->entries = NULL;
+
+    free(heap);
+    heap = NULL;
+}
+
+
+int DHeapPush(dheap_t *heap, uint64_t key, void *data)
+{
+    entry_t entry;
+
+    assert(NULL != heap);
+
+    if (heap->size == heap->capacity)
+    {
+        entry_t *entries = (entry_t *)realloc(heap->entries,
+                        heap->capacity * GROWTH_FACTOR * sizeof(entry_t));
+
+        if (NULL == entries)
+        {
+            return 1;
+        }
+
+        heap->entries = entries;
+        heap->capacity *= GROWTH_FACTOR;
+    }
+
+    entry.key = key;
+    entry.data = data;
+
+    SiftUp(heap, heap->size++, entry);
+
+    return 0;
+}
+
+
+void *DHeapPop(dheap_t *heap)
+{
+    assert(NULL != heap);
+
+    if (0 == heap->size)
+    {
+        return NULL;
+    }
+
+    return DHeapRemoveAt(heap, 0);
+}
+
+
+void *DHeapPeek(const dheap_t *heap)
+{
+    assert(NULL != heap);
+
+    return (0 == heap->size) ? NULL : heap->entries[0].data;
+}
+
+
+uint64_t DHeapPeekKey(const dheap_t *heap)
+{
+    assert(NULL != heap);
+    assert(0 != heap->size);
+
+    return heap->entries[0].key;
+}
+
+
+size_t DHeapSize(const dheap_t *heap)
+{
+    assert(NULL != heap);
+
+    return heap->size;
+}
+
+
+int DHeapIsEmpty(const dheap_t *heap)
+{
+    assert(NULL != heap);
+
+    return (0 == heap->size);
+}
+
+
+void *DHeapRemoveAt(dheap_t *heap, size_t index)
+{
+    void *removed = NULL;
+    uint64_t removed_key = 0;
+    entry_t last;
+
+    assert(NULL != heap);
+    assert(index < heap->size);
+
+    removed = heap->entries[index].data;
+    removed_key = heap->entries[index].key;
+    last = heap->entries[--heap->size];
+
+    if (NULL != heap->set_index)
+    {
+        heap->set_index(removed, DHEAP_NO_INDEX);
+    }
+
+    /* the last element fills the hole, from where it belongs */
+    if (index < heap->size)
+    {
+        if (last.key < removed_key)
+        {
+            SiftUp(heap, index, last);
+        }
+        else
+        {
+            SiftDown(heap, index, last);
+        }
+    }
+
+    return removed;
+}
+
+
+void DHeapUpdateAt(dheap_t *heap, size_t index, uint64_t key)
+{
+    entry_t entry;
+
+    assert(NULL != heap);
+    assert(index < heap->size);
+
+    entry = heap->entries[index];
+
+    if (key < entry.key)
+    {
+        entry.key = key;
+        SiftUp(heap, index, entry);
+    }
+    else
+    {
+        entry.key = key;
+        SiftDown(heap, index, entry);
+    }
+}
+
+/******************************************************************************/
+/* both sifts move a hole instead of swapping, entry is written once at the end */
+static void SiftUp(dheap_t *heap, size_t index, entry_t entry)
+{
+    while (0 != index)
+    {
+        size_t parent = (index - 1) / heap->arity;
+
+        if (heap->entries[parent].key <= entry.key)
+        {
+            break;
+        }
+
+        Place(heap, index, heap->entries[parent]);
+        index = parent;
+    }
+
+    Place(heap, index, entry);
+}
+
+
+static void SiftDown(dheap_t *heap, size_t index, entry_t entry)
+{
+    for (;;)
+    {
+        size_t first = index * heap->arity + 1;
+        size_t end = first + heap->arity;
+        size_t min = first, child = 0;
+
+        if (first >= heap->size)
+        {
+            break;
+        }
+        if (end > heap->size)
+        {
+            end = heap->size;
+        }
+
+        for (child = first + 1; child < end; ++child)
+        {
+            if (heap->entries[child].key < heap->entries[min].key)
+            {
+                min = child;
+            }
+        }
+
+        if (heap->entries[min].key >= entry.key)
+        {
+            break;
+        }
+
+        Place(heap, index, heap->entries[min]);
+        index = min;
+    }
+
+    Place(heap, index, entry);
+}
+
+
+static void Place(dheap_t *heap, size_t index, entry_t entry)
+{
+    heap->entries[index] = entry;
+
+    if (NULL != heap->set_index)
+    {
+        heap->set_index(entry.data, index);
+    }
+}
@@ -0,0 +1,311 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: Work-stealing executor implementation
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <assert.h>    /* assert() */
+#include <errno.h>     /* errno, EINTR */
+#include <stdlib.h>    /* malloc(), realloc(), free() */
+#include <pthread.h>   /* pthread_create(), pthread_join(), pthread_mutex_t */
+#include <semaphore.h> /* sem_t, sem_init(), sem_wait(), sem_post() */
+
+#include "executor.h"
+
+#define DEQUE_INIT_CAPACITY 16
+#define GROWTH_FACTOR 2
+
+/* a worker and its deque - a ring of items, oldest at head */
+typedef struct
+{
+	exec_t *exec;
+	pthread_t thread;
+	pthread_mutex_t lock;
+	void **items;
+	size_t head;
+	size_t count;
+	size_t capacity;
+	size_t index;
+} worker_t;
+
+struct executor
+{
+	worker_t *workers;
+	size_t n_workers;
+	size_t next_worker;
+	exec_run_func_t run;
+	void *param;
+	int is_stopping;
+	sem_t ready;       /* a token per submitted item, and per worker to stop */
+};
+
+static void *WorkerLoop(void *arg);
+static void *TakeWork(exec_t *exec, worker_t *self);
+static void *PopOldest(worker_t *worker);
+static void *PopNewest(worker_t *worker);
+static int PushNewest(worker_t *worker, void *item);
+static void StopWorkers(exec_t *exec, size_t started);
+
+/******************************************************************************/
+
+exec_t *ExecCreate(size_t workers, exec_run_func_t run, void *param)
+{
+	exec_t *exec = NULL;
+	size_t i = 0;
+	
+	assert(0 < workers);
+	assert(NULL != run);
+	
+	exec = (exec_t*)malloc(sizeof(exec_t));
+	if (NULL == exec)
+	{
+		return NULL;
+	}
+	
+	exec->workers = (worker_t*)malloc(workers * sizeof(worker_t));
+	if (NULL == exec->workers || 0 != sem_init(&exec->ready, 0, 0))
+	{
+		free(exec->workers);
+		free(exec);
+	
+		return NULL;
+	}
+	
+	exec->n_workers = workers;
+	exec->next_worker = 0;
+	exec->run = run;
+	exec->param = param;
+	exec->is_stopping = 0;
+	
+	for (i = 0; i < workers; ++i)
+	{
+		worker_t *worker = &exec->workers[i];
+	
+		worker->exec = exec;
+		worker->head = 0;
+		worker->count = 0;
+		worker->capacity = DEQUE_INIT_CAPACITY;
+		worker->index = i;
+		worker->items = (void**)malloc(DEQUE_INIT_CAPACITY * sizeof(void*));
+	
+		if (NULL == worker->items)
+		{
+			break;
+		}
+		if (0 != pthread_mutex_init(&worker->lock, NULL))
+		{
+			free(worker->items);
+			break;
+		}
+		if (0 != pthread_create(&worker->thread, NULL, WorkerLoop, worker))
+		{
+			pthread_mutex_destroy(&worker->lock);
+			free(worker->items);
+			break;
+		}
+	}
+	
+	if (i < workers)
+	{
+		StopWorkers(exec, i);
+	
+		return NULL;
+	}
+	
+	return exec;
+}
+
+
+void ExecDestroy(exec_t *exec)
+{
+	assert(NULL != exec);
+	
+	StopWorkers(exec, exec->n_workers);
+}
+
+
+int ExecSubmit(exec_t *exec, void *item)
+{
+	worker_t *worker = NULL;
+	
+	assert(NULL != exec);
+	
+	worker = &exec->workers[exec->next_worker];
+	exec->next_worker = (exec->next_worker + 1) % exec->n_workers;
+	
+	if (0 != PushNewest(worker, item))
+	{
+		return 1;
+	}
+	
+	sem_post(&exec->ready);
+	
+	return 0;
+}
+
+
+size_t ExecWorkers(const exec_t *exec)
+{
+	assert(NULL != exec);
+	
+	return exec->n_workers;
+}
+
+/******************************************************************************/
+
+static void *WorkerLoop(void *arg)
+{
+	worker_t *self = (worker_t*)arg;
+	exec_t *exec = self->exec;
+	
+	for (;;)
+	{
+		void *item = NULL;
+	
+		while (0 != sem_wait(&exec->ready) && EINTR == errno)
+		{
+			/* retry */
+		}
+	
+		item = TakeWork(exec, self);
+	
+		if (NULL != item)
+		{
+			exec->run(exec->param, item);
+		}
+		else
+		{
+			break;
+		}
+	}
+	
+	return NULL;
+}
+
+
+static void *TakeWork(exec_t *exec, worker_t *self)
+{
+	/* a token means an item exists, another worker may have taken the one we
+	   passed - scan again. Once stopping, nothing is submitted, so a scan
+	   that started after it and found nothing is final */
+	for (;;)
+	{
+		int is_final = __atomic_load_n(&exec->is_stopping, __ATOMIC_ACQUIRE);
+		void *item = PopOldest(self);
+		size_t i = 0;
+	
+		for (i = 1; NULL == item && i < exec->n_workers; ++i)
+		{
+			item = PopNewest(&exec->workers[(self->index + i)
+														% exec->n_workers]);
+		}
+	
+		if (NULL != item || is_final)
+		{
+			return item;
+		}
+	}
+}
+
+
+static void *PopOldest(worker_t *worker)
+{
+	void *item = NULL;
+	
+	pthread_mutex_lock(&worker->lock);
+	if (0 != worker->count)
+	{
+		item = worker->items[worker->head];
+		worker->head = (worker->head + 1) % worker->capacity;
+		--worker->count;
+	}
+	pthread_mutex_unlock(&worker->lock);
+	
+	return item;
+}
+
+
+static void *PopNewest(worker_t *worker)
+{
+	void *item = NULL;
+	
+	pthread_mutex_lock(&worker->lock);
+	if (0 != worker->count)
+	{
+		--worker->count;
+		item = worker->items[(worker->head + worker->count)
+														% worker->capacity];
+	}
+	pthread_mutex_unlock(&worker->lock);
+	
+	return item;
+}
+
+
+static int PushNewest(worker_t *worker, void *item)
+{
+	pthread_mutex_lock(&worker->lock);
+	
+	if (worker->count == worker->capacity)
+	{
+		void **items = (void**)realloc(worker->items
+						, worker->capacity * GROWTH_FACTOR * sizeof(void*));
+		size_t i = 0;
+	
+		if (NULL == items)
+		{
+			pthread_mutex_unlock(&worker->lock);
+	
+			return 1;
+		}
+	
+		/* the wrapped part moves past the old end */
+		for (i = 0; i < worker->head; ++i)
+		{
+			items[worker->capacity + i] = items[i];
+		}
+		worker->items = items;
+		worker->capacity *= GROWTH_FACTOR;
+	}
+	
+	worker->items[(worker->head + worker->count) % worker->capacity] = item;
+	++worker->count;
+	
+	pthread_mutex_unlock(&worker->lock);
+	
+	return 0;
+}
+
+
+static void StopWorkers(exec_t *exec, size_t started)
+{
+	size_t i = 0;
+	
+	__atomic_store_n(&exec->is_stopping, 1, __ATOMIC_RELEASE);
+	
+	for (i = 0; i < started; ++i)
+	{
+		sem_post(&exec->ready);
+	}
+	
+	/* a worker may steal from any deque until all have stopped */
+	for (i = 0; i < started; ++i)
+	{
+		pthread_join(exec->workers[i].thread, NULL);
+	}
+	
+	for (i = 0; i < started; ++i)
+	{
+		pthread_mutex_destroy(&exec->workers[i].lock);
+		free(exec->workers[i].items);
+	}
+	
+	sem_destroy(&exec->ready);
+	free(exec->workers);
+	free(exec);
+}
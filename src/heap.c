@@ -21,6 +21,7 @@ struct heap
 {
     d_vector_t *d_vec;
     heap_cmp_t cmp_func;
+    heap_set_index_t set_index;
 };
 
 static void HeapifyUp(heap_t *heap, size_t index);
@@ -28,11 +29,18 @@ static void HeapifyDown(heap_t *heap, size_t index, size_t size);
 static int IsNotHeapified(heap_t *heap, size_t parent_idx, size_t child_idx);
 static void Swap(d_vector_t *vec, size_t index1, size_t index2);
 static void *RemoveFromIndex(heap_t *heap, size_t index, size_t last_index);
+static void SetIndex(heap_t *heap, size_t index);
 static size_t GetParentIndex(size_t index);
 static size_t GetLeftChildIndex(size_t index);
 static size_t GetRightChildIndex(size_t index);
 /******************************************************************************/
 heap_t *HeapCreate(heap_cmp_t cmp_func)
+{
+    return HeapCreateIndexed(cmp_func, NULL);
+}
+
+
+heap_t *HeapCreateIndexed(heap_cmp_t cmp_func, heap_set_index_t set_index)
 {
     heap_t *heap = NULL;
 
@@ -52,6 +60,7 @@ heap_t *HeapCreate(heap_cmp_t cmp_func)
     }
 
     heap->cmp_func = cmp_func;
+    heap->set_index = set_index;
 
     return heap;
 }
@@ -95,6 +104,7 @@ int HeapPush(heap_t *heap, const void *data)
 
     if (0 == is_pushed)
     {
+        SetIndex(heap, HeapSize(heap) - 1);
         HeapifyUp(heap, HeapSize(heap) - 1);
     }
 
@@ -153,14 +163,44 @@ void *HeapRemove(heap_t *heap, const void *to_remove, is_match_heap_t is_match)
 
     if (is_found)
     {
-        removed = RemoveFromIndex(heap , --i, --size);
-        i -=  (i == size);
-        HeapifyUp(heap, i);
+        removed = HeapRemoveAt(heap, --i);
     }
     
     return removed;
 }
 
+
+void *HeapRemoveAt(heap_t *heap, size_t index)
+{
+    void *removed = NULL;
+    size_t size = 0;
+
+    assert(NULL != heap);
+
+    size = VectorGetSize(heap->d_vec);
+    assert(index < size);
+
+    removed = RemoveFromIndex(heap, index, --size);
+
+    /* the last element moved to index may belong above it */
+    if (index < size)
+    {
+        HeapifyUp(heap, index);
+    }
+
+    return removed;
+}
+
+
+void HeapUpdateAt(heap_t *heap, size_t index)
+{
+    assert(NULL != heap);
+    assert(index < HeapSize(heap));
+
+    HeapifyUp(heap, index);
+    HeapifyDown(heap, index, HeapSize(heap));
+}
+
 /******************************************************************************/
 static void HeapifyUp(heap_t *heap, size_t index)
 {
@@ -171,6 +211,8 @@ static void HeapifyUp(heap_t *heap, size_t index)
         if (IsNotHeapified(heap, parent_index, index))
         {
             Swap(heap->d_vec, index, parent_index);
+            SetIndex(heap, index);
+            SetIndex(heap, parent_index);
 
             HeapifyUp(heap, parent_index);
         }
@@ -197,6 +239,8 @@ static void HeapifyDown(heap_t *heap, size_t index, size_t size)
     if (above != index)
     {
         Swap(heap->d_vec, index, above);
+        SetIndex(heap, index);
+        SetIndex(heap, above);
 
         HeapifyDown(heap, above, size);
     }
@@ -220,6 +264,15 @@ static void Swap(d_vector_t *vec, size_t index1, size_t index2)
  }
 
 
+static void SetIndex(heap_t *heap, size_t index)
+{
+    if (NULL != heap->set_index)
+    {
+        heap->set_index(*(void**)VectorGetData(heap->d_vec, index), index);
+    }
+}
+
+
  static void *RemoveFromIndex(heap_t *heap, size_t index, size_t last_index)
 {
     void *data = NULL;
@@ -227,6 +280,16 @@ static void Swap(d_vector_t *vec, size_t index1, size_t index2)
     Swap(heap->d_vec, index, last_index);
     data = *(void **)VectorGetData(heap->d_vec, last_index);
     VectorPopBack(heap->d_vec);
+
+    if (NULL != heap->set_index)
+    {
+        heap->set_index(data, HEAP_NO_INDEX);
+    }
+    if (index < last_index)
+    {
+        SetIndex(heap, index);
+    }
+
     HeapifyDown(heap, index, last_index);
 
     return data;
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: Monotonic clock helpers (nanosecond resolution)
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#define _POSIX_C_SOURCE 199309L
+
+#include <assert.h> /* assert() */
+
+#include "mono_clock.h"
+
+/******************************************************************************/
+
+uint64_t MonoNowNs(void)
+{
+	struct timespec now;
+	
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	
+	return (uint64_t)now.tv_sec * MONO_NS_PER_SEC + (uint64_t)now.tv_nsec;
+}
+
+
+uint64_t MonoFromTime(time_t wall_time)
+{
+	struct timespec wall_now;
+	uint64_t mono_now = MonoNowNs();
+	uint64_t wall_now_ns = 0, wall_ns = 0;
+	
+	clock_gettime(CLOCK_REALTIME, &wall_now);
+	
+	wall_now_ns = (uint64_t)wall_now.tv_sec * MONO_NS_PER_SEC 
+											+ (uint64_t)wall_now.tv_nsec;
+	wall_ns = (uint64_t)wall_time * MONO_NS_PER_SEC;
+	
+	if (wall_ns >= wall_now_ns)
+	{
+		return mono_now + (wall_ns - wall_now_ns);
+	}
+	
+	return (wall_now_ns - wall_ns > mono_now) ? 0 
+											: mono_now - (wall_now_ns - wall_ns);
+}
+
+
+time_t MonoToTime(uint64_t mono_ns)
+{
+	uint64_t mono_now = MonoNowNs();
+	time_t wall_now = time(NULL);
+	
+	if (mono_ns >= mono_now)
+	{
+		return wall_now + (time_t)((mono_ns - mono_now) / MONO_NS_PER_SEC);
+	}
+	
+	return wall_now - (time_t)((mono_now - mono_ns) / MONO_NS_PER_SEC);
+}
+
+
+void MonoToTimespec(uint64_t ns, struct timespec *ts)
+{
+	assert(NULL != ts);
+	
+	ts->tv_sec = (time_t)(ns / MONO_NS_PER_SEC);
+	ts->tv_nsec = (long)(ns % MONO_NS_PER_SEC);
+}
+
+
+size_t MonoBucket(uint64_t ns)
+{
+	uint64_t us = ns / MONO_NS_PER_US;
+	size_t bucket = 0;
+	
+	while (0 != us && bucket < MONO_BUCKETS - 1)
+	{
+		us >>= 1;
+		++bucket;
+	}
+	
+	return bucket;
+}
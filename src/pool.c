@@ -0,0 +1,545 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: Fixed-size object pool implementation
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+
+#include <assert.h>  /* assert() */
+#include <stdint.h>  /* uint64_t */
+#include <stdlib.h>  /* malloc(), free() */
+#include <pthread.h> /* pthread_mutex_t, pthread_key_t, pthread_atfork() */
+
+#include "pool.h"
+
+/* thread caches - a thread caches objects of up to CACHE_POOLS pools */
+#define CACHE_POOLS 4
+#define CACHE_OBJS 32
+#define CACHE_BATCH (CACHE_OBJS / 2)
+
+/* the strictest alignment an object may need */
+typedef union
+{
+	void *ptr;
+	long num;
+	double real;
+	uint64_t u64;
+} align_t;
+
+typedef union chunk
+{
+	union chunk *next;
+	align_t align;
+} chunk_t;
+
+struct pool
+{
+	void *free_list;
+	chunk_t *chunks;
+	size_t chunk_objs;
+	int flags;
+	unsigned long id;
+	pool_t *next_locked;
+	pthread_mutex_t lock;
+	pool_stats_t stats;
+};
+
+typedef struct
+{
+	pool_t *pool;
+	unsigned long id;
+	size_t count;
+	void *objs[CACHE_OBJS];
+} thread_cache_t;
+
+static __thread thread_cache_t caches[CACHE_POOLS];
+static __thread unsigned long caches_epoch;
+
+/* the live locked pools - held over a fork with their locks. a cache entry
+   of a destroyed pool is detected by its id, the epoch tells a thread to look
+   for such entries */
+static pthread_mutex_t registry_lock = PTHREAD_MUTEX_INITIALIZER;
+static pool_t *registry = NULL;
+static unsigned long next_id = 1;
+static unsigned long destroy_epoch = 0;
+static pthread_once_t process_once = PTHREAD_ONCE_INIT;
+static pthread_key_t exit_key;
+
+static void Lock(pool_t *pool);
+static void Unlock(pool_t *pool);
+static int Grow(pool_t *pool);
+static void *Take(pool_t *pool);
+static void Give(pool_t *pool, void *obj);
+static thread_cache_t *GetCache(pool_t *pool);
+static void Refill(pool_t *pool, thread_cache_t *cache);
+static void Drain(pool_t *pool, thread_cache_t *cache, size_t objs);
+static void DropStaleCaches(void);
+static int IsRegistered(const pool_t *pool, unsigned long id);
+static void SetUpProcess(void);
+static void FlushOnExit(void *arg);
+static void ForkPrepare(void);
+static void ForkParent(void);
+static void ForkChild(void);
+
+/******************************************************************************/
+
+pool_t *PoolCreate(size_t obj_size, size_t chunk_objs, int flags)
+{
+	pool_t *pool = NULL;
+	
+	assert(0 != chunk_objs);
+	
+	pool = (pool_t *)malloc(sizeof(pool_t));
+	if (NULL == pool)
+	{
+		return NULL;
+	}
+	
+	/* a free object holds the free list link */
+	if (obj_size < sizeof(void *))
+	{
+		obj_size = sizeof(void *);
+	}
+	obj_size = (obj_size + sizeof(align_t) - 1) / sizeof(align_t)
+														* sizeof(align_t);
+	
+	if (flags & POOL_THREAD_CACHE)
+	{
+		flags |= POOL_LOCKED;
+	}
+	
+	pool->free_list = NULL;
+	pool->chunks = NULL;
+	pool->chunk_objs = chunk_objs;
+	pool->flags = flags;
+	pool->id = 0;
+	pool->next_locked = NULL;
+	pool->stats.obj_size = obj_size;
+	pool->stats.capacity = 0;
+	pool->stats.in_use = 0;
+	pool->stats.peak_in_use = 0;
+	pool->stats.chunks = 0;
+	pool->stats.allocs = 0;
+	pool->stats.frees = 0;
+	
+	if ((flags & POOL_LOCKED) && 0 != pthread_mutex_init(&pool->lock, NULL))
+	{
+		free(pool);
+	
+		return NULL;
+	}
+	
+	if (flags & POOL_LOCKED)
+	{
+		pthread_once(&process_once, SetUpProcess);
+	
+		pthread_mutex_lock(&registry_lock);
+		pool->id = next_id++;
+		pool->next_locked = registry;
+		registry = pool;
+		pthread_mutex_unlock(&registry_lock);
+	}
+	
+	return pool;
+}
+
+
+void PoolDestroy(pool_t *pool)
+{
+	assert(NULL != pool);
+	
+	if (pool->flags & POOL_THREAD_CACHE)
+	{
+		PoolFlushThreadCache(pool);
+	}
+	
+	if (pool->flags & POOL_LOCKED)
+	{
+		pool_t **iter = NULL;
+	
+		pthread_mutex_lock(&registry_lock);
+		for (iter = &registry; *iter != pool; iter = &(*iter)->next_locked)
+		{
+			/* empty loop */
+		}
+		*iter = pool->next_locked;
+		if (pool->flags & POOL_THREAD_CACHE)
+		{
+			__atomic_add_fetch(&destroy_epoch, 1, __ATOMIC_RELEASE);
+		}
+		pthread_mutex_unlock(&registry_lock);
+	}
+	
+	while (NULL != pool->chunks)
+	{
+		chunk_t *chunk = pool->chunks;
+	
+		pool->chunks = chunk->next;
+		free(chunk);
+	}
+	
+	if (pool->flags & POOL_LOCKED)
+	{
+		pthread_mutex_destroy(&pool->lock);
+	}
+	
+	free(pool);
+	pool = NULL;
+}
+
+
+void *PoolAlloc(pool_t *pool)
+{
+	void *obj = NULL;
+	
+	assert(NULL != pool);
+	
+	if (pool->flags & POOL_THREAD_CACHE)
+	{
+		thread_cache_t *cache = GetCache(pool);
+	
+		if (NULL != cache)
+		{
+			if (0 == cache->count)
+			{
+				Refill(pool, cache);
+			}
+	
+			return (0 == cache->count) ? NULL : cache->objs[--cache->count];
+		}
+	}
+	
+	Lock(pool);
+	obj = Take(pool);
+	Unlock(pool);
+	
+	return obj;
+}
+
+
+void PoolFree(pool_t *pool, void *obj)
+{
+	assert(NULL != pool);
+	
+	if (NULL == obj)
+	{
+		return;
+	}
+	
+	if (pool->flags & POOL_THREAD_CACHE)
+	{
+		thread_cache_t *cache = GetCache(pool);
+	
+		if (NULL != cache)
+		{
+			if (CACHE_OBJS == cache->count)
+			{
+				Drain(pool, cache, CACHE_BATCH);
+			}
+			cache->objs[cache->count++] = obj;
+	
+			return;
+		}
+	}
+	
+	Lock(pool);
+	Give(pool, obj);
+	Unlock(pool);
+}
+
+
+int PoolReserve(pool_t *pool, size_t objs)
+{
+	int status = 0;
+	
+	assert(NULL != pool);
+	
+	Lock(pool);
+	while (0 == status && pool->stats.capacity < objs)
+	{
+		status = Grow(pool);
+	}
+	Unlock(pool);
+	
+	return status;
+}
+
+
+void PoolFlushThreadCache(pool_t *pool)
+{
+	size_t i = 0;
+	
+	assert(NULL != pool);
+	
+	for (i = 0; i < CACHE_POOLS; ++i)
+	{
+		if (caches[i].pool == pool && caches[i].id == pool->id)
+		{
+			Drain(pool, &caches[i], caches[i].count);
+			caches[i].pool = NULL;
+		}
+	}
+}
+
+
+void PoolGetStats(pool_t *pool, pool_stats_t *stats)
+{
+	assert(NULL != pool);
+	assert(NULL != stats);
+	
+	Lock(pool);
+	*stats = pool->stats;
+	Unlock(pool);
+}
+
+/******************************************************************************/
+
+static void Lock(pool_t *pool)
+{
+	if (pool->flags & POOL_LOCKED)
+	{
+		pthread_mutex_lock(&pool->lock);
+	}
+}
+
+
+static void Unlock(pool_t *pool)
+{
+	if (pool->flags & POOL_LOCKED)
+	{
+		pthread_mutex_unlock(&pool->lock);
+	}
+}
+
+
+static int Grow(pool_t *pool)
+{
+	size_t obj_size = pool->stats.obj_size, i = 0;
+	chunk_t *chunk = (chunk_t *)malloc(sizeof(chunk_t)
+											+ obj_size * pool->chunk_objs);
+	char *objs = NULL;
+	
+	if (NULL == chunk)
+	{
+		return 1;
+	}
+	objs = (char *)(chunk + 1);
+	
+	chunk->next = pool->chunks;
+	pool->chunks = chunk;
+	
+	/* pushed from the end, the lowest address is taken first */
+	for (i = pool->chunk_objs; 0 < i; --i)
+	{
+		void **obj = (void **)(objs + (i - 1) * obj_size);
+	
+		*obj = pool->free_list;
+		pool->free_list = obj;
+	}
+	
+	pool->stats.capacity += pool->chunk_objs;
+	++pool->stats.chunks;
+	
+	return 0;
+}
+
+
+static void *Take(pool_t *pool)
+{
+	void **obj = NULL;
+	
+	if (NULL == pool->free_list && 0 != Grow(pool))
+	{
+		return NULL;
+	}
+	
+	obj = (void **)pool->free_list;
+	pool->free_list = *obj;
+	
+	++pool->stats.allocs;
+	++pool->stats.in_use;
+	if (pool->stats.in_use > pool->stats.peak_in_use)
+	{
+		pool->stats.peak_in_use = pool->stats.in_use;
+	}
+	
+	return obj;
+}
+
+
+static void Give(pool_t *pool, void *obj)
+{
+	*(void **)obj = pool->free_list;
+	pool->free_list = obj;
+	
+	++pool->stats.frees;
+	--pool->stats.in_use;
+}
+
+
+static thread_cache_t *GetCache(pool_t *pool)
+{
+	size_t i = 0;
+	
+	if (caches_epoch != __atomic_load_n(&destroy_epoch, __ATOMIC_ACQUIRE))
+	{
+		DropStaleCaches();
+	}
+	
+	for (i = 0; i < CACHE_POOLS; ++i)
+	{
+		if (caches[i].pool == pool && caches[i].id == pool->id)
+		{
+			return &caches[i];
+		}
+	}
+	
+	for (i = 0; i < CACHE_POOLS; ++i)
+	{
+		if (NULL == caches[i].pool)
+		{
+			/* the key only needs a non-NULL value to run FlushOnExit */
+			pthread_setspecific(exit_key, caches);
+			caches[i].pool = pool;
+			caches[i].id = pool->id;
+			caches[i].count = 0;
+	
+			return &caches[i];
+		}
+	}
+	
+	/* every cache is taken - the pool is used directly */
+	return NULL;
+}
+
+
+static void Refill(pool_t *pool, thread_cache_t *cache)
+{
+	Lock(pool);
+	while (CACHE_BATCH > cache->count)
+	{
+		void *obj = Take(pool);
+	
+		if (NULL == obj)
+		{
+			break;
+		}
+		cache->objs[cache->count++] = obj;
+	}
+	Unlock(pool);
+}
+
+
+static void Drain(pool_t *pool, thread_cache_t *cache, size_t objs)
+{
+	Lock(pool);
+	while (0 < objs-- && 0 < cache->count)
+	{
+		Give(pool, cache->objs[--cache->count]);
+	}
+	Unlock(pool);
+}
+
+
+static void DropStaleCaches(void)
+{
+	size_t i = 0;
+	
+	pthread_mutex_lock(&registry_lock);
+	for (i = 0; i < CACHE_POOLS; ++i)
+	{
+		if (NULL != caches[i].pool && !IsRegistered(caches[i].pool
+															, caches[i].id))
+		{
+			/* its objects were freed with its chunks */
+			caches[i].pool = NULL;
+			caches[i].count = 0;
+		}
+	}
+	caches_epoch = __atomic_load_n(&destroy_epoch, __ATOMIC_ACQUIRE);
+	pthread_mutex_unlock(&registry_lock);
+}
+
+
+static int IsRegistered(const pool_t *pool, unsigned long id)
+{
+	const pool_t *iter = registry;
+	
+	/* the address of a destroyed pool may be reused, the id is not */
+	while (NULL != iter && !(iter == pool && iter->id == id))
+	{
+		iter = iter->next_locked;
+	}
+	
+	return (NULL != iter);
+}
+
+
+static void SetUpProcess(void)
+{
+	pthread_key_create(&exit_key, FlushOnExit);
+	pthread_atfork(ForkPrepare, ForkParent, ForkChild);
+}
+
+
+static void FlushOnExit(void *arg)
+{
+	size_t i = 0;
+	
+	(void)arg;
+	
+	pthread_mutex_lock(&registry_lock);
+	for (i = 0; i < CACHE_POOLS; ++i)
+	{
+		if (NULL != caches[i].pool && IsRegistered(caches[i].pool
+															, caches[i].id))
+		{
+			Drain(caches[i].pool, &caches[i], caches[i].count);
+		}
+		caches[i].pool = NULL;
+		caches[i].count = 0;
+	}
+	pthread_mutex_unlock(&registry_lock);
+}
+
+
+/* the registry lock first, as in FlushOnExit - no lock is held by another
+   thread over a fork */
+static void ForkPrepare(void)
+{
+	pool_t *iter = NULL;
+	
+	pthread_mutex_lock(&registry_lock);
+	for (iter = registry; NULL != iter; iter = iter->next_locked)
+	{
+		pthread_mutex_lock(&iter->lock);
+	}
+}
+
+
+static void ForkParent(void)
+{
+	pool_t *iter = NULL;
+	
+	for (iter = registry; NULL != iter; iter = iter->next_locked)
+	{
+		pthread_mutex_unlock(&iter->lock);
+	}
+	pthread_mutex_unlock(&registry_lock);
+}
+
+
+/* the locks are owned by the thread that forked, not by this one. the objects
+   cached by the other threads stay out of the pools */
+static void ForkChild(void)
+{
+	pool_t *iter = NULL;
+	
+	for (iter = registry; NULL != iter; iter = iter->next_locked)
+	{
+		pthread_mutex_init(&iter->lock, NULL);
+	}
+	pthread_mutex_init(&registry_lock, NULL);
+}
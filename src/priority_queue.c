@@ -22,6 +22,12 @@ struct pq
 /******************************************************************************/
 
 pq_t *PQCreate(cmp_priority_t cmp_priority)
+{
+	return PQCreateIndexed(cmp_priority, NULL);
+}
+
+
+pq_t *PQCreateIndexed(cmp_priority_t cmp_priority, pq_set_index_t set_index)
 {
 	pq_t *pq = (pq_t*)malloc(sizeof(pq_t));
 	
@@ -30,7 +36,7 @@ pq_t *PQCreate(cmp_priority_t cmp_priority)
 		return NULL;
 	}
 	
-	pq->pqueue = HeapCreate(cmp_priority);
+	pq->pqueue = HeapCreateIndexed(cmp_priority, set_index);
 	
 	if (NULL == pq->pqueue)
 	{
@@ -114,3 +120,18 @@ void* PQErase(pq_t *pqueue, void *to_del, is_match_pq_t is_match)
 	return HeapRemove(pqueue->pqueue, to_del, is_match);
 }
 
+
+void *PQEraseAt(pq_t *pqueue, size_t index)
+{
+	assert (NULL != pqueue);
+
+	return HeapRemoveAt(pqueue->pqueue, index);
+}
+
+
+void PQUpdateAt(pq_t *pqueue, size_t index)
+{
+	assert (NULL != pqueue);
+
+	HeapUpdateAt(pqueue->pqueue, index);
+}
@@ -2,31 +2,205 @@
  * Author: Meital Kozhidov
  * Reviewer: Keren Robbins
  * Date: August 15th, 2021
- 
+
  * Description: Scheduler implemantation
  *
  * Infinity Labs OL108
 *******************************************************************************/
 
-#include <stdlib.h> /* malloc(), free() */
-#include <assert.h> /* assert() */
+#define _GNU_SOURCE
+
+#include <stdlib.h>       /* malloc(), free() */
+#include <assert.h>       /* assert() */
+#include <errno.h>        /* errno, EINTR */
+#include <limits.h>       /* INT_MAX */
+#include <pthread.h>      /* pthread_mutex_t, pthread_self() */
+#include <stdint.h>       /* uint64_t, uint32_t */
+#include <string.h>       /* memset() */
+#include <unistd.h>       /* read(), write(), close() */
+#include <sys/epoll.h>    /* epoll_create1(), epoll_ctl(), epoll_wait() */
+#include <sys/eventfd.h>  /* eventfd() */
+#include <sys/timerfd.h>  /* timerfd_create(), timerfd_settime() */
 
-#include "priority_queue.h"
+#include "dheap.h"
+#include "dynamic_vector.h" /* handle table */
+#include "executor.h"       /* worker threads */
+#include "mono_clock.h"     /* MonoNowNs(), MonoToTimespec() */
+#include "pool.h"           /* task pool */
+#include "timing_wheel.h"
 #include "task.h"
 #include "scheduler.h"
 
+/* resolution of the timing wheel backend */
+#define WHEEL_TICK_NS MONO_NS_PER_MS
+#define SLOTS_INIT_CAPACITY 16
+#define TASKS_PER_CHUNK 64
+#define MSGS_PER_CHUNK 64
+#define NO_START ((uint64_t)-1)
+#define NO_FREE_SLOT ((uint32_t)-1)
+#define MAX_EVENTS 16
+
+/* task flags - a running task is out of the queue until its operation ends */
+#define TASK_RUNNING 1
+#define TASK_REMOVED 2
+#define TASK_RESCHEDULED 4
+
+/* the times a run is measured against, read by the thread of SchedRun -
+   another thread may reschedule the task while it runs */
+#ifdef SCHED_STATS
+#define RUN_DUE(task) TaskGetStartTimeNs(task)
+#define RUN_INTERVAL(task) TaskGetIntervalNs(task)
+#else
+#define RUN_DUE(task) 0
+#define RUN_INTERVAL(task) 0
+#endif
+
+typedef struct
+{
+	int (*push)(sched_t *sched, task_t *task);
+	task_t *(*pop_due)(sched_t *sched, uint64_t now_ns);
+	uint64_t (*next_start)(const sched_t *sched);
+	void (*erase)(sched_t *sched, task_t *task);
+	void (*update)(sched_t *sched, task_t *task);
+	size_t (*size)(const sched_t *sched);
+} sched_queue_ops_t;
+
+/* a request of another thread, applied by the thread running SchedRun */
+typedef enum
+{
+	MSG_ADD,
+	MSG_REMOVE,
+	MSG_RESCHEDULE,
+	MSG_DONE         /* a worker ran the task */
+} msg_kind_t;
+
+typedef struct sched_msg
+{
+	struct sched_msg *next;
+	msg_kind_t kind;
+	task_t *task;
+	sched_handle_t handle;
+	uint64_t start_ns;
+	uint64_t interval_ns;
+	int is_repeated;
+} sched_msg_t;
+
+/* a file descriptor watched by SchedAddFd */
+typedef struct sched_watch
+{
+	struct sched_watch *next;
+	int fd;
+	sched_fd_func_t fd_func;
+	void *arg;
+	int is_removed;
+	int is_kept;		/* closed before it was removed, see DropWatch */
+} sched_watch_t;
+
+/* handle -> task, a handle is (generation << 32 | slot index) */
+typedef struct
+{
+	task_t *task;
+	uint32_t generation;
+	uint32_t next_free;
+#ifdef SCHED_STATS
+	sched_stats_t stats;
+#endif
+} handle_slot_t;
+
 struct scheduler
 {
-	pq_t *pq;
+	const sched_queue_ops_t *ops;
+	dheap_t *heap;
+	timing_wheel_t *wheel;
+	d_vector_t *slots;
+	pthread_mutex_t slots_lock;
+	pool_t *tasks;
+	pool_t *msgs;
+	sched_msg_t *inbox;
+	uint32_t free_slot;
+	exec_t *exec;
+	size_t workers;
+	size_t in_flight;
+	pthread_t owner;			/* the thread that changes the queue itself */
 	int stop_flag;
+	int is_waiting;
+	int is_wake_posted;
+	uint64_t wait_deadline;
+	int timer_fd;
+	int wake_fd;
+	int epoll_fd;
+	sched_watch_t *watches;
+	size_t n_watches;
+#ifdef SCHED_STATS
+	sched_stats_t stats;	/* of all the tasks, under slots_lock */
+#endif
 };
 
-static int StartTimeCmp(const void *task1, const void *task2);
-static int IsSameTask(const void *task, const void *uuid);
+static void SetTaskIndex(void *task, size_t index);
+static sched_handle_t AddTask(sched_t *sched, task_t *task);
+static task_t *FindTask(sched_t *sched, sched_handle_t handle);
+static sched_handle_t AllocHandle(sched_t *sched, task_t *task);
+static void FreeHandle(sched_t *sched, sched_handle_t handle);
+static void DestroyTask(sched_t *sched, task_t *task);
+static void RemoveTask(sched_t *sched, task_t *task);
+static void RescheduleTask(sched_t *sched, task_t *task, uint64_t start_ns
+		, uint64_t interval_ns);
+static void StartTask(sched_t *sched, task_t *task);
+static int RunOperation(sched_t *sched, task_t *task, uint64_t due_ns
+		, uint64_t interval_ns);
+static void RunOnWorker(void *param, void *item);
+static void FinishTask(sched_t *sched, task_t *task, int is_repeated);
+static int IsOtherThread(const sched_t *sched);
+static int Post(sched_t *sched, msg_kind_t kind, task_t *task
+		, sched_handle_t handle, uint64_t start_ns, uint64_t interval_ns);
+static void PushMsg(sched_t *sched, sched_msg_t *msg);
+static void DrainInbox(sched_t *sched);
+static void ApplyMsg(sched_t *sched, const sched_msg_t *msg);
+static void WaitUntil(sched_t *sched, uint64_t wake_ns);
+static int TimeoutMs(uint64_t wake_ns);
+static void PollFds(sched_t *sched);
+static void HandleEvents(sched_t *sched, const struct epoll_event *events
+		, int n_events);
+static int WatchFd(sched_t *sched, int fd, void *data);
+static int DropWatch(sched_t *sched, sched_watch_t *watch);
+static void FreeWatches(sched_t *sched, int is_all);
+static void Wake(sched_t *sched);
+static void DrainFd(int fd);
+#ifdef SCHED_STATS
+static void RecordRun(sched_t *sched, const task_t *task, uint64_t due_ns
+		, uint64_t interval_ns, uint64_t begin_ns, uint64_t end_ns);
+static void AddRun(sched_stats_t *stats, uint64_t late_ns, uint64_t run_ns
+		, uint64_t interval_ns);
+#endif
+
+static int HeapPushTask(sched_t *sched, task_t *task);
+static task_t *HeapPopDue(sched_t *sched, uint64_t now_ns);
+static uint64_t HeapNextStart(const sched_t *sched);
+static void HeapEraseTask(sched_t *sched, task_t *task);
+static void HeapUpdateTask(sched_t *sched, task_t *task);
+static size_t HeapQueueSize(const sched_t *sched);
+
+static int WheelPushTask(sched_t *sched, task_t *task);
+static task_t *WheelPopDue(sched_t *sched, uint64_t now_ns);
+static uint64_t WheelNextStart(const sched_t *sched);
+static void WheelEraseTask(sched_t *sched, task_t *task);
+static void WheelUpdateTask(sched_t *sched, task_t *task);
+static size_t WheelQueueSize(const sched_t *sched);
+
+static const sched_queue_ops_t heap_ops = {HeapPushTask, HeapPopDue
+		, HeapNextStart, HeapEraseTask, HeapUpdateTask, HeapQueueSize};
+static const sched_queue_ops_t wheel_ops = {WheelPushTask, WheelPopDue
+		, WheelNextStart, WheelEraseTask, WheelUpdateTask, WheelQueueSize};
 
 /******************************************************************************/
 
 sched_t *SchedCreate(void)
+{
+	return SchedCreateBackend(SCHED_HEAP);
+}
+
+
+sched_t *SchedCreateBackend(sched_backend_t backend)
 {
 	sched_t *sched = (sched_t*)malloc(sizeof(sched_t));
 	
@@ -35,17 +209,53 @@ sched_t *SchedCreate(void)
 		return NULL;
 	}
 	
-	sched->pq = PQCreate(StartTimeCmp);
-	
-	if (NULL == sched->pq)
+	memset(sched, 0, sizeof(sched_t));
+	if (0 != pthread_mutex_init(&sched->slots_lock, NULL))
 	{
 		free(sched);
-		sched = NULL;
-		
+	
 		return NULL;
 	}
+	sched->timer_fd = -1;
+	sched->wake_fd = -1;
+	sched->epoll_fd = -1;
+	sched->free_slot = NO_FREE_SLOT;
+	
+	if (SCHED_TIMING_WHEEL == backend)
+	{
+		sched->ops = &wheel_ops;
+		sched->wheel = TWCreate(WHEEL_TICK_NS, MonoNowNs());
+	}
+	else
+	{
+		sched->ops = &heap_ops;
+		sched->heap = DHeapCreate(DHEAP_DEFAULT_ARITY, SetTaskIndex);
+	}
+	
+	/* the creating thread changes the queue until a SchedRun takes over */
+	sched->owner = pthread_self();
+	sched->slots = VectorCreate(sizeof(handle_slot_t), SLOTS_INIT_CAPACITY);
+	/* other threads allocate tasks and requests too */
+	sched->tasks = PoolCreate(TaskSize(), TASKS_PER_CHUNK, POOL_THREAD_CACHE);
+	sched->msgs = PoolCreate(sizeof(sched_msg_t), MSGS_PER_CHUNK
+													, POOL_THREAD_CACHE);
+	sched->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+	sched->wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	sched->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	
+	/* one epoll_wait covers the timer, the wake-ups and the watched fds */
+	if ((NULL == sched->heap && NULL == sched->wheel) || NULL == sched->slots
+			|| NULL == sched->tasks || NULL == sched->msgs
+			|| -1 == sched->timer_fd
+			|| -1 == sched->wake_fd
+			|| -1 == sched->epoll_fd
+			|| 0 != WatchFd(sched, sched->timer_fd, &sched->timer_fd)
+			|| 0 != WatchFd(sched, sched->wake_fd, &sched->wake_fd))
+	{
+		SchedDestroy(sched);
 	
-	sched->stop_flag = 0;
+		return NULL;
+	}
 	
 	return sched;
 }
@@ -55,12 +265,59 @@ void SchedDestroy(sched_t *sched)
 {
 	assert (NULL != sched);
 	
-	SchedClear(sched);
-	PQDestroy(sched->pq);
-	sched->pq = NULL;
+	if (NULL != sched->slots && NULL != sched->msgs)
+	{
+		SchedClear(sched);
+	}
+	
+	if (NULL != sched->slots)
+	{
+		VectorDestroy(sched->slots);
+		sched->slots = NULL;
+	}
+	
+	if (NULL != sched->msgs)
+	{
+		PoolDestroy(sched->msgs);
+		sched->msgs = NULL;
+	}
+	
+	if (NULL != sched->tasks)
+	{
+		PoolDestroy(sched->tasks);
+		sched->tasks = NULL;
+	}
 	
+	if (NULL != sched->heap)
+	{
+		DHeapDestroy(sched->heap);
+		sched->heap = NULL;
+	}
+	
+	if (NULL != sched->wheel)
+	{
+		TWDestroy(sched->wheel);
+		sched->wheel = NULL;
+	}
+	
+	if (-1 != sched->timer_fd)
+	{
+		close(sched->timer_fd);
+	}
+	if (-1 != sched->wake_fd)
+	{
+		close(sched->wake_fd);
+	}
+	if (-1 != sched->epoll_fd)
+	{
+		close(sched->epoll_fd);
+	}
+	
+	FreeWatches(sched, 1);
+	
+	pthread_mutex_destroy(&sched->slots_lock);
 	free(sched);
-	sched = NULL;	
+	sched = NULL;
 }
 
 
@@ -68,7 +325,7 @@ int SchedIsEmpty(const sched_t *sched)
 {
 	assert (NULL != sched);
 	
-	return (PQIsEmpty(sched->pq));
+	return (0 == sched->ops->size(sched));
 }
 
 
@@ -76,96 +333,289 @@ size_t SchedSize(const sched_t *sched)
 {
 	assert (NULL != sched);
 	
-	return (PQSize(sched->pq));
+	return (sched->ops->size(sched));
 }
 
 
 void SchedClear(sched_t *sched)
 {
+	size_t i = 0;
+	
 	assert(NULL != sched);
 	
-	while (!PQIsEmpty(sched->pq))
+	/* tasks added by other threads are queued first */
+	DrainInbox(sched);
+	
+	/* every queued task owns a slot - running tasks are left to SchedRun */
+	for (i = 0; i < VectorGetSize(sched->slots); ++i)
 	{
-		TaskDestroy(PQDequeue(sched->pq));
+		task_t *task = NULL;
+	
+		pthread_mutex_lock(&sched->slots_lock);
+		task = ((handle_slot_t*)VectorGetData(sched->slots, i))->task;
+		pthread_mutex_unlock(&sched->slots_lock);
+	
+		if (NULL != task && !(TaskGetFlags(task) & TASK_RUNNING))
+		{
+			sched->ops->erase(sched, task);
+			DestroyTask(sched, task);
+		}
 	}
 }
 
 
-uuid_t SchedAddTask(sched_t *sched, sched_operation_func_t task_func
+sched_handle_t SchedAddTask(sched_t *sched, sched_operation_func_t task_func
 		, time_t start_time, time_t time_interval, void *args
 		, sched_cleanup_func_t cleanup)
 {
-	uuid_t ret_uid = bad_uuid;
-	task_t *task = NULL;
-	
 	assert (NULL != sched);
 	assert(NULL != task_func);
 	assert(((time_t)-1) != start_time);
 	assert(((time_t)-1) != time_interval);
 	assert(NULL != cleanup);
 	
-	task = TaskCreate(task_func, start_time, time_interval, args, cleanup);
+	return AddTask(sched, TaskCreateFromPool(sched->tasks, task_func
+			, MonoFromTime(start_time), (uint64_t)time_interval * MONO_NS_PER_SEC
+			, args, cleanup));
+}
+
+
+sched_handle_t SchedAddTaskNs(sched_t *sched, sched_operation_func_t task_func
+		, uint64_t start_ns, uint64_t interval_ns, void *args
+		, sched_cleanup_func_t cleanup)
+{
+	assert (NULL != sched);
+	assert(NULL != task_func);
+	assert(NULL != cleanup);
 	
-	if (NULL == task)
+	return AddTask(sched, TaskCreateFromPool(sched->tasks, task_func, start_ns
+											, interval_ns, args, cleanup));
+}
+
+
+int SchedRemoveTask(sched_t *sched, sched_handle_t handle)
+{
+	task_t *task_to_rem = NULL;
+	
+	assert (NULL != sched);
+	
+	if (IsOtherThread(sched))
 	{
-		return bad_uuid;
+		return (NULL == FindTask(sched, handle)) ? 1
+								: Post(sched, MSG_REMOVE, NULL, handle, 0, 0);
 	}
 	
-	if (0 == PQEnqueue(sched->pq, task))
+	/* the handle of a task added by another thread is returned with its add
+	   queued - not in the queue yet */
+	DrainInbox(sched);
+	task_to_rem = FindTask(sched, handle);
+	
+	if (NULL == task_to_rem)
 	{
-		ret_uid = TaskGetUID(task);
+		return 1;
 	}
 	
-	return ret_uid; 
+	RemoveTask(sched, task_to_rem);
+	
+	return 0;
 }
 
 
-int SchedRemoveTask(sched_t *sched, uuid_t uuid)
+int SchedRescheduleTask(sched_t *sched, sched_handle_t handle
+		, uint64_t start_ns, uint64_t interval_ns)
 {
-	task_t *task_to_rem = NULL;
-	int is_found  = 0;
+	task_t *task = NULL;
 	
 	assert (NULL != sched);
 	
-	task_to_rem = PQErase(sched->pq, &uuid, IsSameTask);
+	if (IsOtherThread(sched))
+	{
+		return (NULL == FindTask(sched, handle)) ? 1
+				: Post(sched, MSG_RESCHEDULE, NULL, handle, start_ns
+																, interval_ns);
+	}
 	
-	is_found = (NULL == task_to_rem);
+	/* as in SchedRemoveTask */
+	DrainInbox(sched);
+	task = FindTask(sched, handle);
 	
-	if (0 == is_found)
+	if (NULL == task)
 	{
-		TaskDestroy(task_to_rem);
+		return 1;
 	}
 	
-	return is_found;
+	RescheduleTask(sched, task, start_ns, interval_ns);
+	
+	return 0;
 }
 
 
 void SchedRun(sched_t *sched)
 {
+	pthread_t self = pthread_self();
+	
 	assert (NULL != sched);
 	
-	sched->stop_flag = 0;
+	__atomic_store_n(&sched->stop_flag, 0, __ATOMIC_RELAXED);
+	__atomic_store(&sched->owner, &self, __ATOMIC_SEQ_CST);
 	
-	while ( !sched->stop_flag && !SchedIsEmpty(sched) )
+	DrainInbox(sched);
+	
+	/* without the workers, operations run on this thread */
+	if (0 != sched->workers)
 	{
-		task_t *curr_task = (task_t*)PQDequeue(sched->pq);
-		
-		while (TaskGetStartTime(curr_task) > time(NULL))
-		{
-			/* empty loop */
-		}
-		
-		if (0 != TaskRunOperation(curr_task))
+		sched->exec = ExecCreate(sched->workers, RunOnWorker, sched);
+	}
+	
+	while (!__atomic_load_n(&sched->stop_flag, __ATOMIC_RELAXED)
+			&& (!SchedIsEmpty(sched) || 0 != sched->in_flight
+				|| 0 != sched->n_watches))
+	{
+		uint64_t now = MonoNowNs();
+		task_t *curr_task = sched->ops->pop_due(sched, now);
+	
+		if (NULL == curr_task)
 		{
-			curr_task = TaskUpdateStartTime(curr_task);
-			PQEnqueue(sched->pq, curr_task); 
+			uint64_t next_start = sched->ops->next_start(sched);
+	
+			/* sleeps until the deadline, a new task, a finished task or a
+			   stop - re-check */
+			if (next_start > now)
+			{
+				WaitUntil(sched, next_start);
+			}
+			DrainInbox(sched);
+			continue;
 		}
-		
-		else
+	
+		StartTask(sched, curr_task);
+		PollFds(sched);
+		DrainInbox(sched);
+	}
+	
+	/* the workers finish the running tasks, they are re-queued below */
+	if (NULL != sched->exec)
+	{
+		ExecDestroy(sched->exec);
+		sched->exec = NULL;
+	}
+	
+	/* requests posted while the loop ran are applied before returning - the
+	   later ones by the next SchedRun, SchedClear or SchedDestroy */
+	DrainInbox(sched);
+}
+
+
+int SchedAddFd(sched_t *sched, int fd, sched_fd_func_t fd_func, void *arg)
+{
+	sched_watch_t *watch = NULL;
+	
+	assert (NULL != sched);
+	assert (NULL != fd_func);
+	
+	watch = (sched_watch_t*)malloc(sizeof(sched_watch_t));
+	if (NULL == watch)
+	{
+		return 1;
+	}
+	
+	watch->fd = fd;
+	watch->fd_func = fd_func;
+	watch->arg = arg;
+	watch->is_removed = 0;
+	watch->is_kept = 0;
+	
+	if (0 != WatchFd(sched, fd, watch))
+	{
+		free(watch);
+	
+		return 1;
+	}
+	
+	watch->next = sched->watches;
+	sched->watches = watch;
+	++sched->n_watches;
+	
+	return 0;
+}
+
+
+int SchedRemoveFd(sched_t *sched, int fd)
+{
+	sched_watch_t *watch = NULL;
+	
+	assert (NULL != sched);
+	
+	for (watch = sched->watches; NULL != watch; watch = watch->next)
+	{
+		if (fd == watch->fd && !watch->is_removed)
 		{
-			TaskDestroy(curr_task);
+			/* freed after the events that may still point to it */
+			return DropWatch(sched, watch);
 		}
 	}
+	
+	return 1;
+}
+
+
+void SchedSetWorkers(sched_t *sched, size_t workers)
+{
+	assert (NULL != sched);
+	
+	sched->workers = workers;
+}
+
+
+int SchedGetStats(sched_t *sched, sched_stats_t *stats)
+{
+	assert (NULL != sched);
+	assert (NULL != stats);
+	
+#ifdef SCHED_STATS
+	pthread_mutex_lock(&sched->slots_lock);
+	*stats = sched->stats;
+	pthread_mutex_unlock(&sched->slots_lock);
+	
+	return 0;
+#else
+	memset(stats, 0, sizeof(sched_stats_t));
+	
+	return 1;
+#endif
+}
+
+
+int SchedGetTaskStats(sched_t *sched, sched_handle_t handle
+		, sched_stats_t *stats)
+{
+#ifdef SCHED_STATS
+	handle_slot_t *slot = NULL;
+	int status = 1;
+#endif
+	
+	assert (NULL != sched);
+	assert (NULL != stats);
+	
+	memset(stats, 0, sizeof(sched_stats_t));
+	
+#ifdef SCHED_STATS
+	pthread_mutex_lock(&sched->slots_lock);
+	slot = (handle_slot_t*)VectorGetData(sched->slots, (uint32_t)handle);
+	if (NULL != slot && NULL != slot->task
+			&& slot->generation == (uint32_t)(handle >> 32))
+	{
+		*stats = slot->stats;
+		status = 0;
+	}
+	pthread_mutex_unlock(&sched->slots_lock);
+	
+	return status;
+#else
+	(void)handle;
+	
+	return 1;
+#endif
 }
 
 
@@ -173,7 +623,8 @@ int SchedStop(sched_t *sched)
 {
 	assert (NULL != sched);
 	
-	sched->stop_flag = 1;
+	__atomic_store_n(&sched->stop_flag, 1, __ATOMIC_RELAXED);
+	Wake(sched);
 	
 	return 0;
 }
@@ -181,20 +632,714 @@ int SchedStop(sched_t *sched)
 
 /******************************************************************************/
 
-static int StartTimeCmp(const void *task1, const void *task2)
+static void SetTaskIndex(void *task, size_t index)
+{
+	TaskSetQueueIndex((task_t*)task, index);
+}
+
+
+static sched_handle_t AddTask(sched_t *sched, task_t *task)
+{
+	sched_handle_t handle = SCHED_BAD_HANDLE;
+	
+	if (NULL == task)
+	{
+		return SCHED_BAD_HANDLE;
+	}
+	
+	handle = AllocHandle(sched, task);
+	
+	if (SCHED_BAD_HANDLE != handle && IsOtherThread(sched))
+	{
+		if (0 == Post(sched, MSG_ADD, task, handle, TaskGetStartTimeNs(task)
+																	, 0))
+		{
+			return handle;
+		}
+	}
+	else if (SCHED_BAD_HANDLE != handle && 0 == sched->ops->push(sched, task))
+	{
+		return handle;
+	}
+	
+	DestroyTask(sched, task);
+	
+	return SCHED_BAD_HANDLE;
+}
+
+
+static task_t *FindTask(sched_t *sched, sched_handle_t handle)
+{
+	uint32_t index = (uint32_t)handle;
+	handle_slot_t *slot = NULL;
+	task_t *task = NULL;
+	
+	pthread_mutex_lock(&sched->slots_lock);
+	slot = (handle_slot_t*)VectorGetData(sched->slots, index);
+	
+	/* a stale handle carries an older generation than its slot */
+	if (NULL != slot && slot->generation == (uint32_t)(handle >> 32))
+	{
+		task = slot->task;
+	}
+	pthread_mutex_unlock(&sched->slots_lock);
+	
+	return task;
+}
+
+
+static sched_handle_t AllocHandle(sched_t *sched, task_t *task)
+{
+	handle_slot_t *slot = NULL;
+	sched_handle_t handle = SCHED_BAD_HANDLE;
+	uint32_t index = 0;
+	
+	pthread_mutex_lock(&sched->slots_lock);
+	index = sched->free_slot;
+	
+	if (NO_FREE_SLOT == index)
+	{
+		handle_slot_t new_slot;
+	
+		new_slot.task = NULL;
+		new_slot.generation = 1;
+		new_slot.next_free = NO_FREE_SLOT;
+	
+		index = (uint32_t)VectorGetSize(sched->slots);
+		if (0 != VectorPushBack(sched->slots, &new_slot))
+		{
+			pthread_mutex_unlock(&sched->slots_lock);
+	
+			return SCHED_BAD_HANDLE;
+		}
+	}
+	
+	slot = (handle_slot_t*)VectorGetData(sched->slots, index);
+	sched->free_slot = slot->next_free;
+	slot->task = task;
+	slot->next_free = NO_FREE_SLOT;
+#ifdef SCHED_STATS
+	memset(&slot->stats, 0, sizeof(sched_stats_t));
+#endif
+	handle = ((uint64_t)slot->generation << 32) | index;
+	pthread_mutex_unlock(&sched->slots_lock);
+	
+	TaskSetHandle(task, handle);
+	
+	return handle;
+}
+
+
+static void FreeHandle(sched_t *sched, sched_handle_t handle)
+{
+	uint32_t index = (uint32_t)handle;
+	handle_slot_t *slot = NULL;
+	
+	pthread_mutex_lock(&sched->slots_lock);
+	slot = (handle_slot_t*)VectorGetData(sched->slots, index);
+	
+	/* the next generation turns every copy of the handle stale */
+	slot->task = NULL;
+	slot->generation = (0 == (uint32_t)(slot->generation + 1)) ? 1
+													: slot->generation + 1;
+	slot->next_free = sched->free_slot;
+	sched->free_slot = index;
+	pthread_mutex_unlock(&sched->slots_lock);
+}
+
+
+static void DestroyTask(sched_t *sched, task_t *task)
+{
+	if (SCHED_BAD_HANDLE != TaskGetHandle(task))
+	{
+		FreeHandle(sched, TaskGetHandle(task));
+	}
+	
+	TaskDestroy(task);
+}
+
+
+static void RemoveTask(sched_t *sched, task_t *task)
+{
+	unsigned int flags = TaskGetFlags(task);
+	
+	/* a running task is destroyed when its operation returns */
+	if (flags & TASK_RUNNING)
+	{
+		TaskSetFlags(task, flags | TASK_REMOVED);
+	
+		return;
+	}
+	
+	sched->ops->erase(sched, task);
+	DestroyTask(sched, task);
+}
+
+
+static void RescheduleTask(sched_t *sched, task_t *task, uint64_t start_ns
+		, uint64_t interval_ns)
+{
+	unsigned int flags = TaskGetFlags(task);
+	
+	TaskSetTimesNs(task, start_ns, interval_ns);
+	
+	if (flags & TASK_RUNNING)
+	{
+		TaskSetFlags(task, flags | TASK_RESCHEDULED);
+	}
+	else
+	{
+		sched->ops->update(sched, task);
+	}
+}
+
+
+static void StartTask(sched_t *sched, task_t *task)
+{
+	sched_msg_t *done = NULL;
+	
+	TaskSetFlags(task, TASK_RUNNING);
+	
+	/* the completion comes back through the inbox, the task is out of the
+	   queue until then - so it never runs twice at once */
+	if (NULL != sched->exec)
+	{
+		done = (sched_msg_t*)PoolAlloc(sched->msgs);
+	
+		if (NULL != done)
+		{
+			done->kind = MSG_DONE;
+			done->task = task;
+			done->handle = TaskGetHandle(task);
+			done->start_ns = RUN_DUE(task);
+			done->interval_ns = RUN_INTERVAL(task);
+			done->is_repeated = 0;
+	
+			if (0 == ExecSubmit(sched->exec, done))
+			{
+				++sched->in_flight;
+	
+				return;
+			}
+	
+			PoolFree(sched->msgs, done);
+		}
+	}
+	
+	/* no workers (or no memory for the request) - runs here */
+	FinishTask(sched, task, RunOperation(sched, task, RUN_DUE(task)
+													, RUN_INTERVAL(task)));
+}
+
+
+static int RunOperation(sched_t *sched, task_t *task, uint64_t due_ns
+		, uint64_t interval_ns)
+{
+#ifdef SCHED_STATS
+	uint64_t begin = MonoNowNs();
+	int is_repeated = TaskRunOperation(task);
+	
+	RecordRun(sched, task, due_ns, interval_ns, begin, MonoNowNs());
+	
+	return is_repeated;
+#else
+	(void)sched;
+	(void)due_ns;
+	(void)interval_ns;
+	
+	return TaskRunOperation(task);
+#endif
+}
+
+
+static void RunOnWorker(void *param, void *item)
+{
+	sched_msg_t *done = (sched_msg_t*)item;
+	
+	done->is_repeated = RunOperation((sched_t*)param, done->task
+									, done->start_ns, done->interval_ns);
+	PushMsg((sched_t*)param, done);
+}
+
+
+static void FinishTask(sched_t *sched, task_t *task, int is_repeated)
+{
+	unsigned int flags = TaskGetFlags(task);
+	
+	TaskSetFlags(task, 0);
+	
+	if (0 != is_repeated && !(flags & TASK_REMOVED))
+	{
+		if (!(flags & TASK_RESCHEDULED))
+		{
+			task = TaskUpdateStartTime(task);
+		}
+		if (0 == sched->ops->push(sched, task))
+		{
+			return;
+		}
+	}
+	
+	DestroyTask(sched, task);
+}
+
+
+static int IsOtherThread(const sched_t *sched)
+{
+	pthread_t owner;
+	
+	/* not only while SchedRun runs - a call as it starts or returns would
+	   change the queue under its DrainInbox */
+	__atomic_load(&sched->owner, &owner, __ATOMIC_SEQ_CST);
+	
+	return !pthread_equal(owner, pthread_self());
+}
+
+
+static int Post(sched_t *sched, msg_kind_t kind, task_t *task
+		, sched_handle_t handle, uint64_t start_ns, uint64_t interval_ns)
+{
+	sched_msg_t *msg = (sched_msg_t*)PoolAlloc(sched->msgs);
+	
+	if (NULL == msg)
+	{
+		return 1;
+	}
+	
+	msg->kind = kind;
+	msg->task = task;
+	msg->handle = handle;
+	msg->start_ns = start_ns;
+	msg->interval_ns = interval_ns;
+	msg->is_repeated = 0;
+	
+	PushMsg(sched, msg);
+	
+	return 0;
+}
+
+
+static void PushMsg(sched_t *sched, sched_msg_t *msg)
+{
+	/* the run loop may free msg as soon as it is pushed */
+	int is_remove = (MSG_REMOVE == msg->kind);
+	uint64_t start_ns = msg->start_ns;
+	
+	/* lock-free push, the run loop takes the whole stack at once */
+	msg->next = __atomic_load_n(&sched->inbox, __ATOMIC_RELAXED);
+	while (!__atomic_compare_exchange_n(&sched->inbox, &msg->next, msg, 1
+								, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+	{
+		/* msg->next was reloaded - retry */
+	}
+	
+	/* only a deadline before the current wait needs to cut it short (a
+	   finished task has start_ns 0), and only the first of several such
+	   requests writes the eventfd */
+	if (__atomic_load_n(&sched->is_waiting, __ATOMIC_SEQ_CST)
+			&& !is_remove
+			&& start_ns < __atomic_load_n(&sched->wait_deadline
+														, __ATOMIC_RELAXED)
+			&& !__atomic_exchange_n(&sched->is_wake_posted, 1
+														, __ATOMIC_RELAXED))
+	{
+		Wake(sched);
+	}
+}
+
+
+static void DrainInbox(sched_t *sched)
+{
+	sched_msg_t *msgs = NULL, *ordered = NULL;
+	
+	if (NULL == __atomic_load_n(&sched->inbox, __ATOMIC_RELAXED))
+	{
+		return;
+	}
+	
+	msgs = __atomic_exchange_n(&sched->inbox, NULL, __ATOMIC_ACQUIRE);
+	
+	/* the stack is newest first - reversed to keep the posting order */
+	while (NULL != msgs)
+	{
+		sched_msg_t *next = msgs->next;
+	
+		msgs->next = ordered;
+		ordered = msgs;
+		msgs = next;
+	}
+	
+	while (NULL != ordered)
+	{
+		sched_msg_t *next = ordered->next;
+	
+		ApplyMsg(sched, ordered);
+		PoolFree(sched->msgs, ordered);
+		ordered = next;
+	}
+}
+
+
+static void ApplyMsg(sched_t *sched, const sched_msg_t *msg)
+{
+	task_t *task = NULL;
+	
+	switch (msg->kind)
+	{
+		case MSG_ADD:
+			if (0 != sched->ops->push(sched, msg->task))
+			{
+				DestroyTask(sched, msg->task);
+			}
+			break;
+	
+		case MSG_REMOVE:
+			task = FindTask(sched, msg->handle);
+			if (NULL != task)
+			{
+				RemoveTask(sched, task);
+			}
+			break;
+	
+		case MSG_RESCHEDULE:
+			task = FindTask(sched, msg->handle);
+			if (NULL != task)
+			{
+				RescheduleTask(sched, task, msg->start_ns, msg->interval_ns);
+			}
+			break;
+	
+		case MSG_DONE:
+			--sched->in_flight;
+			FinishTask(sched, msg->task, msg->is_repeated);
+			break;
+	}
+}
+
+
+static void WaitUntil(sched_t *sched, uint64_t wake_ns)
+{
+	struct itimerspec deadline;
+	struct epoll_event events[MAX_EVENTS];
+	int n_events = 0;
+	int timeout_ms = -1;
+	
+	memset(&deadline, 0, sizeof(deadline));
+	
+	/* nothing queued (tasks are running) - the zero deadline disarms */
+	if (NO_START != wake_ns)
+	{
+		MonoToTimespec(wake_ns, &deadline.it_value);
+	}
+	
+	/* without the timer epoll_wait times out itself, or SchedRun would spin */
+	if (-1 == timerfd_settime(sched->timer_fd, TFD_TIMER_ABSTIME, &deadline
+																	, NULL))
+	{
+		timeout_ms = TimeoutMs(wake_ns);
+	}
+	
+	__atomic_store_n(&sched->wait_deadline, wake_ns, __ATOMIC_RELAXED);
+	__atomic_store_n(&sched->is_wake_posted, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&sched->is_waiting, 1, __ATOMIC_SEQ_CST);
+	
+	/* a request posted before is_waiting was set did not wake us */
+	if (!__atomic_load_n(&sched->stop_flag, __ATOMIC_RELAXED)
+			&& NULL == __atomic_load_n(&sched->inbox, __ATOMIC_SEQ_CST))
+	{
+		n_events = epoll_wait(sched->epoll_fd, events, MAX_EVENTS
+															, timeout_ms);
+	}
+	
+	__atomic_store_n(&sched->is_waiting, 0, __ATOMIC_RELEASE);
+	
+	HandleEvents(sched, events, n_events);
+}
+
+
+static int TimeoutMs(uint64_t wake_ns)
+{
+	uint64_t now = MonoNowNs();
+	uint64_t ms = 0;
+	
+	if (NO_START == wake_ns)
+	{
+		return -1;
+	}
+	if (wake_ns <= now)
+	{
+		return 0;
+	}
+	
+	/* rounded up - waking before the deadline finds nothing due */
+	ms = (wake_ns - now + MONO_NS_PER_MS - 1) / MONO_NS_PER_MS;
+	
+	return (ms > INT_MAX) ? INT_MAX : (int)ms;
+}
+
+
+static void PollFds(sched_t *sched)
+{
+	struct epoll_event events[MAX_EVENTS];
+	
+	/* between due tasks - a busy queue does not hold back the watched fds */
+	if (0 != sched->n_watches)
+	{
+		HandleEvents(sched, events, epoll_wait(sched->epoll_fd, events
+															, MAX_EVENTS, 0));
+	}
+}
+
+
+static void HandleEvents(sched_t *sched, const struct epoll_event *events
+		, int n_events)
+{
+	uint64_t now = MonoNowNs();
+	int i = 0;
+	
+	for (i = 0; i < n_events; ++i)
+	{
+		void *data = events[i].data.ptr;
+	
+		if (&sched->timer_fd == data)
+		{
+			DrainFd(sched->timer_fd);
+		}
+		else if (&sched->wake_fd == data)
+		{
+			DrainFd(sched->wake_fd);
+		}
+		else
+		{
+			sched_watch_t *watch = (sched_watch_t*)data;
+	
+			/* an earlier callback of this batch may have removed it, or the
+			   callback itself (to close the fd) */
+			if (!watch->is_removed
+					&& 0 == watch->fd_func(watch->arg, watch->fd, now)
+					&& !watch->is_removed)
+			{
+				DropWatch(sched, watch);
+			}
+		}
+	}
+	
+	FreeWatches(sched, 0);
+}
+
+
+static int WatchFd(sched_t *sched, int fd, void *data)
+{
+	struct epoll_event event;
+	
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN;
+	event.data.ptr = data;
+	
+	return (0 != epoll_ctl(sched->epoll_fd, EPOLL_CTL_ADD, fd, &event));
+}
+
+
+static int DropWatch(sched_t *sched, sched_watch_t *watch)
+{
+	struct epoll_event event;
+	int status = 0;
+	
+	memset(&event, 0, sizeof(event));
+	status = epoll_ctl(sched->epoll_fd, EPOLL_CTL_DEL, watch->fd, &event);
+	watch->is_removed = 1;
+	--sched->n_watches;
+	
+	/* epoll watches the open file, not the fd - closed first, a copy of it
+	   (a fork) keeps it in the set, reporting events for this watch. it is
+	   kept until SchedDestroy */
+	watch->is_kept = (0 != status);
+	
+	return (0 == status) ? 0 : -1;
+}
+
+
+static void FreeWatches(sched_t *sched, int is_all)
 {
-	assert (NULL != task1);
-	assert (NULL != task2);
+	sched_watch_t **where = &sched->watches;
+	
+	while (NULL != *where)
+	{
+		sched_watch_t *watch = *where;
 	
-	return TaskGetStartTime((task_t*)task1) - TaskGetStartTime((task_t*)task2);
+		if (is_all || (watch->is_removed && !watch->is_kept))
+		{
+			*where = watch->next;
+			free(watch);
+		}
+		else
+		{
+			where = &watch->next;
+		}
+	}
 }
 
 
-static int IsSameTask(const void *task, const void *uuid)
+static void Wake(sched_t *sched)
 {
-	assert (NULL != task);
-	assert (NULL != uuid);
+	uint64_t one = 1;
 	
-	return IsSameUuid(*(uuid_t*)task,*(uuid_t*)uuid);
+	/* write() is async-signal-safe, so SchedStop may run in a handler */
+	while (-1 == write(sched->wake_fd, &one, sizeof(one)) && EINTR == errno)
+	{
+		/* retry */
+	}
 }
 
+
+static void DrainFd(int fd)
+{
+	uint64_t count = 0;
+	
+	/* timer and eventfd reads are a single 8 byte counter */
+	while (-1 == read(fd, &count, sizeof(count)) && EINTR == errno)
+	{
+		/* retry */
+	}
+}
+
+#ifdef SCHED_STATS
+static void RecordRun(sched_t *sched, const task_t *task, uint64_t due_ns
+		, uint64_t interval_ns, uint64_t begin_ns, uint64_t end_ns)
+{
+	uint64_t late = (begin_ns > due_ns) ? begin_ns - due_ns : 0;
+	handle_slot_t *slot = NULL;
+	
+	/* workers record too - and the slots move when other threads add */
+	pthread_mutex_lock(&sched->slots_lock);
+	AddRun(&sched->stats, late, end_ns - begin_ns, interval_ns);
+	slot = (handle_slot_t*)VectorGetData(sched->slots
+										, (uint32_t)TaskGetHandle(task));
+	if (NULL != slot && task == slot->task)
+	{
+		AddRun(&slot->stats, late, end_ns - begin_ns, interval_ns);
+	}
+	pthread_mutex_unlock(&sched->slots_lock);
+}
+
+
+static void AddRun(sched_stats_t *stats, uint64_t late_ns, uint64_t run_ns
+		, uint64_t interval_ns)
+{
+	++stats->runs;
+	stats->late_ns_total += late_ns;
+	stats->run_ns_total += run_ns;
+	stats->late_ns_max = (late_ns > stats->late_ns_max) ? late_ns
+														: stats->late_ns_max;
+	stats->run_ns_max = (run_ns > stats->run_ns_max) ? run_ns
+														: stats->run_ns_max;
+	++stats->lateness[MonoBucket(late_ns)];
+	++stats->run_time[MonoBucket(run_ns)];
+	
+	/* a one-shot task has no interval to overrun */
+	if (0 != interval_ns && run_ns > interval_ns)
+	{
+		++stats->overruns;
+		if (run_ns - interval_ns > stats->overrun_ns_max)
+		{
+			stats->overrun_ns_max = run_ns - interval_ns;
+		}
+	}
+}
+#endif
+
+/****************************** heap backend **********************************/
+
+static int HeapPushTask(sched_t *sched, task_t *task)
+{
+	return DHeapPush(sched->heap, TaskGetStartTimeNs(task), task);
+}
+
+
+static task_t *HeapPopDue(sched_t *sched, uint64_t now_ns)
+{
+	if (DHeapIsEmpty(sched->heap) || DHeapPeekKey(sched->heap) > now_ns)
+	{
+		return NULL;
+	}
+	
+	return (task_t*)DHeapPop(sched->heap);
+}
+
+
+static uint64_t HeapNextStart(const sched_t *sched)
+{
+	return DHeapIsEmpty(sched->heap) ? NO_START : DHeapPeekKey(sched->heap);
+}
+
+
+static void HeapEraseTask(sched_t *sched, task_t *task)
+{
+	DHeapRemoveAt(sched->heap, TaskGetQueueIndex(task));
+}
+
+
+static void HeapUpdateTask(sched_t *sched, task_t *task)
+{
+	DHeapUpdateAt(sched->heap, TaskGetQueueIndex(task)
+											, TaskGetStartTimeNs(task));
+}
+
+
+static size_t HeapQueueSize(const sched_t *sched)
+{
+	return DHeapSize(sched->heap);
+}
+
+/************************** timing wheel backend ******************************/
+
+static int WheelPushTask(sched_t *sched, task_t *task)
+{
+	tw_node_t *node = TWInsert(sched->wheel, task, TaskGetStartTimeNs(task));
+	
+	TaskSetQueueNode(task, node);
+	
+	return (NULL == node);
+}
+
+
+static task_t *WheelPopDue(sched_t *sched, uint64_t now_ns)
+{
+	task_t *task = (task_t*)TWPopExpired(sched->wheel, now_ns);
+	
+	if (NULL != task)
+	{
+		TaskSetQueueNode(task, NULL);
+	}
+	
+	return task;
+}
+
+
+static uint64_t WheelNextStart(const sched_t *sched)
+{
+	uint64_t next = TWNextExpiry(sched->wheel);
+	
+	return (TW_NO_EXPIRY == next) ? NO_START : next;
+}
+
+
+static void WheelEraseTask(sched_t *sched, task_t *task)
+{
+	TWRemove(sched->wheel, (tw_node_t*)TaskGetQueueNode(task));
+	TaskSetQueueNode(task, NULL);
+}
+
+
+static void WheelUpdateTask(sched_t *sched, task_t *task)
+{
+	/* moved in place - a new node could fail and lose the task */
+	TWUpdate(sched->wheel, (tw_node_t*)TaskGetQueueNode(task)
+												, TaskGetStartTimeNs(task));
+}
+
+
+static size_t WheelQueueSize(const sched_t *sched)
+{
+	return TWSize(sched->wheel);
+}
@@ -2,7 +2,7 @@
  * Author: Meital Kozhidov
  * Reviewer: Keren Robbins
  * Date: August 15th, 2021
- 
+
  * Description: Task implemantation
  *
  * Infinity Labs OL108
@@ -11,69 +11,107 @@
 #include <assert.h> /* assert() */
 #include <stdlib.h> /* malloc() */
 
+#include "mono_clock.h" /* MonoFromTime(), MonoToTime() */
+#include "pool.h"       /* PoolAlloc(), PoolFree() */
 #include "task.h"
 
 struct task
 {
 	uuid_t uid;
-	time_t start_time;
-	time_t time_interval;
+	uint64_t start_ns;
+	uint64_t interval_ns;
 	task_operation_func_t operation;
 	task_cleanup_func_t cleanup;
 	void *args;
+	void *queue_node;
+	size_t queue_index;
+	uint64_t handle;
+	unsigned int flags;
+	pool_t *pool;
 };
 
+static void TaskFree(task_t *task);
+
 /******************************************************************************/
 
 task_t *TaskCreate(task_operation_func_t operation, time_t start_time
 		, time_t time_interval, void *args, task_cleanup_func_t cleanup)
+{
+	assert(((time_t)-1) != start_time);
+	assert(((time_t)-1) != time_interval);
+	
+	return TaskCreateNs(operation, MonoFromTime(start_time)
+			, (uint64_t)time_interval * MONO_NS_PER_SEC, args, cleanup);
+}
+
+
+task_t *TaskCreateNs(task_operation_func_t operation, uint64_t start_ns
+		, uint64_t interval_ns, void *args, task_cleanup_func_t cleanup)
+{
+	return TaskCreateFromPool(NULL, operation, start_ns, interval_ns, args
+																, cleanup);
+}
+
+
+task_t *TaskCreateFromPool(pool_t *pool, task_operation_func_t operation
+		, uint64_t start_ns, uint64_t interval_ns, void *args
+		, task_cleanup_func_t cleanup)
 {
 	task_t *task = NULL;
 	
 	assert(NULL != operation);
-	assert(((time_t)-1) != start_time);
-	assert(((time_t)-1) != time_interval);
 	assert(NULL != cleanup);
 	
-	task = (task_t*)malloc(sizeof(task_t));
+	task = (task_t*)((NULL == pool) ? malloc(sizeof(task_t)) 
+									: PoolAlloc(pool));
 	
 	if (NULL == task)
 	{
 		return NULL;
 	}
 	
-	task->uid = UuidCreate();
-	if (IsSameUuid(task->uid, bad_uuid))
-	{
-		free(task);
-		task = NULL;
-
-		return NULL;
-	}
-	task->start_time = start_time;
-	task->time_interval = time_interval;
+	task->pool = pool;
+	/* created when asked for - the scheduler knows its tasks by handles */
+	task->uid = bad_uuid;
+	task->start_ns = start_ns;
+	task->interval_ns = interval_ns;
 	task->operation = operation;
 	task->cleanup = cleanup;
 	task->args = args;
+	task->queue_node = NULL;
+	task->queue_index = (size_t)-1;
+	task->handle = 0;
+	task->flags = 0;
 	
 	return task;
 }
 
 
+size_t TaskSize(void)
+{
+	return sizeof(task_t);
+}
+
+
 void TaskDestroy(task_t *task)
 {
 	assert (NULL != task);
 	
 	task->cleanup(task->args);
-	free(task);
+	TaskFree(task);
 	task = NULL;
 }
 
 
-uuid_t TaskGetUID(const task_t *task)
+uuid_t TaskGetUID(task_t *task)
 {
 	assert (NULL != task);
 	
+	if (IsSameUuid(task->uid, bad_uuid))
+	{
+		task->uid = UuidCreate();
+	}
+	
 	return task->uid;
 }
 
@@ -82,7 +120,23 @@ time_t TaskGetStartTime(const task_t *task)
 {
 	assert (NULL != task);
 	
-	return task->start_time;
+	return MonoToTime(task->start_ns);
+}
+
+
+uint64_t TaskGetStartTimeNs(const task_t *task)
+{
+	assert (NULL != task);
+	
+	return task->start_ns;
+}
+
+
+uint64_t TaskGetIntervalNs(const task_t *task)
+{
+	assert (NULL != task);
+	
+	return task->interval_ns;
 }
 
 
@@ -98,7 +152,94 @@ task_t *TaskUpdateStartTime(task_t *task)
 {
 	assert (NULL != task);
 	
-	task->start_time += task->time_interval;
+	task->start_ns += task->interval_ns;
 	
 	return task;
 }
+
+
+void TaskSetQueueNode(task_t *task, void *node)
+{
+	assert (NULL != task);
+	
+	task->queue_node = node;
+}
+
+
+void *TaskGetQueueNode(const task_t *task)
+{
+	assert (NULL != task);
+	
+	return task->queue_node;
+}
+
+
+void TaskSetQueueIndex(task_t *task, size_t index)
+{
+	assert (NULL != task);
+	
+	task->queue_index = index;
+}
+
+
+size_t TaskGetQueueIndex(const task_t *task)
+{
+	assert (NULL != task);
+	
+	return task->queue_index;
+}
+
+
+void TaskSetHandle(task_t *task, uint64_t handle)
+{
+	assert (NULL != task);
+	
+	task->handle = handle;
+}
+
+
+uint64_t TaskGetHandle(const task_t *task)
+{
+	assert (NULL != task);
+	
+	return task->handle;
+}
+
+
+void TaskSetTimesNs(task_t *task, uint64_t start_ns, uint64_t interval_ns)
+{
+	assert (NULL != task);
+	
+	task->start_ns = start_ns;
+	task->interval_ns = interval_ns;
+}
+
+
+void TaskSetFlags(task_t *task, unsigned int flags)
+{
+	assert (NULL != task);
+	
+	task->flags = flags;
+}
+
+
+unsigned int TaskGetFlags(const task_t *task)
+{
+	assert (NULL != task);
+	
+	return task->flags;
+}
+
+/******************************************************************************/
+
+static void TaskFree(task_t *task)
+{
+	if (NULL == task->pool)
+	{
+		free(task);
+	}
+	else
+	{
+		PoolFree(task->pool, task);
+	}
+}
@@ -0,0 +1,441 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: Hierarchical timing wheel implementation
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+
+#include <assert.h> /* assert() */
+#include <stdlib.h> /* malloc(), free() */
+
+#include "pool.h"
+#include "timing_wheel.h"
+
+#define LEVELS 4
+#define SLOT_BITS 8
+#define SLOTS (1 << SLOT_BITS)
+#define SLOT_MASK ((uint64_t)(SLOTS - 1))
+/* the furthest tick a slot can represent, relative to the current tick */
+#define MAX_DELTA (((uint64_t)1 << (SLOT_BITS * LEVELS)) - 1)
+/* the level of a node that already expired */
+#define EXPIRED LEVELS
+#define NODES_PER_CHUNK 64
+
+struct tw_node
+{
+	tw_node_t *prev;
+	tw_node_t *next;
+	void *data;
+	uint64_t expiry_tick;
+	int level;
+};
+
+struct timing_wheel
+{
+	tw_node_t slots[LEVELS][SLOTS];
+	tw_node_t expired;
+	pool_t *nodes;
+	uint64_t base_ns;
+	uint64_t tick_ns;
+	uint64_t current_tick;
+	size_t size;
+	size_t pending;
+	size_t level_pending[LEVELS];
+};
+
+static void ListInit(tw_node_t *head);
+static int ListIsEmpty(const tw_node_t *head);
+static void ListPushBack(tw_node_t *head, tw_node_t *node);
+static void ListUnlink(tw_node_t *node);
+static void Place(timing_wheel_t *wheel, tw_node_t *node);
+static void Detach(timing_wheel_t *wheel, tw_node_t *node);
+static void Cascade(timing_wheel_t *wheel, int level);
+static void Advance(timing_wheel_t *wheel, uint64_t now_ns);
+static uint64_t NsToTick(const timing_wheel_t *wheel, uint64_t ns);
+static uint64_t TickToNs(const timing_wheel_t *wheel, uint64_t tick);
+
+/******************************************************************************/
+
+timing_wheel_t *TWCreate(uint64_t tick_ns, uint64_t now_ns)
+{
+	timing_wheel_t *wheel = NULL;
+	int level = 0, slot = 0;
+
+	assert(0 != tick_ns);
+
+	wheel = (timing_wheel_t *)malloc(sizeof(timing_wheel_t));
+	if (NULL == wheel)
+	{
+		return NULL;
+	}
+
+	wheel->nodes = PoolCreate(sizeof(tw_node_t), NODES_PER_CHUNK, 0);
+	if (NULL == wheel->nodes)
+	{
+		free(wheel);
+
+		return NULL;
+	}
+
+	for (level = 0; level < LEVELS; ++level)
+	{
+		for (slot = 0; slot < SLOTS; ++slot)
+		{
+			ListInit(&wheel->slots[level][slot]);
+		}
+	}
+	ListInit(&wheel->expired);
+
+	wheel->base_ns = now_ns;
+	wheel->tick_ns = tick_ns;
+	wheel->current_tick = 0;
+	wheel->size = 0;
+	wheel->pending = 0;
+	for (level = 0; level < LEVELS; ++level)
+	{
+		wheel->level_pending[level] = 0;
+	}
+
+	return wheel;
+}
+
+
+void TWDestroy(timing_wheel_t *wheel)
+{
+	assert(NULL != wheel);
+
+	/* the nodes are freed with their pool */
+	PoolDestroy(wheel->nodes);
+	free(wheel);
+	wheel = NULL;
+}
+
+
+tw_node_t *TWInsert(timing_wheel_t *wheel, void *data, uint64_t deadline_ns)
+{
+	tw_node_t *node = NULL;
+
+	assert(NULL != wheel);
+
+	node = (tw_node_t *)PoolAlloc(wheel->nodes);
+	if (NULL == node)
+	{
+		return NULL;
+	}
+
+	node->data = data;
+	node->expiry_tick = NsToTick(wheel, deadline_ns);
+
+	Place(wheel, node);
+	++wheel->size;
+
+	return node;
+}
+
+
+void *TWRemove(timing_wheel_t *wheel, tw_node_t *node)
+{
+	void *data = NULL;
+
+	assert(NULL != wheel);
+	assert(NULL != node);
+
+	Detach(wheel, node);
+	--wheel->size;
+
+	data = node->data;
+	PoolFree(wheel->nodes, node);
+
+	return data;
+}
+
+
+void TWUpdate(timing_wheel_t *wheel, tw_node_t *node, uint64_t deadline_ns)
+{
+	assert(NULL != wheel);
+	assert(NULL != node);
+
+	/* the same node - nothing to allocate */
+	Detach(wheel, node);
+	node->expiry_tick = NsToTick(wheel, deadline_ns);
+	Place(wheel, node);
+}
+
+
+void *TWPopExpired(timing_wheel_t *wheel, uint64_t now_ns)
+{
+	tw_node_t *node = NULL;
+	void *data = NULL;
+
+	assert(NULL != wheel);
+
+	Advance(wheel, now_ns);
+
+	if (ListIsEmpty(&wheel->expired))
+	{
+		return NULL;
+	}
+
+	node = wheel->expired.next;
+	ListUnlink(node);
+	--wheel->size;
+
+	data = node->data;
+	PoolFree(wheel->nodes, node);
+
+	return data;
+}
+
+
+uint64_t TWNextExpiry(const timing_wheel_t *wheel)
+{
+	uint64_t i = 0, block = 0;
+	int level = 0;
+
+	assert(NULL != wheel);
+
+	if (!ListIsEmpty(&wheel->expired))
+	{
+		return TickToNs(wheel, wheel->expired.next->expiry_tick);
+	}
+
+	if (0 == wheel->pending)
+	{
+		return TW_NO_EXPIRY;
+	}
+
+	/* every timer of the lowest level is due before any timer above it */
+	for (i = 0; i < SLOTS; ++i)
+	{
+		if (!ListIsEmpty(&wheel->slots[0][(wheel->current_tick + i) & SLOT_MASK]))
+		{
+			return TickToNs(wheel, wheel->current_tick + i);
+		}
+	}
+
+	for (level = 1; level < LEVELS; ++level)
+	{
+		uint64_t low_mask = ((uint64_t)1 << (SLOT_BITS * level)) - 1;
+
+		/* the block of the current tick is cascaded only on its first tick */
+		block = wheel->current_tick >> (SLOT_BITS * level);
+		block += (0 != (wheel->current_tick & low_mask));
+
+		for (i = 0; i < SLOTS; ++i)
+		{
+			if (!ListIsEmpty(&wheel->slots[level][(block + i) & SLOT_MASK]))
+			{
+				return TickToNs(wheel, (block + i) << (SLOT_BITS * level));
+			}
+		}
+	}
+
+	return TW_NO_EXPIRY;
+}
+
+
+size_t TWSize(const timing_wheel_t *wheel)
+{
+	assert(NULL != wheel);
+
+	return wheel->size;
+}
+
+
+int TWIsEmpty(const timing_wheel_t *wheel)
+{
+	assert(NULL != wheel);
+
+	return (0 == wheel->size);
+}
+
+/******************************************************************************/
+
+static void Place(timing_wheel_t *wheel, tw_node_t *node)
+{
+	uint64_t delta = 0, slot_tick = 0;
+	int level = 0;
+
+	if (node->expiry_tick < wheel->current_tick)
+	{
+		node->level = EXPIRED;
+		ListPushBack(&wheel->expired, node);
+
+		return;
+	}
+
+	delta = node->expiry_tick - wheel->current_tick;
+	slot_tick = node->expiry_tick;
+
+	/* too far for the wheel - parked in the last level and cascaded again */
+	if (delta > MAX_DELTA)
+	{
+		delta = MAX_DELTA;
+		slot_tick = wheel->current_tick + MAX_DELTA;
+	}
+
+	while (level < LEVELS - 1
+			&& delta >= ((uint64_t)1 << (SLOT_BITS * (level + 1))))
+	{
+		++level;
+	}
+
+	node->level = level;
+	ListPushBack(&wheel->slots[level]
+					[(slot_tick >> (SLOT_BITS * level)) & SLOT_MASK], node);
+	++wheel->pending;
+	++wheel->level_pending[level];
+}
+
+
+static void Detach(timing_wheel_t *wheel, tw_node_t *node)
+{
+	if (EXPIRED != node->level)
+	{
+		--wheel->pending;
+		--wheel->level_pending[node->level];
+	}
+
+	ListUnlink(node);
+}
+
+
+static void Cascade(timing_wheel_t *wheel, int level)
+{
+	uint64_t index = (wheel->current_tick >> (SLOT_BITS * level)) & SLOT_MASK;
+	tw_node_t *head = &wheel->slots[level][index];
+	tw_node_t list;
+
+	/* detach the slot first, nodes may be placed back in it */
+	ListInit(&list);
+	if (!ListIsEmpty(head))
+	{
+		list.next = head->next;
+		list.prev = head->prev;
+		list.next->prev = &list;
+		list.prev->next = &list;
+		ListInit(head);
+	}
+
+	while (!ListIsEmpty(&list))
+	{
+		tw_node_t *node = list.next;
+
+		ListUnlink(node);
+		--wheel->pending;
+		--wheel->level_pending[level];
+		Place(wheel, node);
+	}
+
+	if (0 == index && level + 1 < LEVELS)
+	{
+		Cascade(wheel, level + 1);
+	}
+}
+
+
+static void Advance(timing_wheel_t *wheel, uint64_t now_ns)
+{
+	uint64_t target = (now_ns < wheel->base_ns) ? 0
+									: (now_ns - wheel->base_ns) / wheel->tick_ns;
+
+	while (wheel->current_tick <= target)
+	{
+		tw_node_t *head = NULL;
+		int level = 0;
+
+		if (0 == wheel->pending)
+		{
+			wheel->current_tick = target + 1;
+			break;
+		}
+
+		/* nothing is due before the next cascade of the lowest used level */
+		while (0 == wheel->level_pending[level])
+		{
+			++level;
+		}
+		if (0 < level)
+		{
+			uint64_t step = (uint64_t)1 << (SLOT_BITS * level);
+			uint64_t boundary = (wheel->current_tick + step - 1) & ~(step - 1);
+
+			if (boundary != wheel->current_tick)
+			{
+				wheel->current_tick = (boundary > target) ? target + 1 
+																: boundary;
+				continue;
+			}
+		}
+
+		if (0 == (wheel->current_tick & SLOT_MASK))
+		{
+			Cascade(wheel, 1);
+		}
+
+		head = &wheel->slots[0][wheel->current_tick & SLOT_MASK];
+		while (!ListIsEmpty(head))
+		{
+			tw_node_t *node = head->next;
+
+			ListUnlink(node);
+			--wheel->pending;
+			--wheel->level_pending[0];
+			node->level = EXPIRED;
+			ListPushBack(&wheel->expired, node);
+		}
+
+		++wheel->current_tick;
+	}
+}
+
+
+static uint64_t NsToTick(const timing_wheel_t *wheel, uint64_t ns)
+{
+	/* rounded up, so a timer never expires before its deadline */
+	if (ns <= wheel->base_ns)
+	{
+		return 0;
+	}
+
+	return (ns - wheel->base_ns + wheel->tick_ns - 1) / wheel->tick_ns;
+}
+
+
+static uint64_t TickToNs(const timing_wheel_t *wheel, uint64_t tick)
+{
+	return wheel->base_ns + tick * wheel->tick_ns;
+}
+
+
+static void ListInit(tw_node_t *head)
+{
+	head->next = head;
+	head->prev = head;
+}
+
+
+static int ListIsEmpty(const tw_node_t *head)
+{
+	return (head->next == head);
+}
+
+
+static void ListPushBack(tw_node_t *head, tw_node_t *node)
+{
+	node->prev = head->prev;
+	node->next = head;
+	head->prev->next = node;
+	head->prev = node;
+}
+
+
+static void ListUnlink(tw_node_t *node)
+{
+	node->prev->next = node->next;
+	node->next->prev = node->prev;
+	node->next = node;
+	node->prev = node;
+}
@@ -23,11 +23,10 @@ uuid_t UuidCreate(void)
 		return bad_uuid;
 	}
 	
-	uid.id = counter;
+	/* tasks are created by several threads */
+	uid.id = __atomic_fetch_add(&counter, 1, __ATOMIC_RELAXED);
 	uid.pid = getpid();
 	
-	++counter;
-	
 	return uid;
 }
 
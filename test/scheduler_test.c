@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: scheduler - requests of other threads: the owner removes and
+ *              reschedules tasks as soon as another thread's SchedAddTaskNs
+ *              returns their handles (the add may still be queued), with
+ *              each backend
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <stdio.h>      /* printf() */
+#include <sched.h>      /* sched_yield() */
+#include <pthread.h>    /* pthread_create(), pthread_join() */
+
+#include "mono_clock.h" /* MonoNowNs(), MONO_NS_PER_SEC */
+#include "scheduler.h"
+
+#define TASKS 100000
+#define EMPTY ((sched_handle_t)-1)
+
+static int Operation(void *args);
+static void Cleanup(void *args);
+static void *Add(void *arg);
+static int TestBackend(const char *name, sched_backend_t backend);
+
+/* the handle passed from the adding thread to the owner */
+static sched_handle_t passed = EMPTY;
+/******************************************************************************/
+int main(void)
+{
+    int failed = 0;
+
+    failed |= TestBackend("heap", SCHED_HEAP);
+    failed |= TestBackend("timing wheel", SCHED_TIMING_WHEEL);
+
+    return failed;
+}
+
+/******************************************************************************/
+static int TestBackend(const char *name, sched_backend_t backend)
+{
+    sched_t *sched = SchedCreateBackend(backend);
+    pthread_t adder;
+    size_t i = 0, not_found = 0;
+
+    if (NULL == sched || 0 != pthread_create(&adder, NULL, Add, sched))
+    {
+        printf("%s: setup failed\n", name);
+        return 1;
+    }
+
+    /* this thread created it - the owner */
+    for (i = 0; i < TASKS; ++i)
+    {
+        sched_handle_t handle = EMPTY;
+
+        while (EMPTY == (handle = __atomic_exchange_n(&passed, EMPTY,
+                                                        __ATOMIC_ACQUIRE)))
+        {
+            sched_yield();
+        }
+
+        if (0 == i % 2)
+        {
+            not_found += (0 != SchedRescheduleTask(sched, handle,
+                            MonoNowNs() + 2 * MONO_NS_PER_SEC, 0));
+        }
+        not_found += (0 != SchedRemoveTask(sched, handle));
+    }
+    pthread_join(adder, NULL);
+
+    printf("%s: %s (not found %lu, left %lu)\n", name,
+            (0 == not_found && 0 == SchedSize(sched)) ? "PASS" : "FAIL",
+            (unsigned long)not_found, (unsigned long)SchedSize(sched));
+
+    i = not_found + SchedSize(sched);
+    SchedDestroy(sched);
+
+    return (0 != i);
+}
+
+
+static void *Add(void *arg)
+{
+    sched_t *sched = (sched_t *)arg;
+    size_t i = 0;
+
+    for (i = 0; i < TASKS; ++i)
+    {
+        sched_handle_t handle = SchedAddTaskNs(sched, Operation,
+                        MonoNowNs() + MONO_NS_PER_SEC, 0, NULL, Cleanup);
+
+        while (EMPTY != __atomic_load_n(&passed, __ATOMIC_RELAXED))
+        {
+            sched_yield();
+        }
+        __atomic_store_n(&passed, handle, __ATOMIC_RELEASE);
+    }
+
+    return NULL;
+}
+
+
+static int Operation(void *args)
+{
+    (void)args;
+
+    return 0;
+}
+
+
+static void Cleanup(void *args)
+{
+    (void)args;
+}
@@ -14,7 +14,8 @@
 
 int main(int argc, char *argv[], char *envp[])
 {
-    watchdog_data_t wd_data;
+    watchdog_data_t wd_data = {0};
+    wd_progress_t *progress = NULL;
     wd_data.argv = argv;
     wd_data.envp = envp;
     wd_data.signal_from_wd_interval = 5;
@@ -26,9 +27,19 @@ int main(int argc, char *argv[], char *envp[])
 
     StartWatchDog(&wd_data); 
     printf("wd_user_process start\n");
+
+    /* a loop that stops advancing is revived like a dead process */
+    progress = WatchDogProgressSlot(10000);
+    if (NULL == progress)
+    {
+        printf("wd_user_process no progress slot\n");
+    }
     while (1)
     {
-        
+        if (NULL != progress)
+        {
+            WD_PROGRESS(progress);
+        }
     }
 
     UNUSED(argc);
@@ -17,6 +17,7 @@
 /******************************************************************************/
 static void Wait(time_t time);
 static void BasicTest(char **argv, char **envp);
+static void MillisecondTest(char **argv, char **envp);
 static void InfiniteLoopTest(char **argv, char **envp);
 /******************************************************************************/
 int main(int argc, char **argv, char **envp)
@@ -24,6 +25,7 @@ int main(int argc, char **argv, char **envp)
     UNUSED(argc);
 
     BasicTest(argv, envp);
+    MillisecondTest(argv, envp);
     InfiniteLoopTest(argv, envp);
 
     return 0;
@@ -57,6 +59,31 @@ static void BasicTest(char **argv, char **envp)
 }
 
 
+static void MillisecondTest(char **argv, char **envp)
+{
+    pthread_t thread = {0};
+
+    watchdog_data_t wd_data = {0};
+    wd_data.process_path = "/home/meital/git/ds/wd_user_process.out";
+    wd_data.watchdog_path = "/home/meital/git/ds/watchdog_process";
+    wd_data.argv = argv;
+    wd_data.envp = envp;
+    wd_data.signal_from_wd_interval_ms = 50;
+    wd_data.signal_to_wd_interval_ms = 50;
+    wd_data.signal_from_wd_miss_limit = 5;
+    wd_data.signal_to_wd_miss_limit = 3;
+
+    printf("\n\n50ms heartbeats\n");
+    thread = StartWatchDog(&wd_data);
+    Wait(3);
+    system("ps -a");
+
+    assert(SUCCESS == EndWatchDog(thread));
+    Wait(1);
+    printf("\nSUCCESS!\n\n");
+}
+
+
 static void InfiniteLoopTest(char **argv, char **envp)
 {
     watchdog_data_t wd_data = {0};
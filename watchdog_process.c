@@ -11,40 +11,190 @@
  * gd watchdog_process.c wd_shared_api.c -pthread -o watchdog_process -I include src/scheduler.c src/task.c src/uid.c src/priority_queue.c src/heap.c src/dynamic_vector.c
 *******************************************************************************/
 #define _POSIX_C_SOURCE  199309L
+#define _GNU_SOURCE
 
-#include <signal.h>  /* pthread_sigmask(), sigaddset(), sigemptyset(),
-                        sigtimedwait(), SIG_BLOCK, SIGUSR1, kill() */
+#include <signal.h>  /* sigset_t, kill() */
 #include <stdio.h>   /* printf() */
-#include <stdlib.h>  /* getenv() */
-#include <fcntl.h>   /* O_CREAT */
-#include <semaphore.h> /* sem_t, sem_open(), sem_wait(), sem_post() */
-#include <unistd.h>	/* getppid() */
+#include <stdlib.h>  /* getenv(), atoi(), malloc(), free() */
+#include <string.h>  /* strlen(), memcpy(), memset() */
+#include <fcntl.h>   /* fcntl(), FD_CLOEXEC */
+#include <unistd.h>	/* getppid(), close(), fork(), execvp() */
+#include <sys/socket.h> /* accept4(), getsockopt(), SO_PEERCRED */
+#include <sys/syscall.h> /* SYS_pidfd_send_signal */
 
 #include "scheduler.h" /* timing signal sending */
+#include "mono_clock.h" /* MonoNowNs() */
+#include "wd_daemon.h"
+#include "wd_limits.h"
 #include "wd_user_process.h"
 #include "wd_shared_api.h"
+#include "wd_state.h"
+#include "wd_zygote.h"
+#define MAX_SWEEPS 32
+/******************************************************************************/
+/* one task for the clients of an interval - one wake up for all of them */
+typedef struct
+{
+    uint64_t interval_ns;
+    int is_check;               /* checks their heartbeats, or beats to them */
+    size_t users;
+    sched_handle_t task;
+} wd_sweep_t;
+
+/* a process watched by the daemon, at the index of its channel */
+typedef struct
+{
+    int sock;                   /* -1 in a free slot */
+    pid_t pid;
+    int misses;
+    int miss_limit;
+    int is_new;                 /* not checked before its first heartbeat */
+    uint32_t seen;              /* the client's heartbeat counter */
+    wd_sweep_t *beat_sweep;     /* NULL until registered */
+    wd_sweep_t *check_sweep;
+    char *strings;              /* the process path, then argv */
+    char **argv;
+} wd_client_t;
 /******************************************************************************/
 static void *RunScheduler(void *args);
-static void GetWDDataFromEnvp(watchdog_data_t *wd_data);
 int ReciveSignalTask(void *args);
+static int PeerExited(void *arg, int fd, uint64_t now_ns);
+static void WatchUser(watchdog_data_t *wd_data);
+static void SetLimits(const watchdog_data_t *wd_data, uint64_t check_ns);
+static int CheckLimitsTask(void *args);
+static int ReviveHungUser(watchdog_data_t *wd_data);
+static int ReviveUser(watchdog_data_t *wd_data);
+static void QuarantineUser(void);
+static void SignalUser(int signum);
+static int Handshake(int fd);
+static void RunDaemon(const char *name);
+static int AcceptClients(void *arg, int fd, uint64_t now_ns);
+static int ClientMessage(void *arg, int fd, uint64_t now_ns);
+static int RegisterClient(wd_client_t *client, const wd_msg_t *msg,
+                                                            char *strings);
+static wd_sweep_t *JoinSweep(uint64_t interval_ns, int is_check);
+static void LeaveSweep(wd_sweep_t *sweep);
+static int Sweep(void *arg);
+static void CheckClient(wd_client_t *client);
+static void ReviveClient(const wd_client_t *client);
+static void DropClient(wd_client_t *client);
 
 int missed = 0;
 sigset_t set = {0};
 pid_t ppid = 0;
+int heartbeat_fd = -1;
+int peer_fd = -1;
+wd_channel_t *channel = NULL;
+
+/* the configuration and the runtime state of the pair, set up by the user
+   process */
+static wd_state_t *pair_state = NULL;
+
+/* the statistics of the pair, opened by the user process */
+static wd_stats_t *pair_stats = NULL;
+static wd_log_t *pair_log = NULL;
+
+/* the scheduler of the pair, and the zygote the user process may have
+   forked (see WatchDogReady) */
+static sched_t *pair_sched = NULL;
+static const char *zygote_name = NULL;
+
+/* the resource limits of the user process, and when it was asked to exit for
+   crossing one (0 - it was not) */
+static wd_limits_t limits;
+static int use_limits = 0;
+static uint64_t term_ns = 0;
+static uint64_t term_grace_ns = 0;
+
+/* the daemon mode - the clients and their channels, a slot each */
+static sched_t *daemon_sched = NULL;
+static wd_client_t *clients = NULL;
+static wd_channel_t *table = NULL;
+static int table_fd = -1;
+static int *free_slots = NULL;
+static size_t n_free = 0;
+static size_t n_slots = 0;      /* above it no slot was ever used */
+static wd_sweep_t sweeps[MAX_SWEEPS];
 /******************************************************************************/
 int main(int argc, char *argv[], char *envp[])
 {
     watchdog_data_t wd_data;
+    const char *daemon_name = getenv("daemon_name");
+    const char *state_fd = getenv("wd_state_fd");
+    const char *handshake_fd = getenv("handshake_fd");
+    const wd_state_config_t *config = NULL;
+
+    /* started by a client of the daemon, see watchdog_data_t */
+    if (NULL != daemon_name && '\0' != *daemon_name)
+    {
+        RunDaemon(daemon_name);
+
+        return 0;
+    }
 
     printf("watchdog_process start\n");
+
+    /* the configuration is mapped, not parsed - the fd stays open, the
+       user process it revives by exec takes the state over */
+    pair_state = (NULL == state_fd) ? NULL : WdStateOpen(atoi(state_fd));
+    if (NULL == pair_state)
+    {
+        printf("state error\n");
+        return 1;
+    }
+    config = &pair_state->config;
+    WdStateGetConfig(pair_state, &wd_data);
     wd_data.argv = argv;
     wd_data.envp = envp;
 
     stop_flag = 0;
-    
-    SetSignalMask(&set);
-    
-    GetWDDataFromEnvp(&wd_data);
+
+    if (WD_TRANSPORT_SHM == wd_data.transport)
+    {
+        /* the mapping is enough, the fd would leak into an exec of the
+           user process */
+        channel = WdChannelOpen(config->channel_fd);
+        close(config->channel_fd);
+        if (NULL != channel)
+        {
+            UseChannel(&channel->from_wd, &channel->to_wd);
+        }
+    }
+    if (NULL == channel)
+    {
+        heartbeat_fd = OpenHeartbeatFd(&set);
+    }
+    if ('\0' != config->stats_name[0])
+    {
+        pair_stats = WdStatsCreate(config->stats_name);
+    }
+    if ('\0' != config->log_name[0])
+    {
+        pair_log = WdLogCreate(config->log_name);
+    }
+
+    /* set up, it waits for the user process - a standby until it takes
+       over from the watchdog process */
+    if (NULL != handshake_fd && -1 != atoi(handshake_fd)
+                                        && 0 != Handshake(atoi(handshake_fd)))
+    {
+        return 0;
+    }
+
+    /* the role is this process's from now on - it goes on from the state of
+       the watchdog process before it */
+    WdStateSet(&pair_state->side[WD_ROLE_WATCHDOG].pid, (uint64_t)getpid());
+    missed = (int)WdStateGet(&pair_state->side[WD_ROLE_WATCHDOG].misses);
+    UseState(&pair_state->side[WD_ROLE_WATCHDOG]);
+    if (NULL != pair_stats)
+    {
+        WdStatsSet(&pair_stats->side[WD_ROLE_WATCHDOG].pid,
+                                                        (uint64_t)getpid());
+        UseStats(&pair_stats->side[WD_ROLE_WATCHDOG]);
+    }
+    UseLog(pair_log);
+    zygote_name = config->zygote_name;
+
     RunScheduler(&wd_data);
 
     UNUSED(argc);
@@ -60,20 +210,37 @@ static void *RunScheduler(void *args)
 
     if (NULL != sched)
     {
-        sem_t *sem1 = sem_open("watchdog1", O_CREAT, PERMISSION_ALL, 0);
-        sem_t *sem2 = sem_open("watchdog2", O_CREAT, PERMISSION_ALL, 0);
+        uint64_t check_ns = IntervalNs(wd->signal_to_wd_interval,
+                    wd->signal_to_wd_interval_ms, wd->signal_to_wd_interval_us);
 
         ppid = getppid();
+        pair_sched = sched;
+        SetLimits(wd, check_ns);
+        WatchUser(wd);
+
+        InitSched(sched, wd, &ppid, 
+            IntervalNs(wd->signal_from_wd_interval, wd->signal_from_wd_interval_ms,
+                wd->signal_from_wd_interval_us), 
+            check_ns, 
+            ReciveSignalTask, heartbeat_fd);
+        if (use_limits)
+        {
+            SchedAddTaskNs(sched, CheckLimitsTask, MonoNowNs() + check_ns,
+                                                check_ns, wd, CleanUp);
+        }
 
-        InitSched(sched, wd, &ppid, wd->signal_from_wd_interval, wd->signal_to_wd_interval, ReciveSignalTask);
+        LogEvent(WD_EVENT_START, ppid);
 
-        sem_post(sem1);
-        sem_wait(sem2);
-        
-        sem_close(sem1);
-        sem_close(sem2);
-        sem_unlink("watchdog1");
-        sem_unlink("watchdog2");
+        /* it beats at once - the user process sees a promoted standby run
+           without waiting an interval */
+        if (NULL != channel)
+        {
+            SendBeatTask(NULL);
+        }
+        else
+        {
+            SendSignalTask(&ppid);
+        }
 
         SchedRun(sched);
 
@@ -87,42 +254,624 @@ static void *RunScheduler(void *args)
 int ReciveSignalTask(void *args)
 {
     watchdog_data_t *wd_data = (watchdog_data_t *)args;
-    struct timespec ts = {0,0};
+    int beats = 0;
 
     if(stop_flag)
     {
         return 0;
     }
 
-    if (0 > sigtimedwait(&set, NULL, &ts))
+    beats = TakeHeartbeats();
+
+    /* checked between the heartbeats - a check without one is no miss */
+    if (0 < wd_data->phi_threshold)
+    {
+        if (0 != beats)
+        {
+            LogEvent(WD_EVENT_RECEIVED, beats);
+        }
+        if (IsPeerSuspect(wd_data->phi_threshold))
+        {
+            return ReviveHungUser(wd_data);
+        }
+    }
+    else if (0 == beats)
     {
         ++missed;
-        printf("WD missed %d\n", missed);
-
-        if (wd_data->signal_from_wd_miss_limit == missed)
+        SaveMisses(missed);
+        LogEvent(WD_EVENT_MISSED, missed);
+        if (NULL != pair_stats)
         {
-            execvp(wd_data->process_path, wd_data->argv);
+            WdStatsAdd(&pair_stats->side[WD_ROLE_WATCHDOG].misses, 1);
+        }
 
-            return 0;
+        /* past the limit while the revival waits out its backoff */
+        if (wd_data->signal_from_wd_miss_limit <= missed)
+        {
+            return ReviveHungUser(wd_data);
         }
     }
     else
     {
-        printf("WD received\n");
+        LogEvent(WD_EVENT_RECEIVED, beats);
         missed = 0;
+        SaveMisses(missed);
     }
     
     return 1;
 }
 
 
-static void GetWDDataFromEnvp(watchdog_data_t *wd_data)
+static int PeerExited(void *arg, int fd, uint64_t now_ns)
+{
+    watchdog_data_t *wd_data = (watchdog_data_t *)arg;
+    wd_restart_t answer = WD_RESTART_NOW;
+
+    UNUSED(fd);
+    UNUSED(now_ns);
+
+    if(stop_flag)
+    {
+        return 0;
+    }
+
+    printf("WD user process exited\n");
+    LogEvent(WD_EVENT_PEER_EXITED, ppid);
+
+    /* in its backoff the watch ends - a dead process misses its
+       heartbeats, and the misses ask again. its pidfd stays open, no
+       signal reaches a process that took its pid (see SignalUser) */
+    answer = WdStateRestart(pair_state, WD_ROLE_USER, MonoNowNs());
+    if (WD_RESTART_NEVER == answer)
+    {
+        QuarantineUser();
+    }
+    if (WD_RESTART_NOW != answer)
+    {
+        return 0;
+    }
+
+    /* on success the watch moved to the new user process */
+    return (0 == ReviveUser(wd_data)) ? 1 : 0;
+}
+
+
+static void WatchUser(watchdog_data_t *wd_data)
+{
+    if (-1 != peer_fd)
+    {
+        SchedRemoveFd(pair_sched, peer_fd);
+        close(peer_fd);
+    }
+
+    /* the user process exiting revives it at once, missed heartbeats
+       are left to detect a hung one */
+    peer_fd = OpenPeerFd(ppid);
+    if (-1 != peer_fd && 0 != SchedAddFd(pair_sched, peer_fd, PeerExited,
+                                                                    wd_data))
+    {
+        close(peer_fd);
+        peer_fd = -1;
+    }
+
+    /* the limits are of this user process - a failed open leaves it
+       unlimited */
+    if (use_limits)
+    {
+        WdLimitsClose(&limits);
+        WdLimitsOpen(&limits, ppid);
+        term_ns = 0;
+    }
+}
+
+
+static void SetLimits(const watchdog_data_t *wd_data, uint64_t check_ns)
+{
+    int miss_limit = wd_data->signal_from_wd_miss_limit;
+
+    limits.max[WD_LIMIT_RSS] = wd_data->max_rss_kb;
+    limits.max[WD_LIMIT_CPU] = wd_data->max_cpu_percent;
+    limits.max[WD_LIMIT_FDS] = wd_data->max_fds;
+    limits.window_ns = (uint64_t)wd_data->limit_window_ms * MONO_NS_PER_MS;
+    limits.statm_fd = -1;
+    limits.stat_fd = -1;
+    limits.fd_dir = -1;
+
+    use_limits = (0 != wd_data->max_rss_kb || 0 != wd_data->max_cpu_percent
+                                                || 0 != wd_data->max_fds);
+
+    /* it gets as long to exit as a hung process to beat again */
+    term_grace_ns = check_ns * (uint64_t)((0 < miss_limit) ? miss_limit : 1);
+}
+
+
+static int CheckLimitsTask(void *args)
+{
+    watchdog_data_t *wd_data = (watchdog_data_t *)args;
+    uint64_t now = MonoNowNs();
+    int limit = -1;
+
+    if(stop_flag)
+    {
+        return 0;
+    }
+
+    /* asked to exit, it did not - killed and revived as a hung process.
+       an exit is seen by its pidfd (see WatchUser) */
+    if (0 != term_ns)
+    {
+        return (now - term_ns < term_grace_ns) ? 1 : ReviveHungUser(wd_data);
+    }
+
+    limit = WdLimitsSample(&limits, now);
+    if (-1 != limit)
+    {
+        LogEvent(WD_EVENT_LIMIT, limit);
+        SignalUser(SIGTERM);
+        term_ns = now;
+    }
+
+    return 1;
+}
+
+
+static int ReviveHungUser(watchdog_data_t *wd_data)
+{
+    wd_restart_t answer = WdStateRestart(pair_state, WD_ROLE_USER,
+                                                                MonoNowNs());
+
+    /* it may yet recover in its backoff - the next check asks again */
+    if (WD_RESTART_LATER == answer)
+    {
+        return 1;
+    }
+
+    /* its heartbeat thread may live on (a thread of it stalled, see
+       WatchDogProgressSlot) - one user process of the pair runs */
+    SignalUser(SIGKILL);
+
+    if (WD_RESTART_NEVER == answer)
+    {
+        QuarantineUser();
+        return 0;
+    }
+
+    return (0 == ReviveUser(wd_data)) ? 1 : 0;
+}
+
+
+static int ReviveUser(watchdog_data_t *wd_data)
+{
+    pid_t pid = -1;
+
+    /* the revived process counts the restart, after its handshake */
+    if (NULL != pair_stats)
+    {
+        WdStatsReviveStart(&pair_stats->side[WD_ROLE_USER], MonoNowNs());
+    }
+    LogEvent(WD_EVENT_REVIVE, ppid);
+
+    /* the misses were the old user process's - this process watches the
+       new one, or becomes it */
+    missed = 0;
+    SaveMisses(missed);
+
+    /* forked from the snapshot of the user process, this process goes on
+       watching it */
+    if (NULL != zygote_name && '\0' != *zygote_name)
+    {
+        pid = WdZygoteFork(zygote_name);
+    }
+    if (0 < pid)
+    {
+        ppid = pid;
+        RestartPhi();
+        WatchUser(wd_data);
+
+        return 0;
+    }
+
+    execvp(wd_data->process_path, wd_data->argv);
+
+    return -1;
+}
+
+
+static void QuarantineUser(void)
+{
+    printf("WD user process quarantined\n");
+    LogEvent(WD_EVENT_QUARANTINE, ppid);
+    if (NULL != pair_stats)
+    {
+        WdStatsSet(&pair_stats->side[WD_ROLE_USER].quarantined_ns,
+                                                                MonoNowNs());
+    }
+
+    /* nothing is left to watch - the tasks end and the process exits */
+    stop_flag = 1;
+    SchedStop(pair_sched);
+}
+
+
+static void SignalUser(int signum)
+{
+    /* through its pidfd - an exited user process (revived after its
+       backoff, see PeerExited) may have its pid taken by another */
+    if (-1 != peer_fd)
+    {
+        syscall(SYS_pidfd_send_signal, peer_fd, signum, NULL, 0);
+    }
+    else if (0 < ppid)
+    {
+        kill(ppid, signum);
+    }
+}
+
+
+static int Handshake(int fd)
+{
+    char byte = WD_HANDSHAKE_READY;
+
+    /* parked in read() - the user process exiting closes the socket */
+    if (1 != write(fd, &byte, 1) || 1 != read(fd, &byte, 1)
+                                                || WD_HANDSHAKE_GO != byte)
+    {
+        close(fd);
+        return -1;
+    }
+    close(fd);
+
+    /* heartbeats the user process sent to the old watchdog are not this
+       one's */
+    if (NULL != channel)
+    {
+        UseChannel(&channel->from_wd, &channel->to_wd);
+    }
+    else
+    {
+        TakeHeartbeats();
+    }
+
+    return 0;
+}
+
+
+static void RunDaemon(const char *name)
+{
+    int listen_fd = WdDaemonListen(name);
+    size_t i = 0;
+
+    /* the clients of another daemon of this name are watched already */
+    if (-1 == listen_fd)
+    {
+        printf("WD daemon %s runs already\n", name);
+        return;
+    }
+
+    /* revived clients are not waited for */
+    signal(SIGCHLD, SIG_IGN);
+
+    daemon_sched = SchedCreateBackend(SCHED_TIMING_WHEEL);
+    clients = (wd_client_t *)calloc(WD_DAEMON_MAX_CLIENTS, sizeof(wd_client_t));
+    free_slots = (int *)malloc(WD_DAEMON_MAX_CLIENTS * sizeof(int));
+    table = WdChannelCreateTable(&table_fd, WD_DAEMON_MAX_CLIENTS);
+
+    if (NULL != daemon_sched && NULL != clients && NULL != free_slots
+                                                            && NULL != table)
+    {
+        /* sent to the clients, not to the processes they revive */
+        fcntl(table_fd, F_SETFD, FD_CLOEXEC);
+
+        /* the lowest slots first, the pages of the table fill in order */
+        for (i = 0; i < WD_DAEMON_MAX_CLIENTS; ++i)
+        {
+            clients[i].sock = -1;
+            free_slots[i] = (int)(WD_DAEMON_MAX_CLIENTS - 1 - i);
+        }
+        n_free = WD_DAEMON_MAX_CLIENTS;
+
+        printf("WD daemon %s start\n", name);
+        SchedAddFd(daemon_sched, listen_fd, AcceptClients, NULL);
+        SchedRun(daemon_sched);
+    }
+
+    if (NULL != table)
+    {
+        WdChannelCloseTable(table, WD_DAEMON_MAX_CLIENTS);
+        close(table_fd);
+    }
+    free(free_slots);
+    free(clients);
+    if (NULL != daemon_sched)
+    {
+        SchedDestroy(daemon_sched);
+    }
+    close(listen_fd);
+}
+
+
+static int AcceptClients(void *arg, int fd, uint64_t now_ns)
+{
+    int sock = -1;
+
+    UNUSED(arg);
+    UNUSED(now_ns);
+
+    while (-1 != (sock = accept4(fd, NULL, NULL,
+                                        SOCK_NONBLOCK | SOCK_CLOEXEC)))
+    {
+        wd_client_t *client = NULL;
+
+        /* a full table - the client sees the socket close */
+        if (0 == n_free)
+        {
+            close(sock);
+            continue;
+        }
+
+        client = &clients[free_slots[--n_free]];
+        client->sock = sock;
+        if (n_slots <= (size_t)(client - clients))
+        {
+            n_slots = (size_t)(client - clients) + 1;
+        }
+        if (0 != SchedAddFd(daemon_sched, sock, ClientMessage, client))
+        {
+            close(sock);
+            client->sock = -1;
+            ++n_free;
+        }
+    }
+
+    return 1;
+}
+
+
+static int ClientMessage(void *arg, int fd, uint64_t now_ns)
+{
+    wd_client_t *client = (wd_client_t *)arg;
+    char strings[WD_DAEMON_MSG_MAX];
+    wd_msg_t msg;
+    int status = 0;
+
+    UNUSED(fd);
+    UNUSED(now_ns);
+
+    while (1 == (status = WdDaemonReceive(client->sock, &msg, strings)))
+    {
+        if (WD_MSG_END == msg.kind)
+        {
+            printf("WD daemon released %d\n", client->pid);
+            DropClient(client);
+
+            return 1;
+        }
+        if (WD_MSG_REGISTER == msg.kind
+                && NULL == client->check_sweep
+                && 0 != RegisterClient(client, &msg, strings))
+        {
+            WdDaemonReply(client->sock, -1, table_fd);
+            DropClient(client);
+
+            return 1;
+        }
+    }
+
+    /* the client exited without EndWatchDog */
+    if (-1 == status)
+    {
+        if (NULL != client->check_sweep)
+        {
+            printf("WD daemon client %d exited\n", client->pid);
+            ReviveClient(client);
+        }
+        DropClient(client);
+    }
+
+    return 1;
+}
+
+
+static int RegisterClient(wd_client_t *client, const wd_msg_t *msg,
+                                                                char *strings)
+{
+    size_t slot = (size_t)(client - clients);
+    struct ucred cred;
+    socklen_t cred_len = sizeof(cred);
+    size_t i = 0, at = 0;
+
+    if (0 == msg->strings_len || 0 == msg->to_wd_interval_ns
+            || 0 == msg->from_wd_interval_ns || 0 != getsockopt(client->sock, SOL_SOCKET,
+                                        SO_PEERCRED, &cred, &cred_len))
+    {
+        return -1;
+    }
+
+    /* an abstract socket has no permissions - a process of another user
+       would have its command run as this one, and its table */
+    if (cred.uid != geteuid())
+    {
+        printf("WD daemon refused uid %d\n", (int)cred.uid);
+        return -1;
+    }
+
+    /* each argument takes a byte of the strings at least - a larger argc
+       is not of a client */
+    if (msg->argc >= msg->strings_len)
+    {
+        return -1;
+    }
+
+    client->strings = (char *)malloc(msg->strings_len);
+    client->argv = (char **)malloc(((size_t)msg->argc + 1) * sizeof(char *));
+    if (NULL == client->strings || NULL == client->argv)
+    {
+        return -1;
+    }
+    memcpy(client->strings, strings, msg->strings_len);
+
+    /* the path, then argc strings - each ends inside the message */
+    at = strlen(client->strings) + 1;
+    for (i = 0; i < msg->argc; ++i)
+    {
+        if (at >= msg->strings_len)
+        {
+            return -1;
+        }
+        client->argv[i] = client->strings + at;
+        at += strlen(client->argv[i]) + 1;
+    }
+    client->argv[msg->argc] = NULL;
+
+    client->pid = cred.pid;
+    client->misses = 0;
+    client->miss_limit = (int)msg->miss_limit;
+    client->is_new = 1;
+    client->seen = WdChannelSeq(&table[slot].to_wd);
+
+    client->beat_sweep = JoinSweep(msg->from_wd_interval_ns, 0);
+    client->check_sweep = JoinSweep(msg->to_wd_interval_ns, 1);
+    if (NULL == client->beat_sweep || NULL == client->check_sweep)
+    {
+        return -1;
+    }
+
+    printf("WD daemon watches %d\n", client->pid);
+
+    return WdDaemonReply(client->sock, (int)slot, table_fd);
+}
+
+
+static wd_sweep_t *JoinSweep(uint64_t interval_ns, int is_check)
+{
+    wd_sweep_t *free_sweep = NULL;
+    size_t i = 0;
+
+    for (i = 0; i < MAX_SWEEPS; ++i)
+    {
+        if (0 == sweeps[i].users)
+        {
+            free_sweep = (NULL == free_sweep) ? &sweeps[i] : free_sweep;
+        }
+        else if (interval_ns == sweeps[i].interval_ns
+                                            && is_check == sweeps[i].is_check)
+        {
+            ++sweeps[i].users;
+
+            return &sweeps[i];
+        }
+    }
+
+    if (NULL == free_sweep)
+    {
+        return NULL;
+    }
+
+    free_sweep->task = SchedAddTaskNs(daemon_sched, Sweep,
+            MonoNowNs() + interval_ns, interval_ns, free_sweep, CleanUp);
+    if (SCHED_BAD_HANDLE == free_sweep->task)
+    {
+        return NULL;
+    }
+    free_sweep->interval_ns = interval_ns;
+    free_sweep->is_check = is_check;
+    free_sweep->users = 1;
+
+    return free_sweep;
+}
+
+
+static void LeaveSweep(wd_sweep_t *sweep)
+{
+    if (0 == --sweep->users)
+    {
+        SchedRemoveTask(daemon_sched, sweep->task);
+        sweep->task = SCHED_BAD_HANDLE;
+    }
+}
+
+
+static int Sweep(void *arg)
+{
+    wd_sweep_t *sweep = (wd_sweep_t *)arg;
+    size_t i = 0;
+
+    /* the table in order - a store or a load per client */
+    for (i = 0; i < n_slots; ++i)
+    {
+        if (sweep == clients[i].beat_sweep)
+        {
+            WdChannelBeat(&table[i].from_wd);
+        }
+        else if (sweep == clients[i].check_sweep)
+        {
+            CheckClient(&clients[i]);
+        }
+    }
+
+    return 1;
+}
+
+
+static void CheckClient(wd_client_t *client)
+{
+    uint32_t seq = WdChannelSeq(&table[client - clients].to_wd);
+
+    if (seq != client->seen || client->is_new)
+    {
+        client->seen = seq;
+        client->misses = 0;
+        client->is_new = 0;
+
+        return;
+    }
+
+    if (++client->misses < client->miss_limit)
+    {
+        return;
+    }
+
+    /* the slot goes to other clients - a hung client must not beat on it */
+    printf("WD daemon missed %d of %d\n", client->misses, client->pid);
+    kill(client->pid, SIGKILL);
+    ReviveClient(client);
+    DropClient(client);
+}
+
+
+static void ReviveClient(const wd_client_t *client)
+{
+    pid_t pid = fork();
+
+    if (0 == pid)
+    {
+        /* an ignored signal stays ignored through exec */
+        signal(SIGCHLD, SIG_DFL);
+        execvp(client->strings, client->argv);
+
+        printf("error in exec\n");
+        _exit(1);
+    }
+}
+
+
+static void DropClient(wd_client_t *client)
 {
-    wd_data->watchdog_path = getenv("watchdog_path");
-    wd_data->process_path = getenv("process_path");
+    if (NULL != client->beat_sweep)
+    {
+        LeaveSweep(client->beat_sweep);
+    }
+    if (NULL != client->check_sweep)
+    {
+        LeaveSweep(client->check_sweep);
+    }
+    SchedRemoveFd(daemon_sched, client->sock);
+    close(client->sock);
+
+    free(client->argv);
+    free(client->strings);
+    memset(client, 0, sizeof(*client));
+    client->sock = -1;
 
-    wd_data->signal_to_wd_interval = atol(getenv("signal_to_wd_interval"));
-    wd_data->signal_from_wd_interval = atol(getenv("signal_from_wd_interval"));
-    wd_data->signal_to_wd_miss_limit = atoi(getenv("signal_to_wd_miss_limit"));
-    wd_data->signal_from_wd_miss_limit = atoi(getenv ("signal_from_wd_miss_limit"));
+    free_slots[n_free++] = (int)(client - clients);
 }
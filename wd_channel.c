@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : shared-memory heartbeat channel
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <unistd.h>        /* ftruncate(), close(), sysconf() */
+#include <sys/mman.h>      /* memfd_create(), mmap(), munmap() */
+
+#include "wd_channel.h"
+/******************************************************************************/
+static wd_channel_t *Map(int fd, size_t offset, size_t size);
+/******************************************************************************/
+wd_channel_t *WdChannelCreate(int *fd)
+{
+    return WdChannelCreateTable(fd, 1);
+}
+
+
+wd_channel_t *WdChannelCreateTable(int *fd, size_t n)
+{
+    wd_channel_t *table = NULL;
+
+    /* not close-on-exec - the watchdog process maps it after exec */
+    *fd = memfd_create("watchdog_channel", 0);
+    if (-1 == *fd)
+    {
+        return NULL;
+    }
+
+    /* a new file reads as zeros, so are the counters */
+    if (0 != ftruncate(*fd, (off_t)(n * sizeof(wd_channel_t))))
+    {
+        close(*fd);
+        *fd = -1;
+        return NULL;
+    }
+
+    table = Map(*fd, 0, n * sizeof(wd_channel_t));
+    if (NULL == table)
+    {
+        close(*fd);
+        *fd = -1;
+    }
+
+    return table;
+}
+
+
+wd_channel_t *WdChannelOpen(int fd)
+{
+    return Map(fd, 0, sizeof(wd_channel_t));
+}
+
+
+wd_channel_t *WdChannelOpenSlot(int fd, size_t slot)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t offset = slot * sizeof(wd_channel_t);
+    char *map = NULL;
+
+    /* a channel never crosses a page - its size divides the page size */
+    map = (char *)Map(fd, offset - offset % page, page);
+
+    return (NULL == map) ? NULL : (wd_channel_t *)(map + offset % page);
+}
+
+
+void WdChannelClose(wd_channel_t *channel)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+
+    munmap((char *)channel - (uintptr_t)channel % page, sizeof(wd_channel_t));
+}
+
+
+void WdChannelCloseTable(wd_channel_t *table, size_t n)
+{
+    munmap(table, n * sizeof(wd_channel_t));
+}
+
+
+void WdChannelBeat(wd_beat_t *beat)
+{
+    __atomic_add_fetch(&beat->seq, 1, __ATOMIC_RELEASE);
+}
+
+
+uint32_t WdChannelSeq(const wd_beat_t *beat)
+{
+    return __atomic_load_n(&beat->seq, __ATOMIC_ACQUIRE);
+}
+
+/******************************************************************************/
+static wd_channel_t *Map(int fd, size_t offset, size_t size)
+{
+    void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+                                                            (off_t)offset);
+
+    return (MAP_FAILED == map) ? NULL : (wd_channel_t *)map;
+}
@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : shared-memory heartbeat channel
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#ifndef __WD_CHANNEL_H_OL108_ILRD__
+#define __WD_CHANNEL_H_OL108_ILRD__
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint32_t */
+
+#define WD_CACHE_LINE 64
+
+/* a heartbeat counter of one direction, alone in its cache line */
+typedef struct
+{
+    uint32_t seq;       /* bumped by the sender */
+    char pad[WD_CACHE_LINE - sizeof(uint32_t)];
+} wd_beat_t;
+
+/* the shared page - one counter per direction */
+typedef struct
+{
+    wd_beat_t to_wd;
+    wd_beat_t from_wd;
+} wd_channel_t;
+
+
+/**
+ * @Description: Creates a zeroed channel in an anonymous shared memory file.
+ * @Parameters: fd - set to the file descriptor of the memory file, to pass to
+ *                   the peer (it is inherited through fork and exec).
+ * @Return: The mapped channel, NULL on failure.
+**/
+wd_channel_t *WdChannelCreate(int *fd);
+
+
+/**
+ * @Description: Maps the channel of the given memory file.
+ * @Parameters: fd - the file descriptor from WdChannelCreate.
+ * @Return: The mapped channel, NULL on failure.
+ * @Notes: The fd may be closed after the call.
+**/
+wd_channel_t *WdChannelOpen(int fd);
+
+
+/**
+ * @Description: Creates a table of zeroed channels in an anonymous shared
+ *               memory file, one channel per peer.
+ * @Parameters: fd - set to the file descriptor of the memory file.
+ *              n - the number of channels.
+ * @Return: The mapped table, NULL on failure.
+ * @Notes: The pages of the table are allocated as the channels are used.
+**/
+wd_channel_t *WdChannelCreateTable(int *fd, size_t n);
+
+
+/**
+ * @Description: Maps one channel of a table.
+ * @Parameters: fd - the file descriptor from WdChannelCreateTable.
+ *              slot - the index of the channel in the table.
+ * @Return: The mapped channel, NULL on failure.
+ * @Notes: Only the page holding the channel is mapped. The fd may be closed
+ *         after the call.
+**/
+wd_channel_t *WdChannelOpenSlot(int fd, size_t slot);
+
+
+/**
+ * @Description: Unmaps a channel.
+ * @Parameters: channel - the channel (of WdChannelCreate, WdChannelOpen or
+ *              WdChannelOpenSlot).
+ * @Return: void.
+**/
+void WdChannelClose(wd_channel_t *channel);
+
+
+/**
+ * @Description: Unmaps a table of channels.
+ * @Parameters: table - the table of WdChannelCreateTable.
+ *              n - the number of channels.
+ * @Return: void.
+**/
+void WdChannelCloseTable(wd_channel_t *table, size_t n);
+
+
+/**
+ * @Description: Sends a heartbeat - bumps the counter.
+ * @Parameters: beat - the counter of the sending direction.
+ * @Return: void.
+ * @Notes: A store - the peer reads the counter on its own tick.
+**/
+void WdChannelBeat(wd_beat_t *beat);
+
+
+/**
+ * @Description: Reads the counter of a direction.
+ * @Parameters: beat - the counter.
+ * @Return: The number of heartbeats sent so far (wraps around) - beats are
+ *          counted, none are merged.
+**/
+uint32_t WdChannelSeq(const wd_beat_t *beat);
+
+
+#endif /* __WD_CHANNEL_H_OL108_ILRD__ */
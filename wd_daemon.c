@@ -0,0 +1,282 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : protocol between the watchdog daemon and its
+ *              clients
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <errno.h>         /* errno, EAGAIN, EWOULDBLOCK, EINTR */
+#include <stddef.h>        /* offsetof() */
+#include <string.h>        /* memset(), memcpy(), strlen() */
+#include <unistd.h>        /* close() */
+#include <sys/socket.h>    /* socket(), bind(), connect(), sendmsg(), recv() */
+#include <sys/time.h>      /* struct timeval */
+#include <sys/un.h>        /* struct sockaddr_un */
+
+#include "wd_daemon.h"
+#include "wd_shared_api.h" /* IntervalNs() */
+/******************************************************************************/
+#define REPLY_TIMEOUT_SEC 1
+
+static socklen_t Address(const char *name, struct sockaddr_un *addr);
+static size_t PutString(char *buffer, size_t at, const char *string);
+static int ReceiveReply(int sock, int *slot);
+/******************************************************************************/
+int WdDaemonListen(const char *name)
+{
+    struct sockaddr_un addr;
+    socklen_t len = Address(name, &addr);
+    int sock = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                                                                            0);
+
+    if (-1 == sock)
+    {
+        return -1;
+    }
+
+    /* an abstract name is released with its last socket - no stale file
+       after a crash, and bind fails while a daemon runs */
+    if (0 != bind(sock, (struct sockaddr *)&addr, len)
+                                            || 0 != listen(sock, SOMAXCONN))
+    {
+        close(sock);
+        return -1;
+    }
+
+    return sock;
+}
+
+
+int WdDaemonConnect(const char *name, pid_t *pid)
+{
+    struct sockaddr_un addr;
+    socklen_t len = Address(name, &addr);
+    struct ucred cred;
+    socklen_t cred_len = sizeof(cred);
+    int sock = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+
+    if (-1 == sock)
+    {
+        return -1;
+    }
+
+    if (0 != connect(sock, (struct sockaddr *)&addr, len)
+        || 0 != getsockopt(sock, SOL_SOCKET, SO_PEERCRED, &cred, &cred_len))
+    {
+        close(sock);
+        return -1;
+    }
+    *pid = cred.pid;
+
+    return sock;
+}
+
+
+wd_channel_t *WdDaemonRegister(int sock, const watchdog_data_t *wd_data)
+{
+    char buffer[sizeof(wd_msg_t) + WD_DAEMON_MSG_MAX];
+    wd_msg_t msg;
+    wd_channel_t *channel = NULL;
+    size_t len = 0;
+    int slot = -1, fd = -1;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.kind = WD_MSG_REGISTER;
+    msg.miss_limit = (uint32_t)wd_data->signal_to_wd_miss_limit;
+    msg.to_wd_interval_ns = IntervalNs(wd_data->signal_to_wd_interval,
+            wd_data->signal_to_wd_interval_ms,
+            wd_data->signal_to_wd_interval_us);
+    msg.from_wd_interval_ns = IntervalNs(wd_data->signal_from_wd_interval,
+            wd_data->signal_from_wd_interval_ms,
+            wd_data->signal_from_wd_interval_us);
+
+    len = PutString(buffer + sizeof(msg), 0, wd_data->process_path);
+    for (msg.argc = 0; NULL != wd_data->argv[msg.argc]; ++msg.argc)
+    {
+        len = PutString(buffer + sizeof(msg), len,
+                                                wd_data->argv[msg.argc]);
+    }
+    if (WD_DAEMON_MSG_MAX < len)
+    {
+        return NULL;
+    }
+    msg.strings_len = (uint32_t)len;
+    memcpy(buffer, &msg, sizeof(msg));
+
+    if ((ssize_t)(sizeof(msg) + len) !=
+                    send(sock, buffer, sizeof(msg) + len, MSG_NOSIGNAL))
+    {
+        return NULL;
+    }
+
+    fd = ReceiveReply(sock, &slot);
+    if (-1 != fd)
+    {
+        channel = WdChannelOpenSlot(fd, (size_t)slot);
+        close(fd);
+    }
+
+    return channel;
+}
+
+
+int WdDaemonEnd(int sock)
+{
+    wd_msg_t msg;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.kind = WD_MSG_END;
+
+    return ((ssize_t)sizeof(msg) == send(sock, &msg, sizeof(msg),
+                                                    MSG_NOSIGNAL)) ? 0 : -1;
+}
+
+
+int WdDaemonReceive(int sock, wd_msg_t *msg, char *strings)
+{
+    char buffer[sizeof(wd_msg_t) + WD_DAEMON_MSG_MAX];
+    ssize_t n = recv(sock, buffer, sizeof(buffer), MSG_DONTWAIT);
+
+    if (0 > n && (EAGAIN == errno || EWOULDBLOCK == errno || EINTR == errno))
+    {
+        return 0;
+    }
+    /* end of file, or a message no client sends */
+    if ((ssize_t)sizeof(wd_msg_t) > n)
+    {
+        return -1;
+    }
+
+    memcpy(msg, buffer, sizeof(wd_msg_t));
+    if (msg->strings_len != (size_t)n - sizeof(wd_msg_t)
+            || (0 != msg->strings_len && '\0' != buffer[n - 1]))
+    {
+        return -1;
+    }
+    memcpy(strings, buffer + sizeof(wd_msg_t), msg->strings_len);
+
+    return 1;
+}
+
+
+int WdDaemonReply(int sock, int slot, int table_fd)
+{
+    struct msghdr hdr;
+    struct iovec iov;
+    int32_t value = slot;
+    union
+    {
+        struct cmsghdr align;
+        char buffer[CMSG_SPACE(sizeof(int))];
+    } control;
+
+    memset(&hdr, 0, sizeof(hdr));
+    iov.iov_base = &value;
+    iov.iov_len = sizeof(value);
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+
+    /* the table travels with the slot - the client maps its page */
+    if (0 <= slot)
+    {
+        struct cmsghdr *cmsg = NULL;
+
+        memset(&control, 0, sizeof(control));
+        hdr.msg_control = control.buffer;
+        hdr.msg_controllen = sizeof(control.buffer);
+        cmsg = CMSG_FIRSTHDR(&hdr);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &table_fd, sizeof(int));
+    }
+
+    return ((ssize_t)sizeof(value) == sendmsg(sock, &hdr,
+                                MSG_NOSIGNAL | MSG_DONTWAIT)) ? 0 : -1;
+}
+
+/******************************************************************************/
+static socklen_t Address(const char *name, struct sockaddr_un *addr)
+{
+    size_t len = strlen(name);
+
+    if (sizeof(addr->sun_path) - 1 < len)
+    {
+        len = sizeof(addr->sun_path) - 1;
+    }
+
+    /* sun_path[0] is '\0' - the abstract namespace */
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    memcpy(addr->sun_path + 1, name, len);
+
+    return (socklen_t)(offsetof(struct sockaddr_un, sun_path) + 1 + len);
+}
+
+
+static size_t PutString(char *buffer, size_t at, const char *string)
+{
+    size_t len = strlen(string) + 1;
+
+    /* the caller checks the total, past the end nothing is written */
+    if (at + len <= WD_DAEMON_MSG_MAX)
+    {
+        memcpy(buffer + at, string, len);
+    }
+
+    return at + len;
+}
+
+
+static int ReceiveReply(int sock, int *slot)
+{
+    struct msghdr hdr;
+    struct iovec iov;
+    struct timeval timeout;
+    struct cmsghdr *cmsg = NULL;
+    int32_t value = -1;
+    int fd = -1;
+    union
+    {
+        struct cmsghdr align;
+        char buffer[CMSG_SPACE(sizeof(int))];
+    } control;
+
+    /* a hung daemon is not waited for */
+    timeout.tv_sec = REPLY_TIMEOUT_SEC;
+    timeout.tv_usec = 0;
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    memset(&hdr, 0, sizeof(hdr));
+    memset(&control, 0, sizeof(control));
+    iov.iov_base = &value;
+    iov.iov_len = sizeof(value);
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = control.buffer;
+    hdr.msg_controllen = sizeof(control.buffer);
+
+    if ((ssize_t)sizeof(value) != recvmsg(sock, &hdr, MSG_CMSG_CLOEXEC))
+    {
+        return -1;
+    }
+
+    cmsg = CMSG_FIRSTHDR(&hdr);
+    if (NULL != cmsg && SOL_SOCKET == cmsg->cmsg_level
+                                        && SCM_RIGHTS == cmsg->cmsg_type)
+    {
+        memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+    }
+    if (0 > value && -1 != fd)
+    {
+        close(fd);
+        fd = -1;
+    }
+    *slot = (int)value;
+
+    return fd;
+}
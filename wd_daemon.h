@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : protocol between the watchdog daemon and its
+ *              clients
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#ifndef __WD_DAEMON_H_OL108_ILRD__
+#define __WD_DAEMON_H_OL108_ILRD__
+
+#include <stdint.h>         /* uint32_t, uint64_t */
+#include <sys/types.h>      /* pid_t */
+
+#include "wd_channel.h"
+#include "wd_user_process.h"
+
+/* the clients of one daemon, a slot each in its table of channels */
+#define WD_DAEMON_MAX_CLIENTS 16384
+/* a message - the header, then the process path and argv */
+#define WD_DAEMON_MSG_MAX 4096
+
+typedef enum
+{
+    WD_MSG_REGISTER,    /* watch the sending process */
+    WD_MSG_END          /* stop watching it, EndWatchDog */
+} wd_msg_kind_t;
+
+/* a message of a client */
+typedef struct
+{
+    uint32_t kind;
+    uint32_t miss_limit;            /* of the client's heartbeats */
+    uint64_t to_wd_interval_ns;     /* client heartbeats, checked by daemon */
+    uint64_t from_wd_interval_ns;   /* daemon heartbeats */
+    uint32_t argc;
+    uint32_t strings_len;   /* process path and argv, each '\0' terminated */
+} wd_msg_t;
+
+
+/**
+ * @Description: Opens the listening socket of a daemon.
+ * @Parameters: name - the name of the daemon (an abstract unix socket).
+ * @Return: The non-blocking socket, -1 on failure - another daemon runs under
+ *          the name.
+**/
+int WdDaemonListen(const char *name);
+
+
+/**
+ * @Description: Connects to a daemon.
+ * @Parameters: name - the name of the daemon.
+ *              pid - set to the pid of the daemon.
+ * @Return: The connected socket, -1 if no daemon runs under the name.
+ * @Notes: The socket is readable (at end of file) once the daemon exits.
+**/
+int WdDaemonConnect(const char *name, pid_t *pid);
+
+
+/**
+ * @Description: Registers the calling process with a daemon, and maps its
+ *               channel.
+ * @Parameters: sock - the socket of WdDaemonConnect.
+ *              wd_data - the intervals, miss limit, process path and argv
+ *              the daemon watches and revives the process with.
+ * @Return: The channel of the process, NULL on failure (the daemon did not
+ *          answer within a second, or its table is full).
+**/
+wd_channel_t *WdDaemonRegister(int sock, const watchdog_data_t *wd_data);
+
+
+/**
+ * @Description: Tells a daemon to stop watching the calling process.
+ * @Parameters: sock - the socket of WdDaemonConnect.
+ * @Return: 0 on success, -1 on failure.
+**/
+int WdDaemonEnd(int sock);
+
+
+/**
+ * @Description: Receives a message of a client (daemon side).
+ * @Parameters: sock - the socket of the client.
+ *              msg - set to the message.
+ *              strings - set to the strings of the message, a buffer of
+ *              WD_DAEMON_MSG_MAX bytes.
+ * @Return: 1 on a message, 0 if none is waiting, -1 once the client closed
+ *          the socket (or exited).
+**/
+int WdDaemonReceive(int sock, wd_msg_t *msg, char *strings);
+
+
+/**
+ * @Description: Answers a registration (daemon side).
+ * @Parameters: sock - the socket of the client.
+ *              slot - the slot of the client in the table, -1 if refused.
+ *              table_fd - the memory file of the table of channels.
+ * @Return: 0 on success, -1 on failure.
+**/
+int WdDaemonReply(int sock, int slot, int table_fd);
+
+#endif /* __WD_DAEMON_H_OL108_ILRD__ */
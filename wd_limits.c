@@ -0,0 +1,290 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : resource limits of the user process - its RSS, CPU
+ *              and open files sampled from /proc through handles kept open
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <fcntl.h>          /* open(), O_RDONLY, O_DIRECTORY, O_CLOEXEC */
+#include <stdio.h>          /* sprintf() */
+#include <stdlib.h>         /* strtoull() */
+#include <string.h>         /* strrchr(), strchr() */
+#include <unistd.h>         /* pread(), lseek(), close(), sysconf() */
+#include <sys/stat.h>       /* fstat(), struct stat */
+#include <sys/syscall.h>    /* SYS_getdents64 */
+
+#include "mono_clock.h"     /* MONO_NS_PER_SEC */
+#include "wd_limits.h"
+
+#define PROC_PATH_MAX 64
+#define STAT_MAX 1024
+#define DIRENTS_MAX 4096
+
+/* the fields of /proc/<pid>/stat after the command, up to utime */
+#define STAT_FIELDS_TO_UTIME 11
+
+/* struct linux_dirent64 up to its record length */
+typedef struct
+{
+    uint64_t ino;
+    int64_t off;
+    unsigned short reclen;
+} dirent_head_t;
+
+static int OpenProc(pid_t pid, const char *file, int flags);
+static int ReadProc(int fd, char *buffer, size_t size);
+static uint64_t SampleRss(wd_limits_t *limits);
+static uint64_t SampleCpuTicks(wd_limits_t *limits);
+static uint64_t SampleFds(wd_limits_t *limits);
+static void SampleCpu(wd_limits_t *limits, uint64_t now_ns);
+/******************************************************************************/
+int WdLimitsOpen(wd_limits_t *limits, pid_t pid)
+{
+    size_t i = 0;
+
+    limits->statm_fd = -1;
+    limits->stat_fd = -1;
+    limits->fd_dir = -1;
+    limits->cpu_ticks = 0;
+    limits->cpu_ns = 0;
+    for (i = 0; i < WD_LIMITS; ++i)
+    {
+        limits->usage[i] = 0;
+        limits->over_ns[i] = 0;
+    }
+
+    if (0 != limits->max[WD_LIMIT_RSS])
+    {
+        limits->statm_fd = OpenProc(pid, "statm", O_RDONLY);
+    }
+    if (0 != limits->max[WD_LIMIT_CPU])
+    {
+        limits->stat_fd = OpenProc(pid, "stat", O_RDONLY);
+    }
+    if (0 != limits->max[WD_LIMIT_FDS])
+    {
+        limits->fd_dir = OpenProc(pid, "fd", O_RDONLY | O_DIRECTORY);
+    }
+
+    if ((0 != limits->max[WD_LIMIT_RSS] && -1 == limits->statm_fd)
+        || (0 != limits->max[WD_LIMIT_CPU] && -1 == limits->stat_fd)
+        || (0 != limits->max[WD_LIMIT_FDS] && -1 == limits->fd_dir))
+    {
+        WdLimitsClose(limits);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+void WdLimitsClose(wd_limits_t *limits)
+{
+    if (-1 != limits->statm_fd)
+    {
+        close(limits->statm_fd);
+    }
+    if (-1 != limits->stat_fd)
+    {
+        close(limits->stat_fd);
+    }
+    if (-1 != limits->fd_dir)
+    {
+        close(limits->fd_dir);
+    }
+    limits->statm_fd = -1;
+    limits->stat_fd = -1;
+    limits->fd_dir = -1;
+}
+
+
+int WdLimitsSample(wd_limits_t *limits, uint64_t now_ns)
+{
+    int crossed = -1;
+    size_t i = 0;
+
+    if (-1 != limits->statm_fd)
+    {
+        limits->usage[WD_LIMIT_RSS] = SampleRss(limits);
+    }
+    if (-1 != limits->stat_fd)
+    {
+        SampleCpu(limits, now_ns);
+    }
+    if (-1 != limits->fd_dir)
+    {
+        limits->usage[WD_LIMIT_FDS] = SampleFds(limits);
+    }
+
+    for (i = 0; i < WD_LIMITS; ++i)
+    {
+        if (0 == limits->max[i] || limits->usage[i] <= limits->max[i])
+        {
+            limits->over_ns[i] = 0;
+            continue;
+        }
+
+        if (0 == limits->over_ns[i])
+        {
+            limits->over_ns[i] = now_ns;
+        }
+        if (-1 == crossed && now_ns - limits->over_ns[i] >= limits->window_ns)
+        {
+            crossed = (int)i;
+        }
+    }
+
+    return crossed;
+}
+
+/******************************************************************************/
+static int OpenProc(pid_t pid, const char *file, int flags)
+{
+    char path[PROC_PATH_MAX];
+
+    sprintf(path, "/proc/%d/%s", (int)pid, file);
+
+    return open(path, flags | O_CLOEXEC);
+}
+
+
+static int ReadProc(int fd, char *buffer, size_t size)
+{
+    /* a /proc file is generated anew by a read from its start */
+    ssize_t n = pread(fd, buffer, size - 1, 0);
+
+    if (0 >= n)
+    {
+        return -1;
+    }
+    buffer[n] = '\0';
+
+    return 0;
+}
+
+
+static uint64_t SampleRss(wd_limits_t *limits)
+{
+    static long page_kb = 0;
+    char buffer[STAT_MAX];
+    char *resident = NULL;
+
+    if (0 == page_kb)
+    {
+        page_kb = sysconf(_SC_PAGESIZE) / 1024;
+    }
+
+    /* size resident shared text lib data dt, in pages */
+    if (0 != ReadProc(limits->statm_fd, buffer, sizeof(buffer)))
+    {
+        return 0;
+    }
+    strtoull(buffer, &resident, 10);
+
+    return strtoull(resident, NULL, 10) * (uint64_t)page_kb;
+}
+
+
+static uint64_t SampleCpuTicks(wd_limits_t *limits)
+{
+    char buffer[STAT_MAX];
+    char *field = NULL;
+    uint64_t utime = 0;
+    size_t i = 0;
+
+    /* the command may hold spaces and parentheses - the fields start after
+       its last ')' */
+    if (0 != ReadProc(limits->stat_fd, buffer, sizeof(buffer))
+                                || NULL == (field = strrchr(buffer, ')')))
+    {
+        return 0;
+    }
+
+    ++field;
+    for (i = 0; i < STAT_FIELDS_TO_UTIME && NULL != field; ++i)
+    {
+        field = strchr(field + 1, ' ');
+    }
+    if (NULL == field)
+    {
+        return 0;
+    }
+    utime = strtoull(field, &field, 10);
+
+    return utime + strtoull(field, NULL, 10);
+}
+
+
+static void SampleCpu(wd_limits_t *limits, uint64_t now_ns)
+{
+    static long tick_hz = 0;
+    uint64_t ticks = 0;
+
+    if (0 == tick_hz)
+    {
+        tick_hz = sysconf(_SC_CLK_TCK);
+    }
+
+    /* the stat file is the dearest - read once a period */
+    if (0 != limits->cpu_ns
+                    && now_ns - limits->cpu_ns < WD_LIMITS_CPU_PERIOD_NS)
+    {
+        return;
+    }
+
+    ticks = SampleCpuTicks(limits);
+    if (0 == limits->cpu_ns)
+    {
+        limits->cpu_ticks = ticks;
+        limits->cpu_ns = now_ns;
+        return;
+    }
+
+    limits->usage[WD_LIMIT_CPU] = (ticks - limits->cpu_ticks) * 100
+                        * MONO_NS_PER_SEC / (uint64_t)tick_hz
+                        / (now_ns - limits->cpu_ns);
+    limits->cpu_ticks = ticks;
+    limits->cpu_ns = now_ns;
+}
+
+
+static uint64_t SampleFds(wd_limits_t *limits)
+{
+    /* the records are 8-byte aligned */
+    uint64_t records[DIRENTS_MAX / sizeof(uint64_t)];
+    char *buffer = (char *)records;
+    uint64_t entries = 0;
+    struct stat info;
+    long n = 0;
+
+    /* the size of the directory is the count since Linux 6.2 - O(1), older
+       kernels say 0 */
+    if (0 == fstat(limits->fd_dir, &info) && 0 < info.st_size)
+    {
+        return (uint64_t)info.st_size;
+    }
+
+    if (-1 == lseek(limits->fd_dir, 0, SEEK_SET))
+    {
+        return 0;
+    }
+
+    while (0 < (n = syscall(SYS_getdents64, limits->fd_dir, records,
+                                                            sizeof(records))))
+    {
+        long offset = 0;
+
+        while (offset < n)
+        {
+            offset += ((dirent_head_t *)(buffer + offset))->reclen;
+            ++entries;
+        }
+    }
+
+    /* . and .. */
+    return (2 < entries) ? entries - 2 : 0;
+}
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : resource limits of the user process - its RSS, CPU
+ *              and open files sampled from /proc through handles kept open
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#ifndef __WD_LIMITS_H_OL108_ILRD__
+#define __WD_LIMITS_H_OL108_ILRD__
+
+#include <stdint.h>     /* uint64_t */
+#include <sys/types.h>  /* pid_t */
+
+#define WD_LIMITS_CPU_PERIOD_NS 1000000000ul /* the CPU use is of a second */
+
+typedef enum
+{
+    WD_LIMIT_RSS,       /* kB */
+    WD_LIMIT_CPU,       /* percent of a CPU */
+    WD_LIMIT_FDS,       /* open file descriptors */
+    WD_LIMITS
+} wd_limit_t;
+
+/* set max and window_ns, the rest is kept by the functions */
+typedef struct
+{
+    uint64_t max[WD_LIMITS];    /* 0 - no limit */
+    uint64_t window_ns;         /* how long a limit is crossed on end */
+    uint64_t usage[WD_LIMITS];  /* of the last sample */
+    uint64_t over_ns[WD_LIMITS]; /* MonoNowNs() it crossed at, 0 under */
+    int statm_fd;               /* /proc/<pid>/statm, read with pread() */
+    int stat_fd;                /* /proc/<pid>/stat */
+    int fd_dir;                 /* /proc/<pid>/fd, read from its start */
+    uint64_t cpu_ticks;         /* utime + stime at the start of the period */
+    uint64_t cpu_ns;            /* MonoNowNs() of it */
+} wd_limits_t;
+
+
+/**
+ * @Description: Opens the /proc files of a process, for the limits set.
+ * @Parameters: limits - max and window_ns set, the files of a process it
+ *                       sampled before closed (WdLimitsClose).
+ *              pid - the process.
+ * @Return: 0 on success, -1 if a file did not open.
+ * @Notes: The files stay open, close-on-exec, until WdLimitsClose.
+**/
+int WdLimitsOpen(wd_limits_t *limits, pid_t pid);
+
+
+/**
+ * @Description: Closes the /proc files.
+ * @Parameters: limits - opened by WdLimitsOpen.
+ * @Return: void.
+**/
+void WdLimitsClose(wd_limits_t *limits);
+
+
+/**
+ * @Description: Samples the usage of the process, of the limits set.
+ * @Parameters: limits - opened by WdLimitsOpen.
+ *              now_ns - MonoNowNs().
+ * @Return: The limit the process has been over for window_ns, -1 if none.
+ * @Notes: The RSS and the CPU are a pread() each, the open files an fstat()
+ *         of their directory (a read of it, O(fds), before Linux 6.2). The
+ *         CPU use is updated once a
+ *         WD_LIMITS_CPU_PERIOD_NS (the clock ticks of the kernel are too
+ *         coarse for less).
+**/
+int WdLimitsSample(wd_limits_t *limits, uint64_t now_ns);
+
+#endif /* __WD_LIMITS_H_OL108_ILRD__ */
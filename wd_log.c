@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : binary event log in shared memory
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#include "wd_shm.h"         /* WdShmCreate(), WdShmOpen() */
+#include "wd_log.h"
+
+#define LOG_MASK (WD_LOG_ENTRIES - 1)
+/******************************************************************************/
+static const char *event_names[WD_EVENTS] =
+{
+    "start",
+    "sent",
+    "received",
+    "missed",
+    "peer_exited",
+    "revive",
+    "promote",
+    "suspect",
+    "stalled",
+    "limit",
+    "quarantine"
+};
+/******************************************************************************/
+wd_log_t *WdLogCreate(const char *name)
+{
+    return (wd_log_t *)WdShmCreate(name, sizeof(wd_log_t), WD_LOG_MAGIC,
+                                                            WD_LOG_VERSION);
+}
+
+
+const wd_log_t *WdLogOpen(const char *name)
+{
+    return (const wd_log_t *)WdShmOpen(name, sizeof(wd_log_t), WD_LOG_MAGIC,
+                                                            WD_LOG_VERSION);
+}
+
+
+void WdLogClose(const wd_log_t *log)
+{
+    WdShmClose(log, sizeof(wd_log_t));
+}
+
+
+int WdLogUnlink(const char *name)
+{
+    return WdShmUnlink(name);
+}
+
+
+void WdLogWrite(wd_log_t *log, int32_t pid, wd_event_t type, int64_t value,
+                                                                uint64_t now_ns)
+{
+    uint64_t index = __atomic_fetch_add(&log->head, 1, __ATOMIC_RELAXED);
+    wd_log_entry_t *entry = &log->entries[index & LOG_MASK];
+
+    /* a seqlock of one writer - a reader drops the entry while seq is 0 or
+       of another lap */
+    __atomic_store_n(&entry->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&entry->time_ns, now_ns, __ATOMIC_RELAXED);
+    __atomic_store_n(&entry->pid, pid, __ATOMIC_RELAXED);
+    __atomic_store_n(&entry->type, (uint32_t)type, __ATOMIC_RELAXED);
+    __atomic_store_n(&entry->value, value, __ATOMIC_RELAXED);
+    __atomic_store_n(&entry->seq, index + 1, __ATOMIC_RELEASE);
+}
+
+
+uint64_t WdLogHead(const wd_log_t *log)
+{
+    return __atomic_load_n(&log->head, __ATOMIC_ACQUIRE);
+}
+
+
+int WdLogRead(const wd_log_t *log, uint64_t index, wd_log_entry_t *entry)
+{
+    const wd_log_entry_t *at = &log->entries[index & LOG_MASK];
+
+    if (index + 1 != __atomic_load_n(&at->seq, __ATOMIC_ACQUIRE))
+    {
+        return 1;
+    }
+
+    entry->time_ns = __atomic_load_n(&at->time_ns, __ATOMIC_RELAXED);
+    entry->pid = __atomic_load_n(&at->pid, __ATOMIC_RELAXED);
+    entry->type = __atomic_load_n(&at->type, __ATOMIC_RELAXED);
+    entry->value = __atomic_load_n(&at->value, __ATOMIC_RELAXED);
+    entry->seq = index + 1;
+
+    /* a writer of a later lap may have started meanwhile */
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    return (index + 1 == __atomic_load_n(&at->seq, __ATOMIC_RELAXED)) ? 0 : 1;
+}
+
+
+const char *WdLogEventName(uint32_t type)
+{
+    return (type < WD_EVENTS) ? event_names[type] : "unknown";
+}
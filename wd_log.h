@@ -0,0 +1,141 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : binary event log in shared memory
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#ifndef __WD_LOG_H_OL108_ILRD__
+#define __WD_LOG_H_OL108_ILRD__
+
+#include <stdint.h> /* uint32_t, uint64_t, int32_t, int64_t */
+
+#include "wd_shm.h" /* wd_shm_header_t */
+
+/* a ring per pair, /dev/shm/wd_log.<id of its statistics> - it outlives a
+   crash of the pair */
+#define WD_LOG_PREFIX "/wd_log."
+#define WD_LOG_NAME_MAX 32
+#define WD_LOG_MAGIC 0x57444c47u
+#define WD_LOG_VERSION 1u
+#define WD_LOG_ENTRIES 4096     /* a power of two */
+
+typedef enum
+{
+    WD_EVENT_START,         /* value - the pid of the peer */
+    WD_EVENT_SENT,          /* value - the pid the heartbeat was sent to */
+    WD_EVENT_RECEIVED,      /* value - heartbeats since the last check */
+    WD_EVENT_MISSED,        /* value - misses in a row */
+    WD_EVENT_PEER_EXITED,   /* value - the pid of the peer */
+    WD_EVENT_REVIVE,        /* value - the pid of the peer it replaces */
+    WD_EVENT_PROMOTE,       /* value - the pid of the standby promoted */
+    WD_EVENT_SUSPECT,       /* value - phi of the peer x 1000, at revival */
+    WD_EVENT_STALLED,       /* value - the progress slot that stood still */
+    WD_EVENT_LIMIT,         /* value - the limit crossed (wd_limits.h) */
+    WD_EVENT_QUARANTINE,    /* value - the pid of the peer given up */
+    WD_EVENTS
+} wd_event_t;
+
+typedef struct
+{
+    uint64_t seq;           /* its index + 1 once written, 0 while written */
+    uint64_t time_ns;       /* MonoNowNs() */
+    int32_t pid;            /* of the writer */
+    uint32_t type;          /* wd_event_t */
+    int64_t value;
+} wd_log_entry_t;
+
+/* the writers take entries from head, the oldest are overwritten */
+typedef struct
+{
+    wd_shm_header_t header;
+    char pad[56];
+    uint64_t head;          /* entries taken so far, alone in its line */
+    char pad2[56];
+    wd_log_entry_t entries[WD_LOG_ENTRIES];
+} wd_log_t;
+
+
+/**
+ * @Description: Opens the event log of a pair for writing, creates it if it
+ *               does not exist.
+ * @Parameters: name - the name of the segment (WD_LOG_PREFIX and an id).
+ * @Return: The mapped log, NULL on failure.
+**/
+wd_log_t *WdLogCreate(const char *name);
+
+
+/**
+ * @Description: Maps the event log of a pair for reading.
+ * @Parameters: name - the name of the segment.
+ * @Return: The mapped log (read only), NULL on failure or if the segment is
+ *          not of this version.
+ * @Notes: The readers take no lock and write nothing.
+**/
+const wd_log_t *WdLogOpen(const char *name);
+
+
+/**
+ * @Description: Unmaps the log.
+ * @Parameters: log - of WdLogCreate or WdLogOpen.
+ * @Return: void.
+**/
+void WdLogClose(const wd_log_t *log);
+
+
+/**
+ * @Description: Removes the segment - mapped logs stay valid.
+ * @Parameters: name - the name of the segment.
+ * @Return: 0 on success, -1 on failure.
+**/
+int WdLogUnlink(const char *name);
+
+
+/**
+ * @Description: Writes an event.
+ * @Parameters: log - the log.
+ *              pid - the writing process.
+ *              type - a wd_event_t.
+ *              value - see wd_event_t.
+ *              now_ns - MonoNowNs() of the event.
+ * @Return: void.
+ * @Notes: Lock free, for any number of writers - an atomic add and five
+ *         stores, no system call.
+ * @Complexity: O(1).
+**/
+void WdLogWrite(wd_log_t *log, int32_t pid, wd_event_t type, int64_t value,
+                                                            uint64_t now_ns);
+
+
+/**
+ * @Description: Gets the number of events written so far.
+ * @Parameters: log - the log.
+ * @Return: The index of the next event - the last WD_LOG_ENTRIES before it
+ *          are in the ring.
+ * @Complexity: O(1).
+**/
+uint64_t WdLogHead(const wd_log_t *log);
+
+
+/**
+ * @Description: Reads an event.
+ * @Parameters: log - the log.
+ *              index - the index of the event (below WdLogHead()).
+ *              entry - set to the event.
+ * @Return: 0 on success, 1 if the event was overwritten or is still being
+ *          written.
+ * @Complexity: O(1).
+**/
+int WdLogRead(const wd_log_t *log, uint64_t index, wd_log_entry_t *entry);
+
+
+/**
+ * @Description: Gets the name of an event type.
+ * @Parameters: type - a wd_event_t.
+ * @Return: The name, "unknown" for other values.
+ * @Complexity: O(1).
+**/
+const char *WdLogEventName(uint32_t type);
+
+#endif /* __WD_LOG_H_OL108_ILRD__ */
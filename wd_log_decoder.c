@@ -0,0 +1,163 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : decoder of the event logs of the pairs - dumps the
+ *              events in the rings, or drains them as they are written
+ *
+ * Infinity Labs OL108
+ *
+ * usage - wd_events [-f] [segment...] (default every /dev/shm/wd_log.*)
+ *         -f - follow, the new events every FOLLOW_US
+ * output (CSV) - log,index,time_ns,pid,event,value
+ *                (a "lost" event counts the events overwritten before they
+ *                were read, in value)
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <dirent.h>     /* opendir(), readdir(), closedir() */
+#include <stdio.h>      /* printf() */
+#include <string.h>     /* strcmp(), strncmp(), strlen() */
+#include <unistd.h>     /* usleep() */
+
+#include "wd_log.h"
+
+#define SHM_DIR "/dev/shm"
+#define MAX_LOGS 64
+#define FOLLOW_US 100000
+#define IN_FLIGHT 16            /* entries near head may still be written */
+/******************************************************************************/
+typedef struct
+{
+    char name[WD_LOG_NAME_MAX + 1];
+    const wd_log_t *log;
+    uint64_t next;              /* the next event to read */
+} reader_t;
+
+static size_t FindLogs(reader_t *readers);
+static void Drain(reader_t *reader, int is_follow);
+/******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static reader_t readers[MAX_LOGS];
+    int is_follow = (1 < argc && 0 == strcmp("-f", argv[1]));
+    int first = 1 + is_follow;
+    size_t n = 0, i = 0;
+
+    if (first < argc)
+    {
+        for (i = 0; (int)i + first < argc && i < MAX_LOGS; ++i)
+        {
+            sprintf(readers[i].name, "%.*s", WD_LOG_NAME_MAX,
+                                                        argv[i + first]);
+        }
+        n = i;
+    }
+    else
+    {
+        n = FindLogs(readers);
+    }
+
+    for (i = 0; i < n; ++i)
+    {
+        readers[i].log = WdLogOpen(readers[i].name);
+        if (NULL == readers[i].log)
+        {
+            fprintf(stderr, "%s: no event log\n", readers[i].name);
+        }
+    }
+
+    printf("log,index,time_ns,pid,event,value\n");
+    do
+    {
+        for (i = 0; i < n; ++i)
+        {
+            Drain(&readers[i], is_follow);
+        }
+        fflush(stdout);
+    }
+    while (is_follow && 0 == usleep(FOLLOW_US));
+
+    for (i = 0; i < n; ++i)
+    {
+        if (NULL != readers[i].log)
+        {
+            WdLogClose(readers[i].log);
+        }
+    }
+
+    return 0;
+}
+
+/******************************************************************************/
+static size_t FindLogs(reader_t *readers)
+{
+    DIR *dir = opendir(SHM_DIR);
+    struct dirent *entry = NULL;
+    size_t prefix_len = strlen(WD_LOG_PREFIX) - 1;
+    size_t n = 0;
+
+    if (NULL == dir)
+    {
+        return 0;
+    }
+
+    /* shm_open names are the files of /dev/shm, without the slash */
+    while (n < MAX_LOGS && NULL != (entry = readdir(dir)))
+    {
+        if (0 == strncmp(WD_LOG_PREFIX + 1, entry->d_name, prefix_len))
+        {
+            sprintf(readers[n].name, "/%.*s", WD_LOG_NAME_MAX - 1,
+                                                            entry->d_name);
+            ++n;
+        }
+    }
+    closedir(dir);
+
+    return n;
+}
+
+
+static void Drain(reader_t *reader, int is_follow)
+{
+    uint64_t head = 0;
+    wd_log_entry_t entry;
+
+    if (NULL == reader->log)
+    {
+        return;
+    }
+
+    /* the ring keeps the last WD_LOG_ENTRIES */
+    head = WdLogHead(reader->log);
+    if (head - reader->next > WD_LOG_ENTRIES)
+    {
+        if (0 != reader->next)
+        {
+            printf("%s,%lu,,,lost,%lu\n", reader->name,
+                    (unsigned long)reader->next,
+                    (unsigned long)(head - WD_LOG_ENTRIES - reader->next));
+        }
+        reader->next = head - WD_LOG_ENTRIES;
+    }
+
+    for (; reader->next < head; ++reader->next)
+    {
+        /* overwritten meanwhile, or taken and not written yet - followed,
+           it is read again at the next poll (a writer that crashed left it
+           empty for good) */
+        if (0 != WdLogRead(reader->log, reader->next, &entry))
+        {
+            if (is_follow && head - reader->next <= IN_FLIGHT)
+            {
+                break;
+            }
+            continue;
+        }
+
+        printf("%s,%lu,%lu,%d,%s,%ld\n", reader->name,
+                (unsigned long)reader->next, (unsigned long)entry.time_ns,
+                (int)entry.pid, WdLogEventName(entry.type),
+                (long)entry.value);
+    }
+}
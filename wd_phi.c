@@ -0,0 +1,126 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : phi accrual failure detector - the suspicion that
+ *              the peer is dead or hung, from the gaps between its heartbeats
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#include <math.h>       /* exp(), log10(), sqrt() */
+
+#include "mono_clock.h" /* MONO_NS_PER_MS */
+#include "wd_phi.h"
+
+/* the logistic approximation of the normal distribution (Bowling et al.),
+   good to 1.4e-4 - no erfc() in C89 */
+#define LOGISTIC_A 1.5976
+#define LOGISTIC_B 0.070566
+#define LN_10 2.302585092994046
+
+static void AddGap(wd_phi_t *phi, double gap);
+static void SumWindow(wd_phi_t *phi);
+/******************************************************************************/
+void WdPhiInit(wd_phi_t *phi, uint64_t interval_ns, uint64_t now_ns)
+{
+    double interval = (double)interval_ns / MONO_NS_PER_MS;
+
+    phi->n = 0;
+    phi->next = 0;
+    phi->sum = 0;
+    phi->sum_sq = 0;
+    phi->min_stddev = interval / WD_PHI_MIN_STDDEV_DIV;
+    phi->last_ns = now_ns;
+
+    AddGap(phi, interval - interval / 4);
+    AddGap(phi, interval + interval / 4);
+}
+
+
+void WdPhiBeat(wd_phi_t *phi, uint64_t now_ns)
+{
+    if (now_ns > phi->last_ns)
+    {
+        AddGap(phi, (double)(now_ns - phi->last_ns) / MONO_NS_PER_MS);
+    }
+    phi->last_ns = now_ns;
+}
+
+
+void WdPhiRestart(wd_phi_t *phi, uint64_t now_ns)
+{
+    phi->last_ns = now_ns;
+}
+
+
+double WdPhi(const wd_phi_t *phi, uint64_t now_ns)
+{
+    double mean = phi->sum / phi->n;
+    double variance = phi->sum_sq / phi->n - mean * mean;
+    double stddev = (0 < variance) ? sqrt(variance) : 0;
+    double since = 0, y = 0, exponent = 0;
+
+    if (now_ns <= phi->last_ns)
+    {
+        return 0;
+    }
+
+    since = (double)(now_ns - phi->last_ns) / MONO_NS_PER_MS;
+    if (stddev < phi->min_stddev)
+    {
+        stddev = phi->min_stddev;
+    }
+
+    y = (since - mean) / stddev;
+    exponent = y * (LOGISTIC_A + LOGISTIC_B * y * y);
+
+    /* past the mean -log10(e / (1 + e)), with e = exp(-exponent) - kept off
+       exp() of a large exponent, which underflows to a phi of infinity */
+    if (0 < y)
+    {
+        return exponent / LN_10 + log10(1 + exp(-exponent));
+    }
+
+    return -log10(1 - 1 / (1 + exp(-exponent)));
+}
+
+/******************************************************************************/
+static void AddGap(wd_phi_t *phi, double gap)
+{
+    if (WD_PHI_WINDOW == phi->n)
+    {
+        double old = phi->gaps[phi->next];
+
+        phi->sum -= old;
+        phi->sum_sq -= old * old;
+    }
+    else
+    {
+        ++phi->n;
+    }
+
+    phi->gaps[phi->next] = gap;
+    phi->sum += gap;
+    phi->sum_sq += gap * gap;
+    phi->next = (phi->next + 1) % WD_PHI_WINDOW;
+
+    /* the subtractions leave rounding behind them */
+    if (0 == phi->next)
+    {
+        SumWindow(phi);
+    }
+}
+
+
+static void SumWindow(wd_phi_t *phi)
+{
+    size_t i = 0;
+
+    phi->sum = 0;
+    phi->sum_sq = 0;
+    for (i = 0; i < phi->n; ++i)
+    {
+        phi->sum += phi->gaps[i];
+        phi->sum_sq += phi->gaps[i] * phi->gaps[i];
+    }
+}
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : phi accrual failure detector - the suspicion that
+ *              the peer is dead or hung, from the gaps between its heartbeats
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#ifndef __WD_PHI_H_OL108_ILRD__
+#define __WD_PHI_H_OL108_ILRD__
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint64_t */
+
+#define WD_PHI_WINDOW 256       /* the gaps the model is made of */
+#define WD_PHI_MIN_STDDEV_DIV 10 /* the deviation is an interval / 10 at least */
+
+/* the gaps are kept in milliseconds - the sums are of doubles */
+typedef struct
+{
+    double gaps[WD_PHI_WINDOW];
+    size_t n;                   /* gaps in the window */
+    size_t next;                /* the slot of the next gap */
+    double sum;
+    double sum_sq;
+    double min_stddev;
+    uint64_t last_ns;           /* MonoNowNs() of the last heartbeat */
+} wd_phi_t;
+
+
+/**
+ * @Description: Starts a detector for a peer that beats at an interval.
+ * @Parameters: phi - the detector.
+ *              interval_ns - the expected gap between heartbeats.
+ *              now_ns - MonoNowNs(), the peer is seen as just beating.
+ * @Return: void.
+ * @Notes: The window starts with an interval / 4 on either side of the
+ *         interval - the first heartbeats are judged by it.
+**/
+void WdPhiInit(wd_phi_t *phi, uint64_t interval_ns, uint64_t now_ns);
+
+
+/**
+ * @Description: Adds a heartbeat - the gap since the last one joins the
+ *               window, the oldest gap leaves it.
+ * @Parameters: phi - the detector.
+ *              now_ns - MonoNowNs() of the heartbeat.
+ * @Return: void.
+ * @Complexity: O(1) - O(WD_PHI_WINDOW) once a window, to drop the rounding
+ *              of the sums.
+**/
+void WdPhiBeat(wd_phi_t *phi, uint64_t now_ns);
+
+
+/**
+ * @Description: Starts the peer over - a revived one is seen as just beating,
+ *               the window is kept.
+ * @Parameters: phi - the detector.
+ *              now_ns - MonoNowNs().
+ * @Return: void.
+ * @Complexity: O(1).
+**/
+void WdPhiRestart(wd_phi_t *phi, uint64_t now_ns);
+
+
+/**
+ * @Description: Gets the suspicion level of the peer.
+ * @Parameters: phi - the detector.
+ *              now_ns - MonoNowNs().
+ * @Return: phi = -log10(the probability of a gap at least as long as the
+ *          one since the last heartbeat), under a normal distribution of the
+ *          gaps in the window - 1 is a 10% chance the peer is alive, 8 is
+ *          1e-8.
+ * @Complexity: O(1).
+**/
+double WdPhi(const wd_phi_t *phi, uint64_t now_ns);
+
+#endif /* __WD_PHI_H_OL108_ILRD__ */
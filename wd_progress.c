@@ -0,0 +1,163 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : progress slots of the application threads - a
+ *              thread that stops advancing its counter holds the heartbeats
+ *              of the process back
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#include <stddef.h>         /* size_t */
+
+#include "mono_clock.h"     /* MonoNowNs() */
+#include "wd_channel.h"     /* WD_CACHE_LINE */
+#include "wd_progress.h"
+
+/* the life of a slot - a registering thread claims it and sets it up, the
+   check starts its clock */
+enum
+{
+    SLOT_FREE,
+    SLOT_CLAIMED,
+    SLOT_NEW,
+    SLOT_WATCHED
+};
+
+/* the side of a slot the check reads and writes, away from the counters */
+typedef struct
+{
+    int state;
+    pthread_t owner;
+    uint64_t budget_ns;
+    uint64_t seen;              /* the count at its last change */
+    uint64_t seen_ns;           /* MonoNowNs() of it */
+} watch_t;
+
+static wd_progress_t slots[WD_PROGRESS_SLOTS]
+                                    __attribute__((aligned(WD_CACHE_LINE)));
+static watch_t watches[WD_PROGRESS_SLOTS];
+static int registered = 0;
+/******************************************************************************/
+wd_progress_t *WatchDogProgressSlot(unsigned long stall_budget_ms)
+{
+    size_t i = 0;
+
+    for (i = 0; i < WD_PROGRESS_SLOTS; ++i)
+    {
+        int expected = SLOT_FREE;
+
+        if (__atomic_compare_exchange_n(&watches[i].state, &expected,
+                    SLOT_CLAIMED, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            watches[i].owner = pthread_self();
+            watches[i].budget_ns = (uint64_t)stall_budget_ms * MONO_NS_PER_MS;
+            __atomic_store_n(&slots[i].count, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&watches[i].state, SLOT_NEW, __ATOMIC_RELEASE);
+            __atomic_add_fetch(&registered, 1, __ATOMIC_RELAXED);
+
+            return &slots[i];
+        }
+    }
+
+    return NULL;
+}
+
+
+void WatchDogProgressRelease(wd_progress_t *slot)
+{
+    size_t i = 0;
+
+    /* compared one by one - a subtraction is undefined for a pointer out of
+       slots, a NULL one included */
+    while (i < WD_PROGRESS_SLOTS && slot != &slots[i])
+    {
+        ++i;
+    }
+    if (WD_PROGRESS_SLOTS == i)
+    {
+        return;
+    }
+
+    if (SLOT_FREE != __atomic_exchange_n(&watches[i].state, SLOT_FREE,
+                                                        __ATOMIC_RELEASE))
+    {
+        __atomic_sub_fetch(&registered, 1, __ATOMIC_RELAXED);
+    }
+}
+
+
+int WdProgressStalled(void)
+{
+    uint64_t now = 0;
+    int stalled = -1;
+    size_t i = 0;
+
+    /* the heartbeats of a process without slots pay a load */
+    if (0 == __atomic_load_n(&registered, __ATOMIC_RELAXED))
+    {
+        return -1;
+    }
+
+    now = MonoNowNs();
+    for (i = 0; i < WD_PROGRESS_SLOTS; ++i)
+    {
+        watch_t *watch = &watches[i];
+        int state = __atomic_load_n(&watch->state, __ATOMIC_ACQUIRE);
+        uint64_t count = __atomic_load_n(&slots[i].count, __ATOMIC_RELAXED);
+
+        if (SLOT_NEW == state)
+        {
+            /* released meanwhile, the slot stays free */
+            if (__atomic_compare_exchange_n(&watch->state, &state,
+                    SLOT_WATCHED, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+            {
+                watch->seen = count;
+                watch->seen_ns = now;
+            }
+        }
+        else if (SLOT_WATCHED == state)
+        {
+            if (count != watch->seen)
+            {
+                watch->seen = count;
+                watch->seen_ns = now;
+            }
+            else if (-1 == stalled && now - watch->seen_ns > watch->budget_ns)
+            {
+                stalled = (int)i;
+            }
+        }
+    }
+
+    return stalled;
+}
+
+
+void WdProgressKeep(pthread_t owner)
+{
+    size_t i = 0;
+
+    for (i = 0; i < WD_PROGRESS_SLOTS; ++i)
+    {
+        /* a slot claimed by a thread left behind is never set up */
+        if (SLOT_CLAIMED == watches[i].state)
+        {
+            watches[i].state = SLOT_FREE;
+        }
+        if (SLOT_FREE == watches[i].state)
+        {
+            continue;
+        }
+
+        if (pthread_equal(owner, watches[i].owner))
+        {
+            watches[i].state = SLOT_NEW;
+        }
+        else
+        {
+            watches[i].state = SLOT_FREE;
+            --registered;
+        }
+    }
+}
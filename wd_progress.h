@@ -0,0 +1,40 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : progress slots of the application threads - a
+ *              thread that stops advancing its counter holds the heartbeats
+ *              of the process back
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#ifndef __WD_PROGRESS_H_OL108_ILRD__
+#define __WD_PROGRESS_H_OL108_ILRD__
+
+#include <pthread.h> /* pthread_t */
+
+#include "wd_user_process.h" /* wd_progress_t, WatchDogProgressSlot() */
+
+
+/**
+ * @Description: Checks the registered slots.
+ * @Parameters: None.
+ * @Return: The index of a slot that stood still for longer than its stall
+ *          budget, -1 if none did.
+ * @Notes: Called by the heartbeat thread only - it keeps the last count and
+ *         time of each slot.
+ * @Complexity: O(1) without slots, O(WD_PROGRESS_SLOTS) with.
+**/
+int WdProgressStalled(void);
+
+
+/**
+ * @Description: Keeps the slots of a thread and releases the others - in a
+ *               process forked with only that thread.
+ * @Parameters: owner - the thread.
+ * @Return: void.
+ * @Notes: The slots kept start their budgets over.
+**/
+void WdProgressKeep(pthread_t owner);
+
+#endif /* __WD_PROGRESS_H_OL108_ILRD__ */
@@ -6,37 +6,249 @@
  *
  * Infinity Labs OL108
 *******************************************************************************/
+#define _GNU_SOURCE
+
 #include <signal.h>     /* pthread_sigmask(), sigaddset(), sigemptyset(),
-                        sigtimedwait(), SIG_BLOCK, SIGUSR1 */
-#include <stdio.h>      /* printf() */
+                        SIG_BLOCK, SIGUSR1 */
 #include <stdlib.h>     /* getenv(), setenv() */
 #include <time.h>       /* time_t */
+#include <unistd.h>     /* read(), syscall() */
+#include <sys/syscall.h> /* SYS_pidfd_open */
+#include <sys/signalfd.h> /* signalfd(), struct signalfd_siginfo */
 
+#include "mono_clock.h" /* MonoNowNs() */
+#include "wd_phi.h"
+#include "wd_progress.h"
 #include "wd_user_process.h"
 #include "wd_shared_api.h"
 /******************************************************************************/
+/* set by StopSignalHandler (SIGUSR2), the tasks of both processes end */
+int stop_flag = 0;
+
+/* SIGUSR1 from the peer, counted by ReceiveHeartbeat as it arrives */
+static int heartbeats = 0;
+static uint64_t last_heartbeat_ns = 0;
+
+/* the shared-memory transport, NULL with signals */
+static wd_beat_t *send_beat = NULL;
+static wd_beat_t *recv_beat = NULL;
+static uint32_t recv_seen = 0;
+
+/* the side of this process in the statistics of the pair, NULL without */
+static wd_stats_side_t *stats = NULL;
+
+/* the event log of the pair, NULL without - instead of printf, which may
+   block a heartbeat behind a slow terminal */
+static wd_log_t *event_log = NULL;
+static int32_t log_pid = 0;
+
+/* the side of this process in the state of the pair, NULL without - the
+   process that takes over the role resumes from it */
+static wd_state_side_t *state = NULL;
+
+/* the gaps between the heartbeats of the peer, with a phi threshold */
+static wd_phi_t detector;
+static int use_phi = 0;
+
+/* a progress slot of the application stood still at the last heartbeat */
+static int is_stalled = 0;
+
+static int IsProgressStalled(void);
+/******************************************************************************/
 int SendSignalTask(void *arg)
 {
     pid_t pid = *(pid_t*)arg;
 
-    if(stop_flag)
+    /* a quarantined peer has none (see WatchDogQuarantined) */
+    if(stop_flag || 0 >= pid)
     {
         return 0;
     }  
+    if (IsProgressStalled())
+    {
+        return 1;
+    }
 
-    printf("pid : %d sent\n", pid);
     kill(pid, SIGUSR1);
+    LogEvent(WD_EVENT_SENT, pid);
+    if (NULL != stats)
+    {
+        WdStatsAdd(&stats->sent, 1);
+    }
+    if (NULL != state)
+    {
+        WdStateSet(&state->last_send_ns, MonoNowNs());
+    }
     
     return 1;
 }
 
 
-void InitSched(sched_t *sched, watchdog_data_t *wd_data, pid_t *pid, time_t send_interval, time_t rec_interval, receive_sig_t ReceiveSignalTask)
+int SendBeatTask(void *arg)
+{
+    if(stop_flag)
+    {
+        return 0;
+    }
+
+    UNUSED(arg);
+    if (IsProgressStalled())
+    {
+        return 1;
+    }
+
+    /* no print - this transport is meant for sub-millisecond intervals.
+       the channel changes when a replaced daemon is joined */
+    WdChannelBeat(send_beat);
+    if (NULL != stats)
+    {
+        WdStatsAdd(&stats->sent, 1);
+    }
+    if (NULL != state)
+    {
+        WdStateSet(&state->last_send_ns, MonoNowNs());
+    }
+
+    return 1;
+}
+
+
+void UseChannel(wd_beat_t *send, wd_beat_t *recv)
+{
+    send_beat = send;
+    recv_beat = recv;
+    recv_seen = (NULL == recv) ? 0 : WdChannelSeq(recv);
+}
+
+
+void UseStats(wd_stats_side_t *side)
+{
+    stats = side;
+}
+
+
+void UseLog(wd_log_t *log)
+{
+    event_log = log;
+    log_pid = (int32_t)getpid();
+}
+
+
+void UseState(wd_state_side_t *side)
+{
+    state = side;
+}
+
+
+void SaveMisses(int misses)
+{
+    if (NULL != state)
+    {
+        WdStateSet(&state->misses, (uint64_t)misses);
+    }
+}
+
+
+int IsPeerSuspect(double phi_threshold)
+{
+    double phi = WdPhi(&detector, MonoNowNs());
+
+    if (phi < phi_threshold)
+    {
+        return 0;
+    }
+    LogEvent(WD_EVENT_SUSPECT, (int64_t)(phi * 1000));
+
+    return 1;
+}
+
+
+void RestartPhi(void)
+{
+    if (use_phi)
+    {
+        WdPhiRestart(&detector, MonoNowNs());
+    }
+}
+
+
+void LogEvent(wd_event_t type, int64_t value)
+{
+    if (NULL != event_log)
+    {
+        WdLogWrite(event_log, log_pid, type, value, MonoNowNs());
+    }
+}
+
+
+void InitSched(sched_t *sched, watchdog_data_t *wd_data, pid_t *pid, uint64_t send_interval_ns, uint64_t rec_interval_ns, receive_sig_t ReceiveSignalTask, int heartbeat_fd)
 {
-    SchedAddTask(sched, SendSignalTask, time(NULL) + send_interval, send_interval, pid, CleanUp);
+    uint64_t now = MonoNowNs();
+    uint64_t check_ns = rec_interval_ns;
+    uint64_t send_at = 0, rec_at = 0;
+
+    /* the detector is asked between the heartbeats, and sees the ones on the
+       shared page a quarter interval late at most */
+    use_phi = (0 < wd_data->phi_threshold);
+    if (use_phi)
+    {
+        check_ns = rec_interval_ns / WD_PHI_CHECKS;
+        WdPhiInit(&detector, rec_interval_ns, now);
+    }
+    send_at = now + send_interval_ns;
+    rec_at = now + check_ns;
+
+    /* a process taking over a role keeps the schedule of the one before it.
+       its first check skips a point - the peer had no interval to beat to
+       it yet */
+    if (NULL != state)
+    {
+        send_at = WdStateResume(WdStateGet(&state->last_send_ns),
+                                                    send_interval_ns, now);
+        if (0 != WdStateGet(&state->last_check_ns))
+        {
+            rec_at = WdStateResume(WdStateGet(&state->last_check_ns),
+                                                check_ns, now) + check_ns;
+        }
+    }
+
+    /* the peer sends at the interval this process checks at */
+    if (NULL != stats)
+    {
+        WdStatsSet(&stats->interval_ns, rec_interval_ns);
+    }
+
+    /* heartbeats are read when they arrive, the receive task counts misses */
+    if (-1 != heartbeat_fd)
+    {
+        SchedAddFd(sched, heartbeat_fd, ReceiveHeartbeat, NULL);
+    }
+
+    if (NULL != send_beat)
+    {
+        SchedAddTaskNs(sched, SendBeatTask, send_at, send_interval_ns, NULL, CleanUp);
+    }
+    else
+    {
+        SchedAddTaskNs(sched, SendSignalTask, send_at, send_interval_ns, pid, CleanUp);
+    }
     
-    SchedAddTask(sched, ReceiveSignalTask, time(NULL) +
-    rec_interval, rec_interval, wd_data, CleanUp);
+    SchedAddTaskNs(sched, ReceiveSignalTask, rec_at, check_ns, wd_data, CleanUp);
+}
+
+
+uint64_t IntervalNs(time_t interval, unsigned long interval_ms, unsigned long interval_us)
+{
+    if (0 != interval_us)
+    {
+        return (uint64_t)interval_us * MONO_NS_PER_US;
+    }
+    if (0 != interval_ms)
+    {
+        return (uint64_t)interval_ms * MONO_NS_PER_MS;
+    }
+
+    return (uint64_t)interval * MONO_NS_PER_SEC;
 }
 
 
@@ -61,8 +273,111 @@ int SetSignalMask(sigset_t *set)
 }
 
 
+int OpenHeartbeatFd(sigset_t *set)
+{
+    /* a blocked SIGUSR1 stays pending for the signalfd to read */
+    if (0 != SetSignalMask(set))
+    {
+        return -1;
+    }
+
+    return signalfd(-1, set, SFD_NONBLOCK | SFD_CLOEXEC);
+}
+
+
+int ReceiveHeartbeat(void *arg, int fd, uint64_t now_ns)
+{
+    struct signalfd_siginfo info;
+
+    UNUSED(arg);
+
+    while (sizeof(info) == (size_t)read(fd, &info, sizeof(info)))
+    {
+        ++heartbeats;
+        __atomic_store_n(&last_heartbeat_ns, now_ns, __ATOMIC_RELAXED);
+        if (use_phi)
+        {
+            WdPhiBeat(&detector, now_ns);
+        }
+        if (NULL != stats)
+        {
+            WdStatsBeat(stats, 1, now_ns);
+        }
+    }
+
+    return 1;
+}
+
+
+int TakeHeartbeats(void)
+{
+    int count = heartbeats;
+
+    /* beats on the shared page are counted, not merged like signals */
+    if (NULL != recv_beat)
+    {
+        uint32_t seq = WdChannelSeq(recv_beat);
+
+        if (seq != recv_seen)
+        {
+            uint64_t now = MonoNowNs();
+
+            /* the gap is seen at the check, the beats have no time */
+            if (NULL != stats)
+            {
+                WdStatsBeat(stats, seq - recv_seen, now);
+            }
+            count += (int)(seq - recv_seen);
+            recv_seen = seq;
+            __atomic_store_n(&last_heartbeat_ns, now, __ATOMIC_RELAXED);
+            if (use_phi)
+            {
+                WdPhiBeat(&detector, now);
+            }
+        }
+    }
+
+    heartbeats = 0;
+    if (NULL != state)
+    {
+        WdStateSet(&state->last_check_ns, MonoNowNs());
+    }
+
+    return count;
+}
+
+
+int OpenPeerFd(pid_t pid)
+{
+    /* readable once the process exits - close-on-exec by default */
+    return (int)syscall(SYS_pidfd_open, pid, 0);
+}
+
+
+uint64_t LastHeartbeatNs(void)
+{
+    /* read by other threads of the process */
+    return __atomic_load_n(&last_heartbeat_ns, __ATOMIC_RELAXED);
+}
+
+
 void StopSignalHandler(int signum)
 {
     UNUSED(signum);
     stop_flag = 1;
 }
+
+/******************************************************************************/
+static int IsProgressStalled(void)
+{
+    int slot = WdProgressStalled();
+
+    /* no heartbeat - the peer counts a miss, as for a hung process */
+    if (-1 != slot && !is_stalled)
+    {
+        LogEvent(WD_EVENT_STALLED, slot);
+    }
+    is_stalled = (-1 != slot);
+
+    return is_stalled;
+}
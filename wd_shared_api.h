@@ -9,21 +9,51 @@
 #ifndef __WATCHDOG_SHARED_H_OL107_8_ILRD__
 #define __WATCHDOG_SHARED_H_OL107_8_ILRD__
 
+#include <stdint.h> /* uint64_t */
+
 #include "scheduler.h"
-#include "wd_shared_api.h"
+#include "wd_channel.h"
+#include "wd_log.h"
+#include "wd_state.h"
+#include "wd_stats.h"
+#include "wd_user_process.h"
 
 typedef int (*receive_sig_t) (void*);
 
-int stop_flag;
+extern int stop_flag;
 
 #define UNUSED(x) (void)(x)
 
-#define PERMISSION_ALL 0666
+/* the handshake on the socket of a watchdog process - it is set up, then
+   it runs (a standby waits for it until it is promoted) */
+#define WD_HANDSHAKE_READY 'r'
+#define WD_HANDSHAKE_GO 'g'
+
+/* checks of the peer an interval with a phi threshold - the suspicion grows
+   between its heartbeats */
+#define WD_PHI_CHECKS 4
 
 int SendSignalTask(void *arg);
+int SendBeatTask(void *arg);
+void UseChannel(wd_beat_t *send_beat, wd_beat_t *recv_beat);
+void UseStats(wd_stats_side_t *side);
+void UseLog(wd_log_t *log);
+void UseState(wd_state_side_t *side);
+void SaveMisses(int misses);
+int IsPeerSuspect(double phi_threshold);
+void RestartPhi(void);
+void LogEvent(wd_event_t type, int64_t value);
 int SetSignalMask(sigset_t *set);
+int OpenHeartbeatFd(sigset_t *set);
+int ReceiveHeartbeat(void *arg, int fd, uint64_t now_ns);
+int TakeHeartbeats(void);
+int OpenPeerFd(pid_t pid);
+uint64_t LastHeartbeatNs(void);
 void InitSched(sched_t *sched, watchdog_data_t *wd_data, pid_t *pid, 
-    time_t send_interval, time_t rec_interval, receive_sig_t ReceiveSignalTask);
+    uint64_t send_interval_ns, uint64_t rec_interval_ns, 
+    receive_sig_t ReceiveSignalTask, int heartbeat_fd);
+uint64_t IntervalNs(time_t interval, unsigned long interval_ms, 
+    unsigned long interval_us);
 void CleanUp(void *args);
 void StopSignalHandler(int signum);
 
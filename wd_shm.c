@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : named shared memory segments of a pair
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <fcntl.h>         /* O_CREAT, O_RDWR, O_RDONLY */
+#include <unistd.h>        /* ftruncate(), close() */
+#include <sys/mman.h>      /* shm_open(), shm_unlink(), mmap(), munmap() */
+#include <sys/stat.h>      /* fstat(), struct stat */
+
+#include "wd_shm.h"
+
+/* readable by the tools of any user, written by the pair */
+#define SHM_PERMISSIONS 0644
+/******************************************************************************/
+static void *Map(const char *name, size_t size, int flags, int prot);
+/******************************************************************************/
+void *WdShmCreate(const char *name, size_t size, uint32_t magic,
+                                                            uint32_t version)
+{
+    wd_shm_header_t *header = (wd_shm_header_t *)Map(name, size,
+                                    O_CREAT | O_RDWR, PROT_READ | PROT_WRITE);
+
+    /* a new segment reads as zeros - the magic last, for the readers */
+    if (NULL != header && magic != header->magic)
+    {
+        header->version = version;
+        __atomic_store_n(&header->magic, magic, __ATOMIC_RELEASE);
+    }
+
+    return header;
+}
+
+
+const void *WdShmOpen(const char *name, size_t size, uint32_t magic,
+                                                            uint32_t version)
+{
+    const wd_shm_header_t *header = (const wd_shm_header_t *)Map(name, size,
+                                                        O_RDONLY, PROT_READ);
+
+    if (NULL != header
+            && (magic != __atomic_load_n(&header->magic, __ATOMIC_ACQUIRE)
+                || version != header->version))
+    {
+        WdShmClose(header, size);
+        header = NULL;
+    }
+
+    return header;
+}
+
+
+void WdShmClose(const void *segment, size_t size)
+{
+    munmap((void *)segment, size);
+}
+
+
+int WdShmUnlink(const char *name)
+{
+    return shm_unlink(name);
+}
+
+/******************************************************************************/
+static void *Map(const char *name, size_t size, int flags, int prot)
+{
+    void *map = MAP_FAILED;
+    struct stat st;
+    int fd = shm_open(name, flags, SHM_PERMISSIONS);
+
+    if (-1 == fd)
+    {
+        return NULL;
+    }
+    if (0 != fstat(fd, &st))
+    {
+        close(fd);
+        return NULL;
+    }
+
+    /* a new segment is empty - a reader never grows one */
+    if ((size_t)st.st_size < size && (flags & O_CREAT))
+    {
+        if (0 != ftruncate(fd, (off_t)size))
+        {
+            close(fd);
+            return NULL;
+        }
+        st.st_size = (off_t)size;
+    }
+    if ((size_t)st.st_size >= size)
+    {
+        map = mmap(NULL, size, prot, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+
+    return (MAP_FAILED == map) ? NULL : map;
+}
@@ -0,0 +1,65 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : named shared memory segments of a pair (the
+ *              statistics, the event log) - created by the pair, mapped
+ *              read only by the tools of any user
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#ifndef __WD_SHM_H_OL108_ILRD__
+#define __WD_SHM_H_OL108_ILRD__
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint32_t */
+
+/* the first member of a segment - a reader takes it once magic is set */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+} wd_shm_header_t;
+
+
+/**
+ * @Description: Maps a segment for writing, creates it if it does not exist.
+ * @Parameters: name - the name of the segment.
+ *              size - the size of the segment, a wd_shm_header_t first.
+ *              magic, version - set in the header of a new segment.
+ * @Return: The mapped segment, NULL on failure.
+ * @Notes: A new segment reads as zeros. An existing one is mapped as it is.
+**/
+void *WdShmCreate(const char *name, size_t size, uint32_t magic,
+                                                            uint32_t version);
+
+
+/**
+ * @Description: Maps a segment for reading.
+ * @Parameters: name - the name of the segment.
+ *              size - the size of the segment.
+ *              magic, version - expected in its header.
+ * @Return: The mapped segment (read only), NULL on failure, if it is smaller
+ *          than size or its header is not of magic and version.
+**/
+const void *WdShmOpen(const char *name, size_t size, uint32_t magic,
+                                                            uint32_t version);
+
+
+/**
+ * @Description: Unmaps a segment.
+ * @Parameters: segment - of WdShmCreate or WdShmOpen.
+ *              size - its size.
+ * @Return: void.
+**/
+void WdShmClose(const void *segment, size_t size);
+
+
+/**
+ * @Description: Removes a segment - mapped ones stay valid.
+ * @Parameters: name - the name of the segment.
+ * @Return: 0 on success, -1 on failure.
+**/
+int WdShmUnlink(const char *name);
+
+#endif /* __WD_SHM_H_OL108_ILRD__ */
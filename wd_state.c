@@ -0,0 +1,287 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : the configuration and the runtime state of a pair,
+ *              in a memory file inherited by the processes that revive it
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <string.h>        /* strlen(), memcpy() */
+#include <unistd.h>        /* ftruncate(), close() */
+#include <sys/mman.h>      /* memfd_create(), mmap(), munmap() */
+#include <sys/stat.h>      /* fstat(), struct stat */
+
+#include "mono_clock.h"     /* MONO_NS_PER_MS */
+#include "wd_state.h"
+/******************************************************************************/
+static wd_state_t *Map(int fd);
+static int CopyPath(char *to, const char *from);
+static uint64_t Backoff(uint64_t base_ns, uint64_t recent, uint64_t cap_ns,
+                                                            uint64_t now_ns);
+/******************************************************************************/
+wd_state_t *WdStateCreate(int *fd)
+{
+    wd_state_t *state = NULL;
+
+    /* not close-on-exec - the watchdog process maps it after exec, and the
+       user process it revives by exec after it */
+    *fd = memfd_create("watchdog_state", 0);
+    if (-1 == *fd)
+    {
+        return NULL;
+    }
+
+    /* a new file reads as zeros - no side ran yet */
+    if (0 != ftruncate(*fd, (off_t)sizeof(wd_state_t)))
+    {
+        close(*fd);
+        *fd = -1;
+        return NULL;
+    }
+
+    state = Map(*fd);
+    if (NULL == state)
+    {
+        close(*fd);
+        *fd = -1;
+        return NULL;
+    }
+    state->version = WD_STATE_VERSION;
+    state->config.channel_fd = -1;
+    __atomic_store_n(&state->magic, WD_STATE_MAGIC, __ATOMIC_RELEASE);
+
+    return state;
+}
+
+
+wd_state_t *WdStateOpen(int fd)
+{
+    struct stat st;
+    wd_state_t *state = NULL;
+
+    /* the fd may be stale - a file of another size is not a state */
+    if (0 > fd || 0 != fstat(fd, &st)
+                                || (off_t)sizeof(wd_state_t) != st.st_size)
+    {
+        return NULL;
+    }
+
+    state = Map(fd);
+    if (NULL != state
+            && (WD_STATE_MAGIC != __atomic_load_n(&state->magic,
+                                                        __ATOMIC_ACQUIRE)
+                || WD_STATE_VERSION != state->version))
+    {
+        WdStateClose(state);
+        state = NULL;
+    }
+
+    return state;
+}
+
+
+void WdStateClose(wd_state_t *state)
+{
+    munmap(state, sizeof(wd_state_t));
+}
+
+
+int WdStateSetConfig(wd_state_t *state, const watchdog_data_t *wd_data,
+                                                            int channel_fd)
+{
+    wd_state_config_t *config = &state->config;
+
+    if (0 != CopyPath(config->watchdog_path, wd_data->watchdog_path)
+            || 0 != CopyPath(config->process_path, wd_data->process_path))
+    {
+        return -1;
+    }
+
+    config->to_wd_interval = (int64_t)wd_data->signal_to_wd_interval;
+    config->from_wd_interval = (int64_t)wd_data->signal_from_wd_interval;
+    config->to_wd_interval_ms = wd_data->signal_to_wd_interval_ms;
+    config->from_wd_interval_ms = wd_data->signal_from_wd_interval_ms;
+    config->to_wd_interval_us = wd_data->signal_to_wd_interval_us;
+    config->from_wd_interval_us = wd_data->signal_from_wd_interval_us;
+    config->to_wd_miss_limit = wd_data->signal_to_wd_miss_limit;
+    config->from_wd_miss_limit = wd_data->signal_from_wd_miss_limit;
+    config->transport = (int32_t)wd_data->transport;
+    config->standby = wd_data->standby;
+    config->channel_fd = channel_fd;
+    config->phi_threshold = wd_data->phi_threshold;
+    config->max_rss_kb = wd_data->max_rss_kb;
+    config->max_cpu_percent = (int32_t)wd_data->max_cpu_percent;
+    config->max_fds = wd_data->max_fds;
+    config->limit_window_ms = wd_data->limit_window_ms;
+    config->restart_backoff_ms = wd_data->restart_backoff_ms;
+    config->restart_window_ms = wd_data->restart_window_ms;
+    config->restart_budget = wd_data->restart_budget;
+
+    return 0;
+}
+
+
+void WdStateGetConfig(const wd_state_t *state, watchdog_data_t *wd_data)
+{
+    const wd_state_config_t *config = &state->config;
+
+    wd_data->watchdog_path = config->watchdog_path;
+    wd_data->process_path = config->process_path;
+    wd_data->signal_to_wd_interval = (time_t)config->to_wd_interval;
+    wd_data->signal_from_wd_interval = (time_t)config->from_wd_interval;
+    wd_data->signal_to_wd_interval_ms = config->to_wd_interval_ms;
+    wd_data->signal_from_wd_interval_ms = config->from_wd_interval_ms;
+    wd_data->signal_to_wd_interval_us = config->to_wd_interval_us;
+    wd_data->signal_from_wd_interval_us = config->from_wd_interval_us;
+    wd_data->signal_to_wd_miss_limit = config->to_wd_miss_limit;
+    wd_data->signal_from_wd_miss_limit = config->from_wd_miss_limit;
+    wd_data->transport = (wd_transport_t)config->transport;
+    wd_data->standby = config->standby;
+    wd_data->phi_threshold = config->phi_threshold;
+    wd_data->max_rss_kb = config->max_rss_kb;
+    wd_data->max_cpu_percent = (unsigned int)config->max_cpu_percent;
+    wd_data->max_fds = config->max_fds;
+    wd_data->limit_window_ms = config->limit_window_ms;
+    wd_data->restart_backoff_ms = config->restart_backoff_ms;
+    wd_data->restart_window_ms = config->restart_window_ms;
+    wd_data->restart_budget = config->restart_budget;
+    wd_data->daemon_name = NULL;
+}
+
+
+void WdStateSet(uint64_t *field, uint64_t value)
+{
+    __atomic_store_n(field, value, __ATOMIC_RELAXED);
+}
+
+
+uint64_t WdStateGet(const uint64_t *field)
+{
+    return __atomic_load_n(field, __ATOMIC_RELAXED);
+}
+
+
+uint64_t WdStateResume(uint64_t last_ns, uint64_t interval_ns,
+                                                            uint64_t now_ns)
+{
+    if (0 == last_ns || 0 == interval_ns)
+    {
+        return now_ns + interval_ns;
+    }
+    if (last_ns > now_ns)
+    {
+        return last_ns + interval_ns;
+    }
+
+    /* the runs missed while no process held the role are skipped */
+    return last_ns + ((now_ns - last_ns) / interval_ns + 1) * interval_ns;
+}
+
+
+wd_restart_t WdStateRestart(wd_state_t *state, wd_role_t role,
+                                                            uint64_t now_ns)
+{
+    wd_state_restarts_t *restarts = &state->restarts[role];
+    const wd_state_config_t *config = &state->config;
+    uint64_t window_ns = (0 != config->restart_window_ms)
+                                ? config->restart_window_ms * MONO_NS_PER_MS
+                                : WD_STATE_RESTART_WINDOW_MS * MONO_NS_PER_MS;
+    uint64_t count = WdStateGet(&restarts->count);
+    uint64_t budget = (uint64_t)config->restart_budget;
+    uint64_t recent = 0;
+    uint64_t i = 0;
+
+    if (0 != WdStateGet(&restarts->quarantined_ns))
+    {
+        return WD_RESTART_NEVER;
+    }
+
+    for (i = 0; i < count && i < WD_STATE_RESTARTS; ++i)
+    {
+        if (now_ns - restarts->at_ns[i] < window_ns)
+        {
+            ++recent;
+        }
+    }
+
+    /* over its budget it is given up at once, in its backoff or not. the
+       window holds the last WD_STATE_RESTARTS restarts at most */
+    if (WD_STATE_RESTARTS < budget)
+    {
+        budget = WD_STATE_RESTARTS;
+    }
+    if (0 < config->restart_budget && recent >= budget)
+    {
+        WdStateSet(&restarts->quarantined_ns, now_ns);
+        return WD_RESTART_NEVER;
+    }
+    if (now_ns < WdStateGet(&restarts->next_ns))
+    {
+        return WD_RESTART_LATER;
+    }
+
+    restarts->at_ns[count % WD_STATE_RESTARTS] = now_ns;
+    WdStateSet(&restarts->count, count + 1);
+    WdStateSet(&restarts->next_ns, now_ns
+                        + Backoff(config->restart_backoff_ms * MONO_NS_PER_MS,
+                                                    recent, window_ns, now_ns));
+
+    return WD_RESTART_NOW;
+}
+
+/******************************************************************************/
+static wd_state_t *Map(int fd)
+{
+    void *map = mmap(NULL, sizeof(wd_state_t), PROT_READ | PROT_WRITE,
+                                                        MAP_SHARED, fd, 0);
+
+    return (MAP_FAILED == map) ? NULL : (wd_state_t *)map;
+}
+
+
+static int CopyPath(char *to, const char *from)
+{
+    size_t len = (NULL == from) ? 0 : strlen(from);
+
+    if (WD_STATE_PATH_MAX <= len)
+    {
+        return -1;
+    }
+    memcpy(to, (NULL == from) ? "" : from, len + 1);
+
+    return 0;
+}
+
+
+static uint64_t Backoff(uint64_t base_ns, uint64_t recent, uint64_t cap_ns,
+                                                            uint64_t now_ns)
+{
+    uint64_t delay = base_ns;
+    uint64_t seed = now_ns ^ ((uint64_t)getpid() << 32);
+    uint64_t i = 0;
+
+    if (0 == base_ns)
+    {
+        return 0;
+    }
+
+    /* doubled by each restart in the window, up to the window */
+    for (i = 0; i < recent && delay < cap_ns; ++i)
+    {
+        delay <<= 1;
+    }
+    if (delay > cap_ns)
+    {
+        delay = cap_ns;
+    }
+
+    /* half of it at random - the nanoseconds of the failure and the pid of
+       the reviver mixed, the pairs of a host that failed together spread */
+    seed = (seed ^ (seed >> 29)) * 2654435761u;
+    seed ^= seed >> 32;
+
+    return delay / 2 + seed % (delay / 2 + 1);
+}
@@ -0,0 +1,201 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : the configuration and the runtime state of a pair,
+ *              in a memory file inherited by the processes that revive it
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#ifndef __WD_STATE_H_OL108_ILRD__
+#define __WD_STATE_H_OL108_ILRD__
+
+#include <stdint.h> /* uint64_t, int64_t, int32_t, uint32_t */
+
+#include "wd_log.h"
+#include "wd_stats.h"
+#include "wd_user_process.h"
+#include "wd_zygote.h"
+
+#define WD_STATE_MAGIC 0x57445353u
+#define WD_STATE_VERSION 4u
+#define WD_STATE_PATH_MAX 1024
+#define WD_STATE_RESTARTS 32    /* the restarts a budget counts, at most */
+#define WD_STATE_RESTART_WINDOW_MS 60000ul  /* of restart_window_ms 0 */
+
+/* the answers of WdStateRestart */
+typedef enum
+{
+    WD_RESTART_NOW,
+    WD_RESTART_LATER,           /* in its backoff - ask again */
+    WD_RESTART_NEVER            /* quarantined */
+} wd_restart_t;
+
+/* the process in a role, written by it as it runs - a process taking over
+   the role resumes from it. each field has one writer at a time */
+typedef struct
+{
+    uint64_t pid;               /* 0 before the role started */
+    uint64_t misses;            /* of the peer, in a row */
+    uint64_t last_send_ns;      /* MonoNowNs() of the last heartbeat sent */
+    uint64_t last_check_ns;     /* of the last check of the peer */
+    uint64_t reserved[4];
+} wd_state_side_t;
+
+/* the restarts of a role, written by the process that revives it - the
+   watchdog process of the user process and the other way around */
+typedef struct
+{
+    uint64_t at_ns[WD_STATE_RESTARTS];  /* MonoNowNs() of the last ones */
+    uint64_t count;             /* restarts, at_ns[count % RESTARTS] next */
+    uint64_t next_ns;           /* the end of the backoff */
+    uint64_t quarantined_ns;    /* MonoNowNs() it was given up at, 0 if not */
+    uint64_t reserved[5];
+} wd_state_restarts_t;
+
+/* watchdog_data_t, but for argv and envp (they pass through exec), set by
+   the user process at StartWatchDog */
+typedef struct
+{
+    int64_t to_wd_interval;
+    int64_t from_wd_interval;
+    uint64_t to_wd_interval_ms;
+    uint64_t from_wd_interval_ms;
+    uint64_t to_wd_interval_us;
+    uint64_t from_wd_interval_us;
+    int32_t to_wd_miss_limit;
+    int32_t from_wd_miss_limit;
+    int32_t transport;
+    int32_t standby;
+    int32_t channel_fd;         /* the heartbeat channel, -1 with signals */
+    int32_t reserved;
+    double phi_threshold;
+    uint64_t max_rss_kb;
+    uint64_t max_fds;
+    uint64_t limit_window_ms;
+    int32_t max_cpu_percent;
+    int32_t restart_budget;
+    uint64_t restart_backoff_ms;
+    uint64_t restart_window_ms;
+    char watchdog_path[WD_STATE_PATH_MAX];
+    char process_path[WD_STATE_PATH_MAX];
+    char stats_name[WD_STATS_NAME_MAX];
+    char log_name[WD_LOG_NAME_MAX];
+    char zygote_name[WD_ZYGOTE_NAME_MAX];
+} wd_state_config_t;
+
+/* the file - its sides in their own cache lines */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    char pad[56];
+    wd_state_side_t side[WD_ROLES];
+    wd_state_restarts_t restarts[WD_ROLES];
+    wd_state_config_t config;
+} wd_state_t;
+
+
+/**
+ * @Description: Creates a zeroed state in an anonymous shared memory file.
+ * @Parameters: fd - set to the file descriptor of the memory file, to pass to
+ *                   the processes of the pair (it is inherited through fork
+ *                   and exec).
+ * @Return: The mapped state, NULL on failure.
+**/
+wd_state_t *WdStateCreate(int *fd);
+
+
+/**
+ * @Description: Maps the state of the given memory file.
+ * @Parameters: fd - the file descriptor from WdStateCreate.
+ * @Return: The mapped state, NULL on failure or if the file is not a state
+ *          of this version.
+ * @Notes: The fd stays open - a process that revives its peer by exec
+ *         hands it on.
+**/
+wd_state_t *WdStateOpen(int fd);
+
+
+/**
+ * @Description: Unmaps the state.
+ * @Parameters: state - of WdStateCreate or WdStateOpen.
+ * @Return: void.
+**/
+void WdStateClose(wd_state_t *state);
+
+
+/**
+ * @Description: Sets the configuration of the pair.
+ * @Parameters: state - the state.
+ *              wd_data - the configuration given to StartWatchDog.
+ *              channel_fd - the file descriptor of the heartbeat channel, -1
+ *              without.
+ * @Return: 0 on success, -1 if a path does not fit.
+ * @Notes: The names of the segments of the pair are set apart, once.
+**/
+int WdStateSetConfig(wd_state_t *state, const watchdog_data_t *wd_data,
+                                                            int channel_fd);
+
+
+/**
+ * @Description: Gets the configuration of the pair.
+ * @Parameters: state - the state.
+ *              wd_data - set to the configuration, the paths point into the
+ *              mapped state. argv and envp are left as they are.
+ * @Return: void.
+ * @Complexity: O(1).
+**/
+void WdStateGetConfig(const wd_state_t *state, watchdog_data_t *wd_data);
+
+
+/**
+ * @Description: Sets a field of a side.
+ * @Parameters: field - the field.
+ *              value - the value.
+ * @Return: void.
+ * @Complexity: O(1).
+**/
+void WdStateSet(uint64_t *field, uint64_t value);
+
+
+/**
+ * @Description: Reads a field of a side.
+ * @Parameters: field - the field.
+ * @Return: Its value.
+ * @Complexity: O(1).
+**/
+uint64_t WdStateGet(const uint64_t *field);
+
+
+/**
+ * @Description: Finds the next run of a periodic task in the phase it had.
+ * @Parameters: last_ns - MonoNowNs() of its last run, 0 if it never ran.
+ *              interval_ns - its period.
+ *              now_ns - MonoNowNs().
+ * @Return: The first point of the schedule after now_ns, now_ns +
+ *          interval_ns if it never ran.
+ * @Complexity: O(1).
+**/
+uint64_t WdStateResume(uint64_t last_ns, uint64_t interval_ns,
+                                                            uint64_t now_ns);
+
+
+/**
+ * @Description: Asks whether a failed process may be revived, under the
+ *               restart backoff and budget of the pair, and counts the
+ *               restart if it may.
+ * @Parameters: state - the state.
+ *              role - the role of the failed process.
+ *              now_ns - MonoNowNs().
+ * @Return: WD_RESTART_NOW - revive it, its backoff starts.
+ *          WD_RESTART_LATER - it is in its backoff, ask again.
+ *          WD_RESTART_NEVER - it is quarantined, now (it is over its budget)
+ *          or before.
+ * @Notes: Called by the process that revives the role, its only writer.
+ * @Complexity: O(WD_STATE_RESTARTS).
+**/
+wd_restart_t WdStateRestart(wd_state_t *state, wd_role_t role,
+                                                            uint64_t now_ns);
+
+#endif /* __WD_STATE_H_OL108_ILRD__ */
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : heartbeat statistics in shared memory
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#include "wd_shm.h"         /* WdShmCreate(), WdShmOpen() */
+#include "wd_stats.h"
+
+/******************************************************************************/
+wd_stats_t *WdStatsCreate(const char *name)
+{
+    return (wd_stats_t *)WdShmCreate(name, sizeof(wd_stats_t),
+                                        WD_STATS_MAGIC, WD_STATS_VERSION);
+}
+
+
+const wd_stats_t *WdStatsOpen(const char *name)
+{
+    return (const wd_stats_t *)WdShmOpen(name, sizeof(wd_stats_t),
+                                        WD_STATS_MAGIC, WD_STATS_VERSION);
+}
+
+
+void WdStatsClose(const wd_stats_t *stats)
+{
+    WdShmClose(stats, sizeof(wd_stats_t));
+}
+
+
+int WdStatsUnlink(const char *name)
+{
+    return WdShmUnlink(name);
+}
+
+
+void WdStatsAdd(uint64_t *field, uint64_t n)
+{
+    /* no read-modify-write - the field has one writer */
+    __atomic_store_n(field, __atomic_load_n(field, __ATOMIC_RELAXED) + n,
+                                                            __ATOMIC_RELAXED);
+}
+
+
+void WdStatsSet(uint64_t *field, uint64_t value)
+{
+    __atomic_store_n(field, value, __ATOMIC_RELAXED);
+}
+
+
+uint64_t WdStatsGet(const uint64_t *field)
+{
+    return __atomic_load_n(field, __ATOMIC_RELAXED);
+}
+
+
+void WdStatsBeat(wd_stats_side_t *side, uint64_t beats, uint64_t now_ns)
+{
+    uint64_t last = WdStatsGet(&side->last_beat_ns);
+    uint64_t interval = WdStatsGet(&side->interval_ns);
+
+    WdStatsAdd(&side->received, beats);
+    WdStatsSet(&side->last_beat_ns, now_ns);
+
+    /* the first heartbeat of the pair has no gap */
+    if (0 != last && now_ns >= last)
+    {
+        uint64_t gap = now_ns - last;
+
+        WdStatsAdd(&side->gap[MonoBucket(gap)], 1);
+        WdStatsAdd(&side->jitter[MonoBucket((gap > interval)
+                                ? gap - interval : interval - gap)], 1);
+    }
+}
+
+
+void WdStatsReviveStart(wd_stats_side_t *side, uint64_t now_ns)
+{
+    WdStatsSet(&side->revive_ns, now_ns);
+}
+
+
+void WdStatsReviveDone(wd_stats_side_t *side, uint64_t now_ns)
+{
+    uint64_t start = WdStatsGet(&side->revive_ns);
+
+    if (0 == start || now_ns < start)
+    {
+        return;
+    }
+
+    WdStatsAdd(&side->restarts, 1);
+    WdStatsAdd(&side->restart_ns_total, now_ns - start);
+    if (now_ns - start > WdStatsGet(&side->restart_ns_max))
+    {
+        WdStatsSet(&side->restart_ns_max, now_ns - start);
+    }
+    WdStatsSet(&side->revive_ns, 0);
+}
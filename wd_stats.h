@@ -0,0 +1,164 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : heartbeat statistics in shared memory
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#ifndef __WD_STATS_H_OL108_ILRD__
+#define __WD_STATS_H_OL108_ILRD__
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint32_t, uint64_t */
+
+#include "mono_clock.h" /* MONO_BUCKETS */
+#include "wd_shm.h" /* wd_shm_header_t */
+
+/* a segment per pair, /dev/shm/wd_stats.<pid of the first user process> */
+#define WD_STATS_PREFIX "/wd_stats."
+#define WD_STATS_NAME_MAX 32
+#define WD_STATS_MAGIC 0x57445354u
+#define WD_STATS_VERSION 1u
+
+/* the buckets of MonoBucket */
+#define WD_STATS_BUCKETS MONO_BUCKETS
+
+typedef enum
+{
+    WD_ROLE_USER,
+    WD_ROLE_WATCHDOG,
+    WD_ROLES
+} wd_role_t;
+
+/* the process in a role, written by it - but for the restart fields,
+   written by the process that revives it. the fields only grow (but for
+   pid, interval_ns and revive_ns), a reader loads each on its own */
+typedef struct
+{
+    uint64_t pid;               /* 0 before the role started */
+    uint64_t interval_ns;       /* the expected gap between heartbeats */
+    uint64_t sent;              /* heartbeats sent */
+    uint64_t received;          /* heartbeats received */
+    uint64_t misses;            /* receive intervals without a heartbeat */
+    uint64_t last_beat_ns;      /* MonoNowNs() of the last one received */
+    uint64_t restarts;          /* revivals of this role */
+    uint64_t restart_ns_total;  /* from detection to the handshake done */
+    uint64_t restart_ns_max;
+    uint64_t revive_ns;         /* a revival detected at, 0 if none */
+    uint64_t quarantined_ns;    /* given up at, not revived - 0 if not */
+    uint64_t reserved[5];
+    uint64_t gap[WD_STATS_BUCKETS];     /* between heartbeats received */
+    uint64_t jitter[WD_STATS_BUCKETS];  /* |gap - interval_ns| */
+} wd_stats_side_t;
+
+/* the segment - its sides in their own cache lines */
+typedef struct
+{
+    wd_shm_header_t header;
+    char pad[56];
+    wd_stats_side_t side[WD_ROLES];
+} wd_stats_t;
+
+
+/**
+ * @Description: Opens the statistics of a pair for writing, creates them if
+ *               they do not exist.
+ * @Parameters: name - the name of the segment (WD_STATS_PREFIX and an id).
+ * @Return: The mapped statistics, NULL on failure.
+ * @Notes: A revived process opens the statistics of its pair and adds to
+ *         them.
+**/
+wd_stats_t *WdStatsCreate(const char *name);
+
+
+/**
+ * @Description: Maps the statistics of a pair for reading.
+ * @Parameters: name - the name of the segment.
+ * @Return: The mapped statistics (read only), NULL on failure or if the
+ *          segment is not of this version.
+ * @Notes: The readers take no lock and write nothing, the pair does not
+ *         see them.
+**/
+const wd_stats_t *WdStatsOpen(const char *name);
+
+
+/**
+ * @Description: Unmaps the statistics.
+ * @Parameters: stats - of WdStatsCreate or WdStatsOpen.
+ * @Return: void.
+**/
+void WdStatsClose(const wd_stats_t *stats);
+
+
+/**
+ * @Description: Removes the segment - mapped statistics stay valid.
+ * @Parameters: name - the name of the segment.
+ * @Return: 0 on success, -1 on failure.
+**/
+int WdStatsUnlink(const char *name);
+
+
+/**
+ * @Description: Adds to a field of a side.
+ * @Parameters: field - the field.
+ *              n - the amount to add.
+ * @Return: void.
+ * @Notes: A relaxed load and store - each field has one writer at a time.
+ * @Complexity: O(1).
+**/
+void WdStatsAdd(uint64_t *field, uint64_t n);
+
+
+/**
+ * @Description: Sets a field of a side.
+ * @Parameters: field - the field.
+ *              value - the value.
+ * @Return: void.
+ * @Complexity: O(1).
+**/
+void WdStatsSet(uint64_t *field, uint64_t value);
+
+
+/**
+ * @Description: Reads a field of a side.
+ * @Parameters: field - the field.
+ * @Return: Its value.
+ * @Complexity: O(1).
+**/
+uint64_t WdStatsGet(const uint64_t *field);
+
+
+/**
+ * @Description: Counts heartbeats received together, and the gap since the
+ *               last ones in the histograms.
+ * @Parameters: side - the side of the receiving process.
+ *              beats - the number of heartbeats.
+ *              now_ns - MonoNowNs() of their arrival.
+ * @Return: void.
+ * @Complexity: O(log(gap)).
+**/
+void WdStatsBeat(wd_stats_side_t *side, uint64_t beats, uint64_t now_ns);
+
+
+/**
+ * @Description: Marks the start of a revival - the peer was found dead or
+ *               hung.
+ * @Parameters: side - the side of the revived role.
+ *              now_ns - MonoNowNs() of the detection.
+ * @Return: void.
+ * @Complexity: O(1).
+**/
+void WdStatsReviveStart(wd_stats_side_t *side, uint64_t now_ns);
+
+
+/**
+ * @Description: Counts the revival started by WdStatsReviveStart, if any.
+ * @Parameters: side - the side of the revived role.
+ *              now_ns - MonoNowNs() of the handshake done.
+ * @Return: void.
+ * @Complexity: O(1).
+**/
+void WdStatsReviveDone(wd_stats_side_t *side, uint64_t now_ns);
+
+#endif /* __WD_STATS_H_OL108_ILRD__ */
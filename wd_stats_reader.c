@@ -0,0 +1,174 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : reader of the heartbeat statistics of running pairs
+ *
+ * Infinity Labs OL108
+ *
+ * usage - wd_stats [-v] [segment...] (default every /dev/shm/wd_stats.*)
+ *         -v - the histograms too
+ * output - a row per role of each pair :
+ *          role,pid,state,sent,received,misses,restarts,restart_avg_ms,
+ *          restart_max_ms,last_beat_ago_ms
+ *          and with -v, the non-empty buckets of the gap and jitter
+ *          histograms, in microseconds
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <dirent.h>     /* opendir(), readdir(), closedir() */
+#include <errno.h>      /* errno, ESRCH */
+#include <signal.h>     /* kill() */
+#include <stdio.h>      /* printf() */
+#include <string.h>     /* strcmp(), strncmp(), strlen() */
+
+#include "mono_clock.h" /* MonoNowNs() */
+#include "wd_stats.h"
+
+#define SHM_DIR "/dev/shm"
+/******************************************************************************/
+static int ShowPair(const char *name, int is_verbose);
+static void ShowSide(const char *role, const wd_stats_side_t *side,
+                                            uint64_t now_ns, int is_verbose);
+static void ShowHistogram(const char *role, const char *what,
+                                                    const uint64_t *buckets);
+static const char *State(const wd_stats_side_t *side, uint64_t pid);
+/******************************************************************************/
+int main(int argc, char *argv[])
+{
+    int is_verbose = (1 < argc && 0 == strcmp("-v", argv[1]));
+    int first = 1 + is_verbose;
+    int status = 0, i = 0;
+
+    if (first < argc)
+    {
+        for (i = first; i < argc; ++i)
+        {
+            status |= ShowPair(argv[i], is_verbose);
+        }
+    }
+    else
+    {
+        DIR *dir = opendir(SHM_DIR);
+        struct dirent *entry = NULL;
+        size_t prefix_len = strlen(WD_STATS_PREFIX) - 1;
+
+        if (NULL == dir)
+        {
+            return 1;
+        }
+        /* shm_open names are the files of /dev/shm, without the slash */
+        while (NULL != (entry = readdir(dir)))
+        {
+            if (0 == strncmp(WD_STATS_PREFIX + 1, entry->d_name, prefix_len))
+            {
+                char name[WD_STATS_NAME_MAX + 1];
+
+                sprintf(name, "/%.*s", WD_STATS_NAME_MAX - 1, entry->d_name);
+                status |= ShowPair(name, is_verbose);
+            }
+        }
+        closedir(dir);
+    }
+
+    return status;
+}
+
+/******************************************************************************/
+static int ShowPair(const char *name, int is_verbose)
+{
+    const wd_stats_t *stats = WdStatsOpen(name);
+    uint64_t now = MonoNowNs();
+
+    if (NULL == stats)
+    {
+        fprintf(stderr, "%s: no statistics\n", name);
+        return 1;
+    }
+
+    printf("%s\n", name);
+    printf("role,pid,state,sent,received,misses,restarts,restart_avg_ms,"
+                                    "restart_max_ms,last_beat_ago_ms\n");
+    ShowSide("user", &stats->side[WD_ROLE_USER], now, is_verbose);
+    ShowSide("watchdog", &stats->side[WD_ROLE_WATCHDOG], now, is_verbose);
+
+    WdStatsClose(stats);
+
+    return 0;
+}
+
+
+static void ShowSide(const char *role, const wd_stats_side_t *side,
+                                            uint64_t now_ns, int is_verbose)
+{
+    uint64_t pid = WdStatsGet(&side->pid);
+    uint64_t restarts = WdStatsGet(&side->restarts);
+    uint64_t last_beat = WdStatsGet(&side->last_beat_ns);
+
+    printf("%s,%lu,%s,%lu,%lu,%lu,%lu,%.2f,%.2f,", role, (unsigned long)pid,
+            State(side, pid), (unsigned long)WdStatsGet(&side->sent),
+            (unsigned long)WdStatsGet(&side->received),
+            (unsigned long)WdStatsGet(&side->misses), (unsigned long)restarts,
+            (0 == restarts) ? 0.0
+                : WdStatsGet(&side->restart_ns_total) / 1e6 / restarts,
+            WdStatsGet(&side->restart_ns_max) / 1e6);
+    if (0 != last_beat && now_ns >= last_beat)
+    {
+        printf("%.2f", (now_ns - last_beat) / 1e6);
+    }
+    printf("\n");
+
+    if (is_verbose)
+    {
+        ShowHistogram(role, "gap_us", side->gap);
+        ShowHistogram(role, "jitter_us", side->jitter);
+    }
+}
+
+
+static void ShowHistogram(const char *role, const char *what,
+                                                    const uint64_t *buckets)
+{
+    size_t i = 0;
+
+    printf("  %s %s:", role, what);
+    for (i = 0; i < WD_STATS_BUCKETS; ++i)
+    {
+        uint64_t count = WdStatsGet(&buckets[i]);
+
+        if (0 == count)
+        {
+            continue;
+        }
+        if (0 == i)
+        {
+            printf(" <1:%lu", (unsigned long)count);
+        }
+        else if (WD_STATS_BUCKETS - 1 == i)
+        {
+            printf(" %lu+:%lu", 1ul << (i - 1), (unsigned long)count);
+        }
+        else
+        {
+            printf(" %lu-%lu:%lu", 1ul << (i - 1), 1ul << i,
+                                                    (unsigned long)count);
+        }
+    }
+    printf("\n");
+}
+
+
+static const char *State(const wd_stats_side_t *side, uint64_t pid)
+{
+    if (0 != WdStatsGet(&side->quarantined_ns))
+    {
+        return "quarantined";
+    }
+    if (0 == pid)
+    {
+        return "none";
+    }
+
+    /* signal 0 - the process is only looked up */
+    return (0 == kill((pid_t)pid, 0) || ESRCH != errno) ? "live" : "dead";
+}
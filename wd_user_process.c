@@ -13,35 +13,97 @@
 #define _POSIX_SOURCE 
 #define _GNU_SOURCE
 
-#include <signal.h>     /* pthread_sigmask(), sigaddset(), sigemptyset(),
-                        sigtimedwait(), SIG_BLOCK, SIGUSR1, SIGUSR2, 
-                        struct sigaction, kill() */
+#include <signal.h>     /* pthread_sigmask(), SIGUSR2, struct sigaction,
+                        kill() */
 #include <stdio.h>      /* printf() */
-#include <stdlib.h>     /* setenv() */
-#include <fcntl.h>      /* O_CREAT */
-#include <semaphore.h>  /* sem_t, sem_open(), sem_wait(), sem_post()*/
+#include <stdlib.h>     /* setenv(), unsetenv(), getenv(), atoi() */
+#include <errno.h>      /* errno, EINTR */
+#include <fcntl.h>      /* fcntl() */
 #include <string.h>     /* memset() */
-#include <unistd.h>		/* getpid() */
+#include <unistd.h>		/* getpid(), close() */
+#include <sys/socket.h> /* socketpair(), send() */
+#include <sys/wait.h>   /* waitpid(), WNOHANG */
 
 #include "scheduler.h" /* timing signal sending */
+#include "mono_clock.h" /* MonoNowNs() */
+#include "wd_daemon.h"
+#include "wd_progress.h"
 #include "wd_user_process.h"
 #include "wd_shared_api.h"
+#include "wd_state.h"
+#include "wd_zygote.h"
 
+/* a client finds (or starts) its daemon within a second */
+#define JOIN_ATTEMPTS 200
+#define JOIN_WAIT_US 5000
+#define SPAWN_EVERY 20
 /******************************************************************************/
 static void *ProtectWdThread(void* args);
 int ReceiveOperation(void *arg);
-static int SetEnvpFromWdData(const watchdog_data_t *wd_data);
-static void InitSem(void);
+static int ReviveHungWatchDog(watchdog_data_t *wd);
+static int ReviveWatchDog(watchdog_data_t *wd);
+static wd_restart_t AskRestart(const watchdog_data_t *wd);
+static void QuarantineWatchDog(void);
+static int JoinDaemon(const watchdog_data_t *wd);
+static void SpawnDaemon(const watchdog_data_t *wd);
+static void WatchPeer(sched_t *sched, watchdog_data_t *wd);
+static int PeerExited(void *arg, int fd, uint64_t now_ns);
+static void ClosePeer(void);
+static void SpawnStandby(const watchdog_data_t *wd);
+static void WatchStandby(sched_t *sched, watchdog_data_t *wd);
+static int StandbyMessage(void *arg, int fd, uint64_t now_ns);
+static int PromoteStandby(watchdog_data_t *wd);
+static void DropStandby(void);
+static pthread_t RunZygote(int listen_fd);
+static int OpenState(void);
+static void OpenStats(void);
+static void OpenLog(void);
+static void NameZygote(void);
+static void ReviveStart(wd_role_t role);
+static void ReviveDone(wd_role_t role);
+static pid_t SpawnWatchDog(const watchdog_data_t *wd, int *sock);
+static pthread_t FailStart(pid_t pid, const char *error);
+static void CloseHeartbeats(void);
+static void CloseSegments(void);
+static int Handshake(int sock);
 /******************************************************************************/
 sigset_t set = {0};
 pid_t child_pid = 0;
+int heartbeat_fd = -1;
+int peer_fd = -1;
+int daemon_fd = -1;
+int channel_fd = -1;
+wd_channel_t *channel = NULL;
 
 int misses = 0;
+
+static sched_t *wd_sched = NULL;
+
+/* the configuration and the runtime state of the pair, handed on to the
+   processes that revive it - the names of its segments are there */
+static wd_state_t *pair_state = NULL;
+static int state_fd = -1;
+
+/* the statistics of the pair, kept by the processes that revive it */
+static wd_stats_t *pair_stats = NULL;
+static wd_log_t *pair_log = NULL;
+
+/* a watchdog process started ahead (standby), parked on a socket */
+static int standby_sock = -1;
+static pid_t standby_pid = 0;
+static int is_standby_ready = 0;
+
+/* the snapshot of the process at WatchDogReady - its parent in a process
+   forked from it */
+static watchdog_data_t *pair_wd = NULL;
+static const char *zygote_name = "";
+static pid_t zygote_pid = 0;
 /******************************************************************************/
 pthread_t StartWatchDog(const watchdog_data_t *wd_data)
 {
     pid_t pid = 0;
     pthread_t aux_thread = -1;
+    int sock = -1;
 
     struct sigaction sa;
     memset(&sa, 0, sizeof(sa));
@@ -50,56 +112,180 @@ pthread_t StartWatchDog(const watchdog_data_t *wd_data)
     sigaction(SIGUSR2, &sa, NULL);
     stop_flag = 0;
 
-    pid = fork();
+    if (0 != OpenState())
+    {
+        printf("state error\n");
+        return aux_thread;
+    }
+    OpenStats();
+    OpenLog();
+    NameZygote();
+    pair_wd = (watchdog_data_t *)wd_data;
 
-    if (0 > pid)
+    /* one watchdog for many processes - no fork, a registration */
+    if (NULL != wd_data->daemon_name)
     {
+        if (0 != JoinDaemon(wd_data))
+        {
+            return FailStart(0, NULL);
+        }
+        LogEvent(WD_EVENT_START, WatchDogPid());
+        pthread_create(&aux_thread, NULL, ProtectWdThread,
+                                                (watchdog_data_t *) wd_data);
+
         return aux_thread;
     }
-    
-    if (0 == pid)
+
+    /* created before the fork, the watchdog process inherits its fd */
+    if (WD_TRANSPORT_SHM == wd_data->transport)
+    {
+        channel = WdChannelCreate(&channel_fd);
+        if (NULL == channel)
+        {
+            return FailStart(0, "channel error");
+        }
+    }
+    if (0 != WdStateSetConfig(pair_state, wd_data, channel_fd))
     {
-        SetEnvpFromWdData(wd_data);
-        execvp(wd_data->watchdog_path, wd_data->argv); 
+        return FailStart(0, "state error");
+    }
 
-        printf("error in exec\n");
+    pid = SpawnWatchDog(wd_data, &sock);
+    if (0 > pid)
+    {
+        return FailStart(0, "spawn error");
+    }
+
+    if (NULL != channel)
+    {
+        UseChannel(&channel->to_wd, &channel->from_wd);
     }
     else
     {
-        if (-1 == SetSignalMask(&set))
+        heartbeat_fd = OpenHeartbeatFd(&set);
+        if (-1 == heartbeat_fd)
         {
-            printf("signals error\n");
-            return aux_thread;
+            close(sock);
+            return FailStart(pid, "signals error");
         }
-        child_pid = pid;
+    }
 
-        InitSem();
+    if (0 != Handshake(sock))
+    {
+        return FailStart(pid, "handshake error");
+    }
+    __atomic_store_n(&child_pid, pid, __ATOMIC_RELEASE);
 
-        pthread_create(&aux_thread, NULL, ProtectWdThread, (watchdog_data_t *) wd_data);            
+    ReviveDone(WD_ROLE_USER);
+    LogEvent(WD_EVENT_START, pid);
+    if (wd_data->standby)
+    {
+        SpawnStandby(wd_data);
     }
 
+    pthread_create(&aux_thread, NULL, ProtectWdThread, (watchdog_data_t *) wd_data);
+
     return aux_thread;
 }
 
 
 watchdog_status_t EndWatchDog(pthread_t watchdog_thread_id)
 {	
+    int is_quarantined = WatchDogQuarantined();
+
     if (-1 == kill(getpid(), SIGUSR2))
     {
         return BOTH_CLOSE_FAIL;
     }
-    if (-1 == kill(child_pid, SIGUSR2))
+    /* the daemon runs on for its other clients */
+    if (-1 != daemon_fd)
+    {
+        if (0 != WdDaemonEnd(daemon_fd))
+        {
+            return WATCHDOG_CLOSE_FAIL;
+        }
+    }
+    else if (!is_quarantined && -1 == kill(WatchDogPid(), SIGUSR2))
     {
         return WATCHDOG_CLOSE_FAIL;
     }
+    /* tasks of the process may keep the scheduler busy */
+    if (NULL != WatchDogScheduler())
+    {
+        SchedStop(WatchDogScheduler());
+    }
     if (0 != pthread_join(watchdog_thread_id, NULL))
     {
         return THREAD_CLOSE_FAIL;
     }
     
-    pthread_sigmask(SIG_UNBLOCK, &set, NULL);
+    CloseHeartbeats();
+
+    /* the standby reads the end of its socket and exits */
+    DropStandby();
+    if (0 != zygote_pid)
+    {
+        kill(zygote_pid, SIGKILL);
+        waitpid(zygote_pid, NULL, 0);
+        zygote_pid = 0;
+    }
+
+    /* the pair is over */
+    CloseSegments();
 
-    return SUCCESS;
+    return is_quarantined ? WATCHDOG_QUARANTINED : SUCCESS;
+}
+
+
+pid_t WatchDogPid(void)
+{
+    return __atomic_load_n(&child_pid, __ATOMIC_ACQUIRE);
+}
+
+
+int WatchDogQuarantined(void)
+{
+    return (NULL != pair_state && 0 != WdStateGet(
+                        &pair_state->restarts[WD_ROLE_WATCHDOG].quarantined_ns));
+}
+
+
+sched_t *WatchDogScheduler(void)
+{
+    return __atomic_load_n(&wd_sched, __ATOMIC_ACQUIRE);
+}
+
+
+pthread_t WatchDogReady(pthread_t watchdog_thread_id)
+{
+    int listen_fd = -1;
+    pid_t pid = 0;
+
+    /* a daemon revives by exec - and a revived process has its zygote */
+    if (NULL == pair_wd || -1 != daemon_fd || 0 != zygote_pid)
+    {
+        return watchdog_thread_id;
+    }
+
+    /* the name is taken while a zygote of the pair runs */
+    listen_fd = WdDaemonListen(zygote_name);
+    if (-1 == listen_fd)
+    {
+        return watchdog_thread_id;
+    }
+
+    pid = fork();
+    if (0 == pid)
+    {
+        return RunZygote(listen_fd);
+    }
+    close(listen_fd);
+    if (0 < pid)
+    {
+        zygote_pid = pid;
+    }
+
+    return watchdog_thread_id;
 }
 
 /******************************************************************************/
@@ -111,11 +297,25 @@ static void *ProtectWdThread(void* args)
     sched = SchedCreate();
     if (NULL != sched)
     {
-        InitSched(sched, wd, &child_pid, wd->signal_to_wd_interval, wd->signal_from_wd_interval, ReceiveOperation);
+        InitSched(sched, wd, &child_pid, 
+            IntervalNs(wd->signal_to_wd_interval, wd->signal_to_wd_interval_ms,
+                wd->signal_to_wd_interval_us), 
+            IntervalNs(wd->signal_from_wd_interval, wd->signal_from_wd_interval_ms,
+                wd->signal_from_wd_interval_us), 
+            ReceiveOperation, heartbeat_fd);
+        WatchPeer(sched, wd);
+        WatchStandby(sched, wd);
+        __atomic_store_n(&wd_sched, sched, __ATOMIC_RELEASE);
 
         SchedRun(sched);
 
+        __atomic_store_n(&wd_sched, NULL, __ATOMIC_RELEASE);
         SchedDestroy(sched);
+
+        if (-1 != peer_fd)
+        {
+            ClosePeer();
+        }
     }
 
     return NULL;
@@ -125,83 +325,722 @@ static void *ProtectWdThread(void* args)
 int ReceiveOperation(void *arg)
 {
     watchdog_data_t *wd = (watchdog_data_t*)arg;
-    struct timespec ts = {0,0};
+    int beats = 0;
 
-    if(stop_flag)
+    /* a quarantined watchdog is not checked (see WatchDogQuarantined) */
+    if(stop_flag || WatchDogQuarantined())
     {
         return 0;
     }
 
-    if (0 > sigtimedwait(&set, NULL, &ts))
+    beats = TakeHeartbeats();
+
+    /* checked between the heartbeats - a check without one is no miss */
+    if (0 < wd->phi_threshold)
+    {
+        if (0 != beats)
+        {
+            LogEvent(WD_EVENT_RECEIVED, beats);
+        }
+        if (IsPeerSuspect(wd->phi_threshold))
+        {
+            return ReviveHungWatchDog(wd);
+        }
+    }
+
+    else if (0 == beats)
     {
         ++misses;
-        printf("USER missed %d\n", misses);
+        SaveMisses(misses);
+        LogEvent(WD_EVENT_MISSED, misses);
+        if (NULL != pair_stats)
+        {
+            WdStatsAdd(&pair_stats->side[WD_ROLE_USER].misses, 1);
+        }
 
-        if (misses == wd->signal_to_wd_miss_limit)
+        /* past the limit while the revival waits out its backoff */
+        if (misses >= wd->signal_to_wd_miss_limit)
         {
-            pid_t pid = fork();
-            
-            if (0 > pid)
-            {
-                return -1;
-            }
-            
-            if (0 == pid)
-            {
-                SetEnvpFromWdData(wd);
+            return ReviveHungWatchDog(wd);
+        }
+    }
 
-                execvp(wd->watchdog_path, wd->argv);
-            }
-            else
+    else
+    {
+        LogEvent(WD_EVENT_RECEIVED, beats);
+        misses = 0;
+        SaveMisses(misses);
+    }
+
+    return 1;
+}
+
+
+static int ReviveHungWatchDog(watchdog_data_t *wd)
+{
+    wd_restart_t answer = AskRestart(wd);
+    pid_t pid = WatchDogPid();
+
+    /* it may yet recover in its backoff - the next check asks again */
+    if (WD_RESTART_LATER == answer)
+    {
+        return 1;
+    }
+
+    /* a hung watchdog that woke up would count misses and revive a second
+       user process - it goes before its replacement starts (reaped, if it
+       is a child of this process). a daemon serves other clients, and the
+       misses may be of this process (its scheduler stalled) - it joins
+       again, the daemon is revived once its socket closes */
+    if (NULL == wd->daemon_name && 0 < pid)
+    {
+        kill(pid, SIGKILL);
+        waitpid(pid, NULL, 0);
+    }
+    if (WD_RESTART_NEVER == answer)
+    {
+        QuarantineWatchDog();
+        return 0;
+    }
+
+    return (0 == ReviveWatchDog(wd)) ? 1 : -1;
+}
+
+
+static int ReviveWatchDog(watchdog_data_t *wd)
+{
+    pid_t pid = 0;
+    int sock = -1;
+
+    ReviveStart(WD_ROLE_WATCHDOG);
+    LogEvent(WD_EVENT_REVIVE, WatchDogPid());
+
+    if (NULL != wd->daemon_name)
+    {
+        /* a daemon that lives on releases this process, it revives a client
+           whose socket closes without WD_MSG_END */
+        if (-1 != daemon_fd)
+        {
+            WdDaemonEnd(daemon_fd);
+        }
+        if (0 != JoinDaemon(wd))
+        {
+            return -1;
+        }
+        ReviveDone(WD_ROLE_WATCHDOG);
+        WatchPeer(WatchDogScheduler(), wd);
+
+        return 0;
+    }
+
+    if (-1 != standby_sock && 0 == PromoteStandby(wd))
+    {
+        return 0;
+    }
+
+    pid = SpawnWatchDog(wd, &sock);
+    if (0 > pid)
+    {
+        return -1;
+    }
+    if (0 != Handshake(sock))
+    {
+        waitpid(pid, NULL, 0);
+        return -1;
+    }
+    __atomic_store_n(&child_pid, pid, __ATOMIC_RELEASE);
+    misses = 0;
+    SaveMisses(misses);
+    RestartPhi();
+
+    ReviveDone(WD_ROLE_WATCHDOG);
+    WatchPeer(WatchDogScheduler(), wd);
+
+    return 0;
+}
+
+
+static wd_restart_t AskRestart(const watchdog_data_t *wd)
+{
+    /* the daemon is shared by its clients, none of them gives it up */
+    if (NULL != wd->daemon_name)
+    {
+        return WD_RESTART_NOW;
+    }
+
+    return WdStateRestart(pair_state, WD_ROLE_WATCHDOG, MonoNowNs());
+}
+
+
+static void QuarantineWatchDog(void)
+{
+    printf("USER watchdog quarantined\n");
+    LogEvent(WD_EVENT_QUARANTINE, WatchDogPid());
+    if (NULL != pair_stats)
+    {
+        WdStatsSet(&pair_stats->side[WD_ROLE_WATCHDOG].quarantined_ns,
+                                                                MonoNowNs());
+    }
+
+    /* no heartbeats to a pid that may be reused, and no standby to take
+       over - the process runs on unwatched (WatchDogQuarantined) */
+    __atomic_store_n(&child_pid, 0, __ATOMIC_RELEASE);
+    if (-1 != standby_sock)
+    {
+        SchedRemoveFd(WatchDogScheduler(), standby_sock);
+        DropStandby();
+    }
+}
+
+
+static void WatchPeer(sched_t *sched, watchdog_data_t *wd)
+{
+    /* the old watchdog may still hang around - watch the new one */
+    if (-1 != peer_fd)
+    {
+        SchedRemoveFd(sched, peer_fd);
+        ClosePeer();
+    }
+
+    /* the socket of a daemon closes when it exits, without pidfd (older
+       kernels) missed heartbeats still revive a watchdog */
+    peer_fd = (-1 != daemon_fd) ? daemon_fd : OpenPeerFd(WatchDogPid());
+    if (-1 != peer_fd && 0 != SchedAddFd(sched, peer_fd, PeerExited, wd))
+    {
+        ClosePeer();
+    }
+}
+
+
+static int JoinDaemon(const watchdog_data_t *wd)
+{
+    wd_channel_t *joined = NULL;
+    pid_t pid = 0;
+    int sock = -1, i = 0;
+
+    /* several clients may start a daemon at once, one takes the name */
+    for (i = 0; -1 == sock && i < JOIN_ATTEMPTS; ++i)
+    {
+        sock = WdDaemonConnect(wd->daemon_name, &pid);
+        if (-1 == sock)
+        {
+            if (0 == i % SPAWN_EVERY)
             {
-                child_pid = pid;
-                misses = 0;
-                
-				InitSem();
+                SpawnDaemon(wd);
             }
+            usleep(JOIN_WAIT_US);
         }
     }
+    if (-1 == sock)
+    {
+        printf("daemon error\n");
+        return -1;
+    }
 
-    else
+    joined = WdDaemonRegister(sock, wd);
+    if (NULL == joined)
     {
-        printf("USER received\n");
-        misses = 0;
+        close(sock);
+        printf("daemon error\n");
+        return -1;
+    }
+
+    /* the channel of the old daemon (if any) is left with it */
+    UseChannel(&joined->to_wd, &joined->from_wd);
+    if (NULL != channel)
+    {
+        WdChannelClose(channel);
+    }
+    channel = joined;
+    daemon_fd = sock;
+    __atomic_store_n(&child_pid, pid, __ATOMIC_RELEASE);
+    misses = 0;
+    SaveMisses(misses);
+    RestartPhi();
+
+    return 0;
+}
+
+
+static void SpawnDaemon(const watchdog_data_t *wd)
+{
+    pid_t pid = fork();
+
+    if (0 == pid)
+    {
+        /* the daemon outlives this process, it is nobody's child */
+        setsid();
+        if (0 == fork())
+        {
+            /* it needs only the name, the pair has no state to hand on */
+            close(state_fd);
+            setenv("daemon_name", wd->daemon_name, 1);
+            execvp(wd->watchdog_path, wd->argv);
+
+            printf("error in exec\n");
+        }
+        _exit(0);
+    }
+    if (0 < pid)
+    {
+        waitpid(pid, NULL, 0);
+    }
+}
+
+
+static int PeerExited(void *arg, int fd, uint64_t now_ns)
+{
+    wd_restart_t answer = WD_RESTART_NOW;
+
+    UNUSED(now_ns);
+
+    /* EndWatchDog kills the watchdog after setting stop_flag */
+    if (stop_flag)
+    {
+        return 0;
+    }
+
+    printf("USER watchdog exited\n");
+    LogEvent(WD_EVENT_PEER_EXITED, WatchDogPid());
+    waitpid(WatchDogPid(), NULL, WNOHANG);
+
+    /* in its backoff the watch ends - a dead watchdog misses its
+       heartbeats, and the misses ask again */
+    answer = AskRestart((watchdog_data_t*)arg);
+    if (WD_RESTART_NEVER == answer)
+    {
+        QuarantineWatchDog();
+    }
+
+    /* on success the watch moved to the new watchdog */
+    if (WD_RESTART_NOW != answer || 0 != ReviveWatchDog((watchdog_data_t*)arg))
+    {
+        SchedRemoveFd(WatchDogScheduler(), fd);
+        ClosePeer();
     }
 
     return 1;
 }
 
 
-static void InitSem(void)
+static void ClosePeer(void)
 {
-	sem_t *sem1 = sem_open("watchdog1", O_CREAT, 0666, 0);
-    sem_t *sem2 = sem_open("watchdog2", O_CREAT, 0666, 0);
-    
-    sem_wait(sem1);
-    sem_post(sem2);
-        
-    sem_close(sem1);
-    sem_close(sem2);
-    sem_unlink("watchdog1");
-    sem_unlink("watchdog2");
+    /* the watched fd of a daemon is its socket - no later WdDaemonEnd or
+       watch may use the closed (maybe reused) fd */
+    if (peer_fd == daemon_fd)
+    {
+        daemon_fd = -1;
+    }
+    close(peer_fd);
+    peer_fd = -1;
+}
+
+
+static void SpawnStandby(const watchdog_data_t *wd)
+{
+    int sock = -1;
+    pid_t pid = SpawnWatchDog(wd, &sock);
+
+    /* the handshake is left for the promotion */
+    if (0 > pid)
+    {
+        return;
+    }
+    standby_sock = sock;
+    standby_pid = pid;
+    is_standby_ready = 0;
+}
+
+
+static void WatchStandby(sched_t *sched, watchdog_data_t *wd)
+{
+    if (-1 != standby_sock
+                && 0 != SchedAddFd(sched, standby_sock, StandbyMessage, wd))
+    {
+        DropStandby();
+    }
 }
 
 
-static int SetEnvpFromWdData(const watchdog_data_t *wd_data)
+static int StandbyMessage(void *arg, int fd, uint64_t now_ns)
+{
+    watchdog_data_t *wd = (watchdog_data_t *)arg;
+    char byte = 0;
+    int was_ready = is_standby_ready;
+
+    UNUSED(now_ns);
+
+    if (1 == read(fd, &byte, 1))
+    {
+        is_standby_ready |= (WD_HANDSHAKE_READY == byte);
+
+        return 1;
+    }
+
+    /* the standby died - one that never got ready is not started again, its
+       exec fails */
+    SchedRemoveFd(WatchDogScheduler(), fd);
+    DropStandby();
+    if (was_ready && !stop_flag)
+    {
+        SpawnStandby(wd);
+        WatchStandby(WatchDogScheduler(), wd);
+    }
+
+    return 1;
+}
+
+
+static int PromoteStandby(watchdog_data_t *wd)
+{
+    char byte = WD_HANDSHAKE_GO;
+    pid_t pid = standby_pid;
+
+    /* a standby still starting up reads it once it is set up */
+    SchedRemoveFd(WatchDogScheduler(), standby_sock);
+    if (1 != send(standby_sock, &byte, 1, MSG_NOSIGNAL))
+    {
+        DropStandby();
+        return -1;
+    }
+    close(standby_sock);
+    standby_sock = -1;
+    standby_pid = 0;
+
+    __atomic_store_n(&child_pid, pid, __ATOMIC_RELEASE);
+    misses = 0;
+    SaveMisses(misses);
+    RestartPhi();
+
+    ReviveDone(WD_ROLE_WATCHDOG);
+    LogEvent(WD_EVENT_PROMOTE, pid);
+    WatchPeer(WatchDogScheduler(), wd);
+
+    SpawnStandby(wd);
+    WatchStandby(WatchDogScheduler(), wd);
+
+    return 0;
+}
+
+
+static void DropStandby(void)
+{
+    if (-1 == standby_sock)
+    {
+        return;
+    }
+
+    /* a stopped standby would not read the end of its socket */
+    close(standby_sock);
+    kill(standby_pid, SIGKILL);
+    waitpid(standby_pid, NULL, 0);
+    standby_sock = -1;
+    standby_pid = 0;
+    is_standby_ready = 0;
+}
+
+
+static pthread_t RunZygote(int listen_fd)
+{
+    watchdog_data_t *wd = pair_wd;
+    pthread_t aux_thread = -1;
+    uint64_t wait_ns = 2 * (uint64_t)(wd->signal_from_wd_miss_limit + 1)
+            * IntervalNs(wd->signal_to_wd_interval,
+                    wd->signal_to_wd_interval_ms, wd->signal_to_wd_interval_us)
+            + MONO_NS_PER_SEC;
+
+    /* the zygote holds no fd whose end tells a peer the process exited */
+    if (-1 != standby_sock)
+    {
+        close(standby_sock);
+        standby_sock = -1;
+        standby_pid = 0;
+    }
+    if (-1 != peer_fd)
+    {
+        ClosePeer();
+    }
+
+    /* returns in a revived process, with the watchdog that asked for it */
+    __atomic_store_n(&child_pid, WdZygoteServe(listen_fd, getppid(),
+                &pair_state->side[WD_ROLE_WATCHDOG].pid, wait_ns),
+                                                            __ATOMIC_RELEASE);
+    zygote_pid = getppid();
+    __atomic_store_n(&wd_sched, NULL, __ATOMIC_RELEASE);
+
+    /* the other threads are not in the snapshot - nor are their slots */
+    WdProgressKeep(pthread_self());
+
+    /* the watchdog is the one of the process it replaces - so are its
+       misses, and the schedule of the process (see InitSched) */
+    misses = (int)WdStateGet(&pair_state->side[WD_ROLE_USER].misses);
+    WdStateSet(&pair_state->side[WD_ROLE_USER].pid, (uint64_t)getpid());
+
+    /* the counters of the channel moved on since the snapshot */
+    if (NULL != channel)
+    {
+        UseChannel(&channel->to_wd, &channel->from_wd);
+    }
+    if (NULL != pair_stats)
+    {
+        WdStatsSet(&pair_stats->side[WD_ROLE_USER].pid, (uint64_t)getpid());
+    }
+    UseLog(pair_log);
+    ReviveDone(WD_ROLE_USER);
+    LogEvent(WD_EVENT_START, WatchDogPid());
+
+    if (wd->standby)
+    {
+        SpawnStandby(wd);
+    }
+    pthread_create(&aux_thread, NULL, ProtectWdThread, wd);
+
+    return aux_thread;
+}
+
+
+static pid_t SpawnWatchDog(const watchdog_data_t *wd, int *sock)
 {
-    int is_set = 0;
     char buffer[20];
+    int sv[2];
+    pid_t pid = 0;
+
+    /* a socket per watchdog process - the handshake of the pair, and its
+       end of file tells either side the other exited */
+    if (0 != socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sv))
+    {
+        return -1;
+    }
+
+    pid = fork();
+    if (0 == pid)
+    {
+        /* only the watchdog process keeps its end through exec */
+        fcntl(sv[1], F_SETFD, 0);
+        sprintf(buffer, "%d", state_fd);
+        setenv("wd_state_fd", buffer, 1);
+        sprintf(buffer, "%d", sv[1]);
+        setenv("handshake_fd", buffer, 1);
+        unsetenv("daemon_name");
+        execvp(wd->watchdog_path, wd->argv);
 
-    is_set += setenv("watchdog_path", wd_data->watchdog_path, 1);
-    is_set += setenv("process_path", wd_data->process_path, 1);
-    sprintf(buffer, "%ld", wd_data->signal_to_wd_interval);
-    is_set += setenv("signal_to_wd_interval", buffer, 1);
-    sprintf(buffer, "%ld", wd_data->signal_from_wd_interval);
-    is_set += setenv("signal_from_wd_interval", buffer, 1);
-    sprintf(buffer, "%d", wd_data->signal_to_wd_miss_limit);
-    is_set += setenv("signal_to_wd_miss_limit", buffer, 1);
-    sprintf(buffer, "%d", wd_data->signal_from_wd_miss_limit);
-    is_set += setenv("signal_from_wd_miss_limit", buffer, 1);
-
-    return is_set;
+        printf("error in exec\n");
+        _exit(1);
+    }
+
+    close(sv[1]);
+    if (0 > pid)
+    {
+        close(sv[0]);
+        return -1;
+    }
+    *sock = sv[0];
+
+    return pid;
+}
+
+
+/* what StartWatchDog set up, in reverse - the watchdog process exits at the
+   end of its socket (closed by now) */
+static pthread_t FailStart(pid_t pid, const char *error)
+{
+    if (NULL != error)
+    {
+        printf("%s\n", error);
+    }
+    if (0 < pid)
+    {
+        waitpid(pid, NULL, 0);
+    }
+    CloseHeartbeats();
+    CloseSegments();
+    pair_wd = NULL;
+
+    return (pthread_t)-1;
+}
+
+
+static void CloseHeartbeats(void)
+{
+    if (-1 != heartbeat_fd)
+    {
+        close(heartbeat_fd);
+        heartbeat_fd = -1;
+    }
+    if (NULL != channel)
+    {
+        UseChannel(NULL, NULL);
+        WdChannelClose(channel);
+        close(channel_fd);
+        channel = NULL;
+        channel_fd = -1;
+    }
+    pthread_sigmask(SIG_UNBLOCK, &set, NULL);
+}
+
+
+static void CloseSegments(void)
+{
+    if (NULL != pair_stats)
+    {
+        UseStats(NULL);
+        WdStatsClose(pair_stats);
+        WdStatsUnlink(pair_state->config.stats_name);
+        pair_stats = NULL;
+    }
+    if (NULL != pair_log)
+    {
+        UseLog(NULL);
+        WdLogClose(pair_log);
+        WdLogUnlink(pair_state->config.log_name);
+        pair_log = NULL;
+    }
+    UseState(NULL);
+    WdStateClose(pair_state);
+    close(state_fd);
+    pair_state = NULL;
+    state_fd = -1;
+    zygote_name = "";
+}
+
+
+static int Handshake(int sock)
+{
+    char byte = 0;
+    ssize_t n = 0;
+
+    /* the watchdog process is set up, it runs once told to - a failed exec
+       closes the socket */
+    while (-1 == (n = read(sock, &byte, 1)) && EINTR == errno)
+    {
+    }
+    if (1 == n && WD_HANDSHAKE_READY == byte)
+    {
+        byte = WD_HANDSHAKE_GO;
+        n = send(sock, &byte, 1, MSG_NOSIGNAL);
+    }
+    close(sock);
+
+    return (1 == n && WD_HANDSHAKE_GO == byte) ? 0 : -1;
+}
+
+
+static int OpenState(void)
+{
+    const char *fd = getenv("wd_state_fd");
+    wd_state_t *state = NULL;
+
+    if (NULL != pair_state)
+    {
+        return 0;
+    }
+
+    /* a process revived by its watchdog is the watchdog process, exec'd -
+       it takes over the state of its pair, the fd passed on through exec */
+    if (NULL != fd)
+    {
+        state = WdStateOpen(atoi(fd));
+        if (NULL != state && (uint64_t)getpid() != WdStateGet(
+                                &state->side[WD_ROLE_WATCHDOG].pid))
+        {
+            WdStateClose(state);
+            state = NULL;
+        }
+        unsetenv("wd_state_fd");
+    }
+    if (NULL != state)
+    {
+        state_fd = atoi(fd);
+    }
+    else
+    {
+        state = WdStateCreate(&state_fd);
+        if (NULL == state)
+        {
+            return -1;
+        }
+
+        /* the segments of the pair are named after its first user process */
+        sprintf(state->config.stats_name, WD_STATS_PREFIX "%d", (int)getpid());
+        sprintf(state->config.log_name, WD_LOG_PREFIX "%d", (int)getpid());
+        sprintf(state->config.zygote_name, WD_ZYGOTE_PREFIX "%d",
+                                                                (int)getpid());
+    }
+    pair_state = state;
+
+    /* its watchdog is new, the schedule goes on (see InitSched) */
+    WdStateSet(&state->side[WD_ROLE_USER].pid, (uint64_t)getpid());
+    WdStateSet(&state->side[WD_ROLE_USER].misses, 0);
+    UseState(&state->side[WD_ROLE_USER]);
+
+    return 0;
+}
+
+
+static void OpenStats(void)
+{
+    char *name = pair_state->config.stats_name;
+
+    /* a process revived by its watchdog adds to the statistics of its pair */
+    if (NULL != pair_stats)
+    {
+        return;
+    }
+
+    pair_stats = WdStatsCreate(name);
+    if (NULL == pair_stats)
+    {
+        name[0] = '\0';
+        return;
+    }
+
+    WdStatsSet(&pair_stats->side[WD_ROLE_USER].pid, (uint64_t)getpid());
+    UseStats(&pair_stats->side[WD_ROLE_USER]);
+}
+
+
+static void OpenLog(void)
+{
+    char *name = pair_state->config.log_name;
+
+    /* as the statistics - a revived process writes on in the log of its
+       pair */
+    if (NULL != pair_log)
+    {
+        return;
+    }
+
+    pair_log = WdLogCreate(name);
+    if (NULL == pair_log)
+    {
+        name[0] = '\0';
+        return;
+    }
+
+    UseLog(pair_log);
+}
+
+
+static void NameZygote(void)
+{
+    /* as the statistics - the watchdog asks the zygote of the pair */
+    zygote_name = pair_state->config.zygote_name;
+}
+
+
+static void ReviveStart(wd_role_t role)
+{
+    if (NULL != pair_stats)
+    {
+        WdStatsReviveStart(&pair_stats->side[role], MonoNowNs());
+    }
+}
+
+
+static void ReviveDone(wd_role_t role)
+{
+    if (NULL != pair_stats)
+    {
+        WdStatsReviveDone(&pair_stats->side[role], MonoNowNs());
+    }
 }
@@ -10,16 +10,27 @@
 #define __WATCHDOG_H_OL107_8_ILRD__
 
 #include <pthread.h> /* pthread_t */
+#include <stdint.h> /* uint64_t */
 #include <time.h> /* time_t */
 
+#include "scheduler.h" /* sched_t */
+
 typedef enum
 {
 	SUCCESS,
 	WATCHDOG_CLOSE_FAIL,
 	THREAD_CLOSE_FAIL,
-	BOTH_CLOSE_FAIL
+	BOTH_CLOSE_FAIL,
+	WATCHDOG_QUARANTINED
 } watchdog_status_t;
 
+/* how the heartbeats travel */
+typedef enum
+{
+	WD_TRANSPORT_SIGNAL,	/* SIGUSR1 */
+	WD_TRANSPORT_SHM		/* counters on a shared page (wd_channel.h) */
+} wd_transport_t;
+
 typedef struct
 {
 	const char *watchdog_path;
@@ -30,8 +41,38 @@ typedef struct
 	time_t signal_from_wd_interval;
 	int signal_to_wd_miss_limit;
 	int signal_from_wd_miss_limit;
+	unsigned long signal_to_wd_interval_ms;
+	unsigned long signal_from_wd_interval_ms;
+	wd_transport_t transport;
+	unsigned long signal_to_wd_interval_us;
+	unsigned long signal_from_wd_interval_us;
+	const char *daemon_name;
+	int standby;
+	double phi_threshold;
+	unsigned long max_rss_kb;
+	unsigned int max_cpu_percent;
+	unsigned long max_fds;
+	unsigned long limit_window_ms;
+	unsigned long restart_backoff_ms;
+	unsigned long restart_window_ms;
+	int restart_budget;
 } watchdog_data_t;
 
+#define WD_PROGRESS_SLOTS 64
+
+/* the progress counter of an application thread, alone in its cache line */
+typedef struct
+{
+	uint64_t count;
+	char pad[64 - sizeof(uint64_t)];
+} wd_progress_t;
+
+/* bumps the counter of a slot on the hot loop of its thread - a load and a
+   store, no locked instruction (the slot has one writer) */
+#define WD_PROGRESS(slot) __atomic_store_n(&(slot)->count, \
+			__atomic_load_n(&(slot)->count, __ATOMIC_RELAXED) + 1, \
+			__ATOMIC_RELAXED)
+
 
 /**
  * @Description: Starts a watchdog process to revive the calling process if it
@@ -40,12 +81,66 @@ typedef struct
  *              signal intervals & miss limits (a miss limit of 1 means the
  *              process tolarates one missed signal), argv, envp, and the path
  *              of both executable files.
+ *              A non-zero signal_*_interval_ms overrides the matching
+ *              interval in seconds, for sub-second heartbeats, and a non-zero
+ *              signal_*_interval_us overrides both.
+ *              transport - WD_TRANSPORT_SIGNAL (the default) sends SIGUSR1,
+ *              WD_TRANSPORT_SHM bumps a counter on a page shared with the
+ *              watchdog process - a memory store per heartbeat, fit for
+ *              sub-millisecond intervals.
+ *              daemon_name - NULL (the default) starts a watchdog process for
+ *              the calling process. Otherwise the process registers with the
+ *              watchdog daemon of that name, one watchdog_process for all the
+ *              processes that use the name - it is started from
+ *              watchdog_path if it does not run. The daemon watches the
+ *              process over a unix socket and a slot of its shared page
+ *              (the transport is WD_TRANSPORT_SHM), and revives it with
+ *              process_path and argv (and the environment of the daemon).
+ *              The daemon serves the processes of its own user only.
+ *              standby - 0 (the default) forks a new watchdog process when
+ *              the watchdog fails. Otherwise a second one is started ahead
+ *              and waits, set up - it takes over at once, and a new standby
+ *              is started behind it. Ignored with a daemon.
+ *              phi_threshold - 0 (the default) revives the peer after its
+ *              miss limit of intervals without a heartbeat. Otherwise each
+ *              process models the gaps between the heartbeats of its peer
+ *              (wd_phi.h) and revives it once the suspicion phi reaches
+ *              phi_threshold - the time to detection follows the jitter of
+ *              the heartbeats (8 revives a peer whose silence has a chance of
+ *              1e-8 under the gaps seen so far). The peer is checked 4 times
+ *              an interval, the miss limits are ignored. A daemon counts
+ *              misses.
+ *              max_rss_kb, max_cpu_percent, max_fds - 0 (the default) for no
+ *              limit. Otherwise the watchdog process samples the resident
+ *              memory, the CPU use (percent of a CPU, of the last second) and
+ *              the open file descriptors of the process every interval, and
+ *              restarts it once one was over its limit for limit_window_ms -
+ *              SIGTERM, then, if it did not exit after its miss limit of
+ *              intervals, SIGKILL. Ignored with a daemon.
+ *              restart_backoff_ms - 0 (the default) revives a peer as soon as
+ *              it fails. Otherwise a peer that failed again is revived after
+ *              a backoff that starts at restart_backoff_ms and doubles with
+ *              each restart within restart_window_ms (60 seconds if 0), up to
+ *              the window - half of it fixed and half of it random, so that
+ *              the pairs of a host that failed together do not restart
+ *              together.
+ *              restart_budget - 0 (the default) for no budget. Otherwise a
+ *              peer that failed once more after restart_budget restarts
+ *              within restart_window_ms is not revived - it is quarantined
+ *              (WatchDogQuarantined, and the state of its side in the stats,
+ *              see wd_stats.h). A quarantined user process is left dead and
+ *              its watchdog process exits. At most 32. The backoff and the
+ *              budget of a role hold across the revivals of both processes.
+ *              Ignored with a daemon.
  * @Return: Thread ID of the thread created to ensure the watchdog process keeps
  *          running, or -1 in case of error.
- * @Notes: SIGUSR1 and SIGUSR2 will be blocked for the calling process, behaviour 
- *		   if another process sends the calling process SIGUSR1 is undefined.
+ * @Notes: SIGUSR1 (with WD_TRANSPORT_SIGNAL) and SIGUSR2 will be blocked for
+ *		   the calling process, behaviour if another process sends the calling
+ *		   process SIGUSR1 is undefined.
  *         Behaviour if SIGUSR1 or SIGUSR2 are sent to the watchdog process is
  *         undefined.
+ *         The heartbeats of the pair are counted in a shared-memory segment
+ *         (wd_stats.h), removed by EndWatchDog.
 **/
 pthread_t StartWatchDog(const watchdog_data_t *wd_data);
 
@@ -55,7 +150,91 @@ pthread_t StartWatchDog(const watchdog_data_t *wd_data);
  * @Parameters: watchdog_thread_id - the thread ID returned by StartWatchDog.
  * @Return: Status of closing the thread & process.
  * @Notes: SIGUSR1 and SIGUSR2 will be unblocked for the calling process.
+ *         With a daemon, the daemon stops watching the process and keeps
+ *         running for its other clients.
 **/
 watchdog_status_t EndWatchDog(pthread_t watchdog_thread_id);
 
+
+/**
+ * @Description: Tells whether the watchdog process of the calling process was
+ *               quarantined - it failed after restart_budget restarts within
+ *               restart_window_ms, and was not revived.
+ * @Return: 1 if it was, 0 otherwise (and without a watchdog).
+ * @Notes: The process runs on unwatched, EndWatchDog returns
+ *         WATCHDOG_QUARANTINED.
+ * @Complexity: O(1).
+**/
+int WatchDogQuarantined(void);
+
+
+/**
+ * @Description: Gets the process id of the watchdog process.
+ * @Parameters: None.
+ * @Return: The pid of the current watchdog process (it changes when the
+ *          watchdog is revived) or daemon, 0 before StartWatchDog.
+**/
+pid_t WatchDogPid(void);
+
+
+/**
+ * @Description: Gets the scheduler run by the watchdog thread, so the process
+ *               can use it as its timer thread.
+ * @Parameters: None.
+ * @Return: The scheduler, or NULL if the watchdog thread is not running it.
+ * @Notes: Any thread may add, remove and reschedule tasks (see scheduler.h),
+ *         the operations run on the watchdog thread and must not block it
+ *         for longer than a heartbeat interval. The scheduler and its tasks
+ *         are destroyed by EndWatchDog.
+**/
+sched_t *WatchDogScheduler(void);
+
+
+/**
+ * @Description: Marks the end of the initialization of the process - from
+ *               now on a revived process is forked from a snapshot of it
+ *               (its zygote) instead of starting process_path over.
+ * @Parameters: watchdog_thread_id - the thread ID returned by StartWatchDog.
+ * @Return: The thread ID to pass to EndWatchDog - the same one, or in a
+ *          revived process (it returns here, forked from the snapshot) the
+ *          ID of its own watchdog thread.
+ * @Notes: Called once, after StartWatchDog, from the thread that called it.
+ *         The snapshot holds only the calling thread - the state of the
+ *         process is what it finds, its other threads are not there.
+ *         Revivals start process_path (as without it) with a daemon, or if
+ *         the zygote is gone. EndWatchDog ends the zygote.
+**/
+pthread_t WatchDogReady(pthread_t watchdog_thread_id);
+
+
+
+/**
+ * @Description: Registers a progress slot for the calling thread - the
+ *               watchdog takes the process as hung while the slot stops
+ *               advancing.
+ * @Parameters: stall_budget_ms - how long the counter may stand still.
+ * @Return: The slot, to bump with WD_PROGRESS, or NULL if all
+ *          WD_PROGRESS_SLOTS are taken.
+ * @Notes: Any thread may register, at any time. The heartbeat thread checks
+ *         the slots as it sends - while one stood still for longer than its
+ *         budget the process sends no heartbeats, the watchdog counts them as
+ *         misses and revives the process at its miss limit (or phi
+ *         threshold). A slot that advances again resumes them.
+ *         A revived process registers its slots again, a process forked from
+ *         its zygote (see WatchDogReady) keeps those of the thread that
+ *         called WatchDogReady.
+**/
+wd_progress_t *WatchDogProgressSlot(unsigned long stall_budget_ms);
+
+
+/**
+ * @Description: Releases a progress slot - a thread that leaves its loop
+ *               or exits releases its slot first.
+ * @Parameters: slot - returned by WatchDogProgressSlot.
+ * @Return: void.
+ * @Notes: NULL, a pointer that is not a slot and a slot released already are
+ *         ignored.
+**/
+void WatchDogProgressRelease(wd_progress_t *slot);
+
 #endif /* __WATCHDOG_H_OL107_8_ILRD__ */
@@ -0,0 +1,166 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : the zygote of a user process - a snapshot of the
+ *              process, forked at the end of its initialization, that forks
+ *              the revived processes
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#define _GNU_SOURCE
+
+#include <poll.h>          /* poll(), struct pollfd, POLLIN */
+#include <signal.h>        /* signal(), kill(), SIGCHLD */
+#include <unistd.h>        /* fork(), close(), _exit(), geteuid() */
+#include <sys/socket.h>    /* accept4(), getsockopt(), send(), recv() */
+#include <sys/time.h>      /* struct timeval */
+
+#include "mono_clock.h"    /* MonoNowNs() */
+#include "wd_daemon.h"     /* WdDaemonConnect() */
+#include "wd_shared_api.h" /* OpenPeerFd() */
+#include "wd_zygote.h"
+/******************************************************************************/
+#define REPLY_TIMEOUT_SEC 1
+/******************************************************************************/
+static uint64_t Deadline(int user_fd, pid_t user, uint64_t wait_ns);
+/******************************************************************************/
+pid_t WdZygoteFork(const char *name)
+{
+    struct timeval timeout;
+    int32_t value = -1;
+    pid_t zygote = 0;
+    int sock = WdDaemonConnect(name, &zygote);
+
+    if (-1 == sock)
+    {
+        return -1;
+    }
+
+    /* the connection is the request - a hung zygote is not waited for */
+    timeout.tv_sec = REPLY_TIMEOUT_SEC;
+    timeout.tv_usec = 0;
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if ((ssize_t)sizeof(value) != recv(sock, &value, sizeof(value), 0))
+    {
+        value = -1;
+    }
+    close(sock);
+
+    return (0 < value) ? (pid_t)value : -1;
+}
+
+
+pid_t WdZygoteServe(int listen_fd, pid_t user, const uint64_t *watchdog,
+                                                            uint64_t wait_ns)
+{
+    struct pollfd fds[2];
+    uint64_t deadline = 0;
+
+    /* the forked processes are reaped by the kernel */
+    signal(SIGCHLD, SIG_IGN);
+
+    fds[0].fd = listen_fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = OpenPeerFd(user);       /* a negative fd is not polled */
+    fds[1].events = POLLIN;
+    deadline = Deadline(fds[1].fd, user, wait_ns);
+
+    for (;;)
+    {
+        struct ucred cred;
+        socklen_t cred_len = sizeof(cred);
+        int timeout_ms = -1, sock = -1;
+        int32_t value = -1;
+        pid_t pid = 0;
+
+        if (0 != deadline)
+        {
+            uint64_t now = MonoNowNs();
+
+            if (now >= deadline)
+            {
+                _exit(0);
+            }
+            timeout_ms = (int)((deadline - now + MONO_NS_PER_MS - 1)
+                                                            / MONO_NS_PER_MS);
+        }
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+        if (0 > poll(fds, 2, timeout_ms))
+        {
+            continue;
+        }
+
+        /* the user process exited - its watchdog asks for another soon */
+        if (fds[1].revents & POLLIN)
+        {
+            close(fds[1].fd);
+            fds[1].fd = -1;
+            deadline = MonoNowNs() + wait_ns;
+        }
+        if (!(fds[0].revents & POLLIN))
+        {
+            continue;
+        }
+
+        sock = accept4(listen_fd, NULL, NULL, SOCK_CLOEXEC);
+        if (-1 == sock)
+        {
+            continue;
+        }
+        /* an abstract socket has no permissions - the fork would adopt
+           whoever connected as its watchdog */
+        if (0 != getsockopt(sock, SOL_SOCKET, SO_PEERCRED, &cred, &cred_len)
+                || cred.uid != geteuid()
+                || (uint64_t)cred.pid != __atomic_load_n(watchdog,
+                                                        __ATOMIC_RELAXED))
+        {
+            close(sock);
+            continue;
+        }
+
+        pid = fork();
+        if (0 == pid)
+        {
+            signal(SIGCHLD, SIG_DFL);
+            close(sock);
+            close(listen_fd);
+            if (-1 != fds[1].fd)
+            {
+                close(fds[1].fd);
+            }
+
+            return cred.pid;
+        }
+
+        value = (int32_t)pid;
+        send(sock, &value, sizeof(value), MSG_NOSIGNAL);
+        close(sock);
+
+        /* a hung user process is left to its watchdog, the new one is
+           followed */
+        if (0 < pid)
+        {
+            if (-1 != fds[1].fd)
+            {
+                close(fds[1].fd);
+            }
+            fds[1].fd = OpenPeerFd(pid);
+            deadline = Deadline(fds[1].fd, pid, wait_ns);
+        }
+    }
+}
+
+/******************************************************************************/
+static uint64_t Deadline(int user_fd, pid_t user, uint64_t wait_ns)
+{
+    /* without a pidfd (older kernels) the zygote waits for EndWatchDog - but
+       a process that exited already is not waited for */
+    if (-1 == user_fd && 0 != kill(user, 0))
+    {
+        return MonoNowNs() + wait_ns;
+    }
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+/*******************************************************************************
+ * Author: Meital Kozhidov
+ * Date: October 18th, 2026
+
+ * Description: watchdog : the zygote of a user process - a snapshot of the
+ *              process, forked at the end of its initialization, that forks
+ *              the revived processes
+ *
+ * Infinity Labs OL108
+*******************************************************************************/
+#ifndef __WD_ZYGOTE_H_OL108_ILRD__
+#define __WD_ZYGOTE_H_OL108_ILRD__
+
+#include <stdint.h>         /* uint64_t */
+#include <sys/types.h>      /* pid_t */
+
+/* an abstract unix socket per pair, wd_zygote.<id of its statistics> */
+#define WD_ZYGOTE_PREFIX "wd_zygote."
+#define WD_ZYGOTE_NAME_MAX 32
+
+
+/**
+ * @Description: Asks the zygote of a pair for a new user process (watchdog
+ *               side).
+ * @Parameters: name - the name of the zygote.
+ * @Return: The pid of the new user process, -1 if no zygote runs under the
+ *          name or it did not answer within a second.
+**/
+pid_t WdZygoteFork(const char *name);
+
+
+/**
+ * @Description: Serves the requests of WdZygoteFork (zygote side) - a fork
+ *               each.
+ * @Parameters: listen_fd - the socket of WdDaemonListen, under the name of
+ *              the zygote.
+ *              user - the user process it was forked from.
+ *              watchdog - the pid of the watchdog process of the pair, as
+ *              the pair keeps it (wd_state.h) - the only process served.
+ *              wait_ns - how long the zygote waits for a request once the
+ *              user process exited.
+ * @Return: In a forked process only - the pid of the process that asked
+ *          for it (its watchdog process).
+ * @Notes: The zygote follows the last process it forked, and exits once it
+ *         exited and wait_ns passed without a request - the pair ended
+ *         without EndWatchDog. It ignores SIGCHLD, its children do not.
+ *         A request of another process (another user, a watchdog that was
+ *         replaced) is refused - the socket closes without a pid.
+**/
+pid_t WdZygoteServe(int listen_fd, pid_t user, const uint64_t *watchdog,
+                                                            uint64_t wait_ns);
+
+#endif /* __WD_ZYGOTE_H_OL108_ILRD__ */